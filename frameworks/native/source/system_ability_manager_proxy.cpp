@@ -141,7 +141,7 @@ bool SystemAbilityManagerProxy::IsOnDemandSystemAbility(int32_t systemAbilityId)
 
 sptr<IRemoteObject> SystemAbilityManagerProxy::Recompute(int32_t systemAbilityId, int32_t code)
 {
-    ClearCache();
+    ClearCache(systemAbilityId);
     if (code == GET_SYSTEM_ABILITY_CODE) {
         return GetSystemAbilityWrapper(systemAbilityId);
     }
@@ -1908,4 +1908,59 @@ int32_t SystemAbilityManagerProxy::OnUserStateChanged(int32_t userId, SamgrUserS
 #endif
     return ERR_OK;
 }
+
+int32_t SystemAbilityManagerProxy::GetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+    std::vector<sptr<IRemoteObject>>& saList, std::vector<int32_t>& errCodes)
+{
+    HILOGD("%{public}s called, size:%{public}zu", __func__, systemAbilityIds.size());
+    saList.clear();
+    errCodes.clear();
+    if (systemAbilityIds.empty() || systemAbilityIds.size() > static_cast<size_t>(MAX_BATCH_SA_NUM)) {
+        HILOGW("GetSystemAbilities invalid size:%{public}zu", systemAbilityIds.size());
+        return ERR_INVALID_VALUE;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        HILOGE("GetSystemAbilities remote is nullptr");
+        return ERR_INVALID_OPERATION;
+    }
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(SAMANAGER_INTERFACE_TOKEN)) {
+        HILOGW("GetSystemAbilities write token failed!");
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!data.WriteInt32Vector(systemAbilityIds)) {
+        HILOGW("GetSystemAbilities write SAIds failed!");
+        return ERR_FLATTEN_OBJECT;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    int32_t err = remote->SendRequest(
+        static_cast<uint32_t>(SamgrInterfaceCode::GET_SYSTEM_ABILITIES_TRANSACTION), data, reply, option);
+    if (err != ERR_NONE) {
+        HILOGW("GetSystemAbilities SendRequest error:%{public}d", err);
+        return err;
+    }
+    int32_t result = ERR_OK;
+    if (!reply.ReadInt32(result) || result != ERR_OK) {
+        HILOGW("GetSystemAbilities result:%{public}d", result);
+        return (result != ERR_OK) ? result : ERR_FLATTEN_OBJECT;
+    }
+    for (size_t i = 0; i < systemAbilityIds.size(); ++i) {
+        int32_t errCode = ERR_OK;
+        if (!reply.ReadInt32(errCode)) {
+            HILOGW("GetSystemAbilities read errCode failed, SA:%{public}d", systemAbilityIds[i]);
+            saList.clear();
+            errCodes.clear();
+            return ERR_FLATTEN_OBJECT;
+        }
+        sptr<IRemoteObject> remoteObject = (errCode == ERR_OK) ? reply.ReadRemoteObject() : nullptr;
+        if (errCode == ERR_OK && remoteObject == nullptr) {
+            errCode = ERR_NULL_OBJECT;
+        }
+        saList.emplace_back(remoteObject);
+        errCodes.emplace_back(errCode);
+    }
+    return ERR_OK;
+}
 } // namespace OHOS
@@ -20,13 +20,20 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "sa_profiles.h"
 #include "nlohmann/json.hpp"
 
 namespace OHOS {
 class ParseUtil {
 public:
+    ParseUtil() = default;
     ~ParseUtil();
+    // saProfileIndex_ points into saProfiles_ and the destructor closes the SA libraries, so a copy would
+    // share both with its source
+    ParseUtil(const ParseUtil&) = delete;
+    ParseUtil& operator=(const ParseUtil&) = delete;
     bool ParseSaProfiles(const std::string& profilePath);
     const std::list<SaProfile>& GetAllSaProfiles() const;
     bool GetProfile(int32_t saId, SaProfile& saProfile);
@@ -43,6 +50,9 @@ public:
     static nlohmann::json StringToJsonObj(const std::string& eventStr);
     static std::unordered_map<std::string, std::string> JsonObjToMap(const nlohmann::json& eventJson);
     static bool CheckLogicRelationship(const std::string& state, const std::string& profile);
+    // parse on up to workerNum threads, the result is the same as parsing profilePaths one by one in order
+    static void ParseSaProfilesConcurrently(const std::vector<std::string>& profilePaths, size_t workerNum,
+        std::list<SaProfile>& saProfiles, std::set<int32_t>& multiInstanceSaIds);
 private:
     void CloseSo();
     uint32_t GetBootPriorityPara(const std::string& bootPhase);
@@ -70,6 +80,7 @@ private:
     void GetOnDemandExtraMessagesFromJson(const nlohmann::json& obj,
         const std::string& key, std::map<std::string, std::string>& out);
     bool CheckRecycleStrategy(const std::string& recycleStrategyStr, int32_t& recycleStrategy);
+    SaProfile* FindSaProfile(int32_t saId);
 
     static inline void GetBoolFromJson(const nlohmann::json& obj, const std::string& key, bool& out)
     {
@@ -130,6 +141,8 @@ private:
     static bool Endswith(const std::string& src, const std::string& sub);
     std::string GetRealPath(const std::string& profilePath) const;
     std::list<SaProfile> saProfiles_;
+    // saId -> its profiles in saProfiles_ in parse order, lookups use the first one
+    std::unordered_map<int32_t, std::vector<std::list<SaProfile>::iterator>> saProfileIndex_;
     std::u16string procName_;
     std::vector<std::string> updateVec_;
     std::set<int32_t> multiInstanceSaIds_;
@@ -16,7 +16,9 @@
 #ifndef DYNAMIC_CACHE_H
 #define DYNAMIC_CACHE_H
 
+#include <array>
 #include <map>
+#include <mutex>
 #include <string>
 #include "iremote_object.h"
 
@@ -24,39 +26,67 @@ namespace OHOS {
 using namespace std;
 class DynamicCache : public IRemoteObject::DeathRecipient {
 public:
-    void OnRemoteDied(const wptr<IRemoteObject>& remote) override
+    // typical processes hold 5-20 SA proxies, the least recently used entry is evicted beyond this
+    static constexpr size_t MAX_CACHE_ENTRIES = 32;
+    // SA ids are hashed into this many waterline parameters, invalidating one SA only expires its bucket
+    static constexpr uint32_t CACHE_BUCKET_NUM = 16;
+
+    static std::string GetCacheKey(int32_t saId)
     {
-        ClearCache();
+        return "samgr.cache.sa." + std::to_string(static_cast<uint32_t>(saId) % CACHE_BUCKET_NUM);
     }
 
+    ~DynamicCache() override;
+
+    // only the entries whose proxy died are dropped, the rest of the cache stays valid
+    void OnRemoteDied(const wptr<IRemoteObject>& remote) override;
+
     sptr<IRemoteObject> QueryResult(int32_t querySaId, int32_t code);
-    bool CanUseCache(int32_t querySaId, char* waterLine, std::string defaultValue);
+    bool CanUseCache(int32_t querySaId, const char* waterLine, std::string defaultValue);
 
     void __attribute__((no_sanitize("cfi"))) ClearCache()
     {
         std::lock_guard<std::mutex> autoLock(queryCacheLock_);
-        if (lastQuerySaProxy_ != nullptr) {
-            lastQuerySaProxy_->RemoveDeathRecipient(this);
+        for (auto& [saId, entry] : queryCache_) {
+            if (entry.proxy != nullptr) {
+                entry.proxy->RemoveDeathRecipient(this);
+            }
         }
-        lastQuerySaId_ = -1;
-        lastQuerySaProxy_ = nullptr;
+        queryCache_.clear();
+    }
+
+    void __attribute__((no_sanitize("cfi"))) ClearCache(int32_t querySaId)
+    {
+        std::lock_guard<std::mutex> autoLock(queryCacheLock_);
+        EraseEntryLocked(querySaId);
     }
 
     virtual sptr<IRemoteObject> Recompute(int32_t querySaId, int32_t code)
     {
         std::lock_guard<std::mutex> autoLock(queryCacheLock_);
-        if (lastQuerySaId_ != querySaId) {
+        auto iter = queryCache_.find(querySaId);
+        if (iter == queryCache_.end()) {
             return nullptr;
         }
-        return lastQuerySaProxy_;
+        return iter->second.proxy;
     }
-    
+
 private:
+    struct CacheEntry {
+        sptr<IRemoteObject> proxy;
+        std::string waterLine; // value of the bucket parameter when the proxy was fetched
+        uint64_t lastUse = 0;
+    };
+
+    std::string GetWaterLineLocked(int32_t querySaId, const std::string& defaultValue);
+    void EraseEntryLocked(int32_t querySaId);
+    void EvictLocked();
+
     std::mutex queryCacheLock_;
-    std::map<std::string, std::string> localPara_;
-    std::string key_ = "samgr.cache.sa";
-    int32_t lastQuerySaId_;
-    sptr<IRemoteObject> lastQuerySaProxy_;
+    std::map<int32_t, CacheEntry> queryCache_;
+    // CachedHandle of each bucket parameter, reading an unchanged parameter through it needs no param-service call
+    std::array<void*, CACHE_BUCKET_NUM> waterLineHandles_ {};
+    uint64_t useClock_ = 0;
 };
 } // namespace OHOS
-#endif /* DYNAMIC_CACHE_H */
\ No newline at end of file
+#endif /* DYNAMIC_CACHE_H */
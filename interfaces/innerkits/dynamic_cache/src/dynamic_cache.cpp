@@ -18,21 +18,50 @@
 #include "parameter.h"
 #include "refbase.h"
 #include "sam_log.h"
+#include "sys_param.h"
 #include "sysparam_errno.h"
 
 using namespace std;
 namespace OHOS {
+DynamicCache::~DynamicCache()
+{
+    for (auto& handle : waterLineHandles_) {
+        if (handle != nullptr) {
+            CachedParameterDestroy(static_cast<CachedHandle>(handle));
+            handle = nullptr;
+        }
+    }
+}
+
+void DynamicCache::OnRemoteDied(const wptr<IRemoteObject>& remote)
+{
+    sptr<IRemoteObject> dead = remote.promote();
+    std::lock_guard<std::mutex> autoLock(queryCacheLock_);
+    for (auto iter = queryCache_.begin(); iter != queryCache_.end();) {
+        // a promoted-null remote can not be matched, drop every proxy already known dead instead
+        bool died = (dead != nullptr) ? (iter->second.proxy == dead) :
+            (iter->second.proxy == nullptr || iter->second.proxy->IsObjectDead());
+        if (died) {
+            HILOGD("DynamicCache OnRemoteDied erase %{public}d", iter->first);
+            iter = queryCache_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 sptr<IRemoteObject> DynamicCache::QueryResult(int32_t querySaId, int32_t code)
 {
-    int32_t waterLineLength = 128;
-    char waterLine[128] = {0};
     string defaultValue = "default";
-    GetParameter(key_.c_str(), defaultValue.c_str(), waterLine, waterLineLength);
+    string waterLine;
     {
         std::lock_guard<std::mutex> autoLock(queryCacheLock_);
-        if (CanUseCache(querySaId, waterLine, defaultValue)) {
+        waterLine = GetWaterLineLocked(querySaId, defaultValue);
+        if (CanUseCache(querySaId, waterLine.c_str(), defaultValue)) {
             HILOGD("DynamicCache QueryResult Return Cache %{public}d", querySaId);
-            return lastQuerySaProxy_;
+            auto& entry = queryCache_[querySaId];
+            entry.lastUse = ++useClock_;
+            return entry.proxy;
         }
     }
     HILOGD("DynamicCache QueryResult Recompute");
@@ -42,23 +71,67 @@ sptr<IRemoteObject> DynamicCache::QueryResult(int32_t querySaId, int32_t code)
     }
     {
         std::lock_guard<std::mutex> autoLock(queryCacheLock_);
-        localPara_[key_] = waterLine;
-        if (lastQuerySaProxy_ != nullptr) {
-            HILOGD("DynamicCache RemoveDeathRecipient");
-            lastQuerySaProxy_->RemoveDeathRecipient(this);
+        EraseEntryLocked(querySaId);
+        if (queryCache_.size() >= MAX_CACHE_ENTRIES) {
+            EvictLocked();
         }
-        lastQuerySaId_ = querySaId;
-        lastQuerySaProxy_ = res;
+        CacheEntry& entry = queryCache_[querySaId];
+        entry.proxy = res;
+        entry.waterLine = waterLine;
+        entry.lastUse = ++useClock_;
         res->AddDeathRecipient(this);
     }
     return res;
 }
 
-bool DynamicCache::CanUseCache(int32_t querySaId, char* waterLine, string defaultValue)
+bool DynamicCache::CanUseCache(int32_t querySaId, const char* waterLine, string defaultValue)
+{
+    auto iter = queryCache_.find(querySaId);
+    if (iter == queryCache_.end()) {
+        return false;
+    }
+    const CacheEntry& entry = iter->second;
+    return defaultValue != string(waterLine) && string(waterLine) == entry.waterLine &&
+        entry.proxy != nullptr && !entry.proxy->IsObjectDead();
+}
+
+string DynamicCache::GetWaterLineLocked(int32_t querySaId, const string& defaultValue)
 {
-    return localPara_.count(key_) != 0 && lastQuerySaId_ == querySaId &&
-        defaultValue != string(waterLine) && string(waterLine) == localPara_[key_] &&
-        lastQuerySaProxy_ != nullptr && !lastQuerySaProxy_->IsObjectDead();
+    void*& handle = waterLineHandles_[static_cast<uint32_t>(querySaId) % CACHE_BUCKET_NUM];
+    if (handle == nullptr) {
+        handle = CachedParameterCreate(GetCacheKey(querySaId).c_str(), defaultValue.c_str());
+        if (handle == nullptr) {
+            HILOGE("DynamicCache create cached parameter failed %{public}d", querySaId);
+            return defaultValue;
+        }
+    }
+    const char* value = CachedParameterGet(static_cast<CachedHandle>(handle));
+    return (value == nullptr) ? defaultValue : string(value);
 }
 
+void DynamicCache::EraseEntryLocked(int32_t querySaId)
+{
+    auto iter = queryCache_.find(querySaId);
+    if (iter == queryCache_.end()) {
+        return;
+    }
+    if (iter->second.proxy != nullptr) {
+        HILOGD("DynamicCache RemoveDeathRecipient %{public}d", querySaId);
+        iter->second.proxy->RemoveDeathRecipient(this);
+    }
+    queryCache_.erase(iter);
+}
+
+void DynamicCache::EvictLocked()
+{
+    auto victim = queryCache_.begin();
+    for (auto iter = queryCache_.begin(); iter != queryCache_.end(); ++iter) {
+        if (iter->second.lastUse < victim->second.lastUse) {
+            victim = iter;
+        }
+    }
+    if (victim != queryCache_.end()) {
+        EraseEntryLocked(victim->first);
+    }
+}
 } // namespace OHOS
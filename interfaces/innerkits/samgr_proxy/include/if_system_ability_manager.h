@@ -442,8 +442,31 @@ public:
         (void)userState;
         return 0;
     }
+
+    /**
+     * GetSystemAbilities, Look up a batch of local system abilities in one transaction.
+     * Absent system abilities are neither waited for nor loaded.
+     *
+     * @param systemAbilityIds, ids of the system abilities, at most MAX_BATCH_SA_NUM.
+     * @param saList, remote objects in the order of systemAbilityIds, nullptr for the ones not found.
+     * @param errCodes, per-id result in the order of systemAbilityIds, ERR_OK for the ones found.
+     * @return ERR_OK indicates the batch was looked up, per-id results are in errCodes.
+     */
+    virtual int32_t GetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+        std::vector<sptr<IRemoteObject>>& saList, std::vector<int32_t>& errCodes)
+    {
+        saList.clear();
+        errCodes.clear();
+        for (auto systemAbilityId : systemAbilityIds) {
+            sptr<IRemoteObject> remoteObject = CheckSystemAbility(systemAbilityId);
+            saList.emplace_back(remoteObject);
+            errCodes.emplace_back(remoteObject != nullptr ? ERR_NONE : ERR_NULL_OBJECT);
+        }
+        return ERR_NONE;
+    }
 public:
     DECLARE_INTERFACE_DESCRIPTOR(u"OHOS.ISystemAbilityManager");
+    static constexpr int32_t MAX_BATCH_SA_NUM = 128;
 protected:
     static constexpr int32_t FIRST_SYS_ABILITY_ID = 0x00000000;
     static constexpr int32_t LAST_SYS_ABILITY_ID = 0x00ffffff;
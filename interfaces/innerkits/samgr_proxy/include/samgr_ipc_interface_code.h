@@ -58,6 +58,7 @@ enum class SamgrInterfaceCode : uint32_t {
     UNSUBSCRIBE_LOWMEM_SYSTEM_PROCESS_TRANSACTION = 42,
     ONSTART_SYSTEM_ABILITY_FAIL_TRANSACTION = 43,
     ON_USER_STATE_CHANGED_TRANSACTION = 44,
+    GET_SYSTEM_ABILITIES_TRANSACTION = 45,
 };
 } // namespace OHOS
 #endif // !defined(INTERFACES_INNERKITS_SAMGR_INCLUDE_SAMGR_INTERFACE_CODE_H)
\ No newline at end of file
@@ -321,6 +321,17 @@ public:
         const sptr<ISystemAbilityStatusChange>& listener) override;
     int32_t OnUserStateChanged(int32_t userId, SamgrUserState userState) override;
     int32_t SetSamgrIpcPrior(bool enable) override;
+
+    /**
+     * GetSystemAbilities, Look up a batch of local system abilities in one transaction.
+     *
+     * @param systemAbilityIds, ids of the system abilities, at most MAX_BATCH_SA_NUM.
+     * @param saList, remote objects in the order of systemAbilityIds, nullptr for the ones not found.
+     * @param errCodes, per-id result in the order of systemAbilityIds, ERR_OK for the ones found.
+     * @return ERR_OK indicates the batch was looked up, per-id results are in errCodes.
+     */
+    int32_t GetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+        std::vector<sptr<IRemoteObject>>& saList, std::vector<int32_t>& errCodes) override;
 private:
     sptr<IRemoteObject> GetSystemAbilityWrapper(int32_t systemAbilityId, const std::string& deviceId = "");
     sptr<IRemoteObject> CheckSystemAbilityWrapper(int32_t code, MessageParcel& data);
@@ -23,6 +23,8 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "datetime_ex.h"
 #include "hisysevent_adapter.h"
@@ -121,11 +123,9 @@ void ParseUtil::CloseSo()
 
 void ParseUtil::CloseSo(int32_t systemAbilityId)
 {
-    for (auto& saProfile : saProfiles_) {
-        if (saProfile.saId == systemAbilityId) {
-            CloseHandle(saProfile);
-            break;
-        }
+    SaProfile* saProfile = FindSaProfile(systemAbilityId);
+    if (saProfile != nullptr) {
+        CloseHandle(*saProfile);
     }
 }
 
@@ -133,6 +133,7 @@ void ParseUtil::ClearResource()
 {
     CloseSo();
     saProfiles_.clear();
+    saProfileIndex_.clear();
 #ifdef SUPPORT_MULTI_INSTANCE
     multiInstanceSaIds_.clear();
 #endif
@@ -185,13 +186,12 @@ void ParseUtil::OpenSo(SaProfile& saProfile)
 
 bool ParseUtil::LoadSaLib(int32_t systemAbilityId)
 {
-    for (auto& saProfile : saProfiles_) {
-        if (saProfile.saId == systemAbilityId) {
-            OpenSo(saProfile);
-            return true;
-        }
+    SaProfile* saProfile = FindSaProfile(systemAbilityId);
+    if (saProfile == nullptr) {
+        return false;
     }
-    return false;
+    OpenSo(*saProfile);
+    return true;
 }
 
 const std::list<SaProfile>& ParseUtil::GetAllSaProfiles() const
@@ -225,21 +225,35 @@ void ParseUtil::ParseMultiInstanceSaIds(const nlohmann::json& systemAbilityJson)
 #endif
 }
 
+SaProfile* ParseUtil::FindSaProfile(int32_t saId)
+{
+    auto iter = saProfileIndex_.find(saId);
+    if (iter == saProfileIndex_.end() || iter->second.empty()) {
+        return nullptr;
+    }
+    return &(*iter->second.front());
+}
+
 bool ParseUtil::GetProfile(int32_t saId, SaProfile& saProfile)
 {
-    auto iter = std::find_if(saProfiles_.begin(), saProfiles_.end(), [saId](auto saProfile) {
-        return saProfile.saId == saId;
-    });
-    if (iter != saProfiles_.end()) {
-        saProfile = *iter;
-        return true;
+    SaProfile* profile = FindSaProfile(saId);
+    if (profile == nullptr) {
+        return false;
     }
-    return false;
+    saProfile = *profile;
+    return true;
 }
 
 void ParseUtil::RemoveSaProfile(int32_t saId)
 {
-    saProfiles_.remove_if([saId] (auto saInfo) -> bool { return saInfo.saId == saId; });
+    auto iter = saProfileIndex_.find(saId);
+    if (iter == saProfileIndex_.end()) {
+        return;
+    }
+    for (auto& profileIter : iter->second) {
+        saProfiles_.erase(profileIter);
+    }
+    saProfileIndex_.erase(iter);
 }
 
 uint32_t ParseUtil::GetBootPriorityPara(const std::string& bootPhase)
@@ -281,6 +295,40 @@ bool ParseUtil::ParseSaProfiles(const string& profilePath)
     }
 }
 
+void ParseUtil::ParseSaProfilesConcurrently(const std::vector<std::string>& profilePaths, size_t workerNum,
+    std::list<SaProfile>& saProfiles, std::set<int32_t>& multiInstanceSaIds)
+{
+    size_t fileNum = profilePaths.size();
+    std::vector<std::list<SaProfile>> fileProfiles(fileNum);
+    std::vector<std::set<int32_t>> fileMultiInstanceSaIds(fileNum);
+    std::atomic<size_t> nextFile {0};
+    auto worker = [&]() {
+        for (size_t i = nextFile.fetch_add(1); i < fileNum; i = nextFile.fetch_add(1)) {
+            ParseUtil parser;
+            parser.ParseSaProfiles(profilePaths[i]);
+            parser.saProfileIndex_.clear();
+            fileProfiles[i].splice(fileProfiles[i].end(), parser.saProfiles_);
+            fileMultiInstanceSaIds[i].swap(parser.multiInstanceSaIds_);
+        }
+    };
+    workerNum = std::max<size_t>(std::min(workerNum, fileNum), 1);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workerNum; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // merge in file order, so the priority order of GetFilesByPriority is kept
+    for (size_t i = 0; i < fileNum; i++) {
+        saProfiles.splice(saProfiles.end(), fileProfiles[i]);
+        multiInstanceSaIds.insert(fileMultiInstanceSaIds[i].begin(), fileMultiInstanceSaIds[i].end());
+    }
+    HILOGI("ParseSaProfilesConcurrently files:%{public}zu, workers:%{public}zu, SA:%{public}zu",
+        fileNum, workerNum, saProfiles.size());
+}
+
 bool ParseUtil::Endswith(const std::string& src, const std::string& sub)
 {
     return (src.length() >= sub.length() && (src.rfind(sub) == (src.length() - sub.length())));
@@ -369,6 +417,7 @@ bool ParseUtil::ParseJsonFile(const string& realPath)
             continue;
         }
         saProfiles_.emplace_back(saProfile);
+        saProfileIndex_[saProfile.saId].emplace_back(std::prev(saProfiles_.end()));
     }
 #ifdef SUPPORT_MULTI_INSTANCE
     ParseMultiInstanceSaIds(systemAbilityJson);
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "nlohmann/json.hpp"
+#include "parse_util.h"
+
+using namespace OHOS;
+
+namespace {
+const std::string PROFILE_PATH = "/data/local/tmp/samgr_parse_util_benchmark.json";
+constexpr int32_t BASE_SA_ID = 10000;
+constexpr int32_t MIN_PROFILE_NUM = 64;
+constexpr int32_t MAX_PROFILE_NUM = 1024;
+// a typical image ships one small profile per process
+constexpr int32_t PROFILE_FILE_NUM = 256;
+constexpr int32_t SA_PER_PROFILE_FILE = 4;
+constexpr int32_t MAX_PARSE_WORKERS = 8;
+
+// one process profile holding profileNum synthetic SAs, the way a large image ships them
+bool WriteProfiles(int32_t profileNum)
+{
+    nlohmann::json profileJson;
+    profileJson["process"] = "benchmark";
+    for (int32_t i = 0; i < profileNum; ++i) {
+        nlohmann::json saJson;
+        saJson["name"] = BASE_SA_ID + i;
+        saJson["libpath"] = "libbenchmark_sa_" + std::to_string(i) + ".z.so";
+        saJson["run-on-create"] = false;
+        profileJson["systemability"].push_back(saJson);
+    }
+    std::ofstream profileStream(PROFILE_PATH, std::ios::trunc);
+    profileStream << profileJson.dump();
+    return profileStream.good();
+}
+
+bool WriteProfileFiles(std::vector<std::string>& profilePaths)
+{
+    for (int32_t file = 0; file < PROFILE_FILE_NUM; ++file) {
+        nlohmann::json profileJson;
+        profileJson["process"] = "benchmark_" + std::to_string(file);
+        for (int32_t i = 0; i < SA_PER_PROFILE_FILE; ++i) {
+            nlohmann::json saJson;
+            saJson["name"] = BASE_SA_ID + file * SA_PER_PROFILE_FILE + i;
+            saJson["libpath"] = "libbenchmark_sa_" + std::to_string(file) + "_" + std::to_string(i) + ".z.so";
+            saJson["run-on-create"] = false;
+            profileJson["systemability"].push_back(saJson);
+        }
+        std::string profilePath = "/data/local/tmp/samgr_parse_util_benchmark_" + std::to_string(file) + ".json";
+        std::ofstream profileStream(profilePath, std::ios::trunc);
+        profileStream << profileJson.dump();
+        if (!profileStream.good()) {
+            return false;
+        }
+        profilePaths.emplace_back(profilePath);
+    }
+    return true;
+}
+
+bool PrepareParser(benchmark::State& state, ParseUtil& parser)
+{
+    if (!WriteProfiles(static_cast<int32_t>(state.range(0))) || !parser.ParseSaProfiles(PROFILE_PATH)) {
+        state.SkipWithError("parse synthetic profiles failed");
+        return false;
+    }
+    return true;
+}
+
+// the list scan GetProfile did before profiles were indexed by saId
+void LinearGetProfile(benchmark::State& state)
+{
+    ParseUtil parser;
+    if (!PrepareParser(state, parser)) {
+        return;
+    }
+    const auto& saProfiles = parser.GetAllSaProfiles();
+    int32_t index = 0;
+    for (auto _ : state) {
+        int32_t saId = BASE_SA_ID + (index++ % state.range(0));
+        auto iter = std::find_if(saProfiles.begin(), saProfiles.end(), [saId](const SaProfile& saProfile) {
+            return saProfile.saId == saId;
+        });
+        SaProfile saProfile = *iter;
+        benchmark::DoNotOptimize(saProfile);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void IndexedGetProfile(benchmark::State& state)
+{
+    ParseUtil parser;
+    if (!PrepareParser(state, parser)) {
+        return;
+    }
+    int32_t index = 0;
+    for (auto _ : state) {
+        SaProfile saProfile;
+        benchmark::DoNotOptimize(parser.GetProfile(BASE_SA_ID + (index++ % state.range(0)), saProfile));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void IndexedRemoveSaProfile(benchmark::State& state)
+{
+    ParseUtil parser;
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (!PrepareParser(state, parser)) {
+            return;
+        }
+        state.ResumeTiming();
+        for (int32_t i = 0; i < state.range(0); ++i) {
+            parser.RemoveSaProfile(BASE_SA_ID + i);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// what InitSaProfile did before: one parser over every file, then a copy of the whole profile list
+void SerialParseSaProfiles(benchmark::State& state)
+{
+    std::vector<std::string> profilePaths;
+    if (!WriteProfileFiles(profilePaths)) {
+        state.SkipWithError("write synthetic profiles failed");
+        return;
+    }
+    for (auto _ : state) {
+        ParseUtil parser;
+        for (const auto& profilePath : profilePaths) {
+            parser.ParseSaProfiles(profilePath);
+        }
+        std::list<SaProfile> saProfiles = parser.GetAllSaProfiles();
+        benchmark::DoNotOptimize(saProfiles);
+    }
+    state.SetItemsProcessed(state.iterations() * PROFILE_FILE_NUM);
+}
+
+void ConcurrentParseSaProfiles(benchmark::State& state)
+{
+    std::vector<std::string> profilePaths;
+    if (!WriteProfileFiles(profilePaths)) {
+        state.SkipWithError("write synthetic profiles failed");
+        return;
+    }
+    for (auto _ : state) {
+        std::list<SaProfile> saProfiles;
+        std::set<int32_t> multiInstanceSaIds;
+        ParseUtil::ParseSaProfilesConcurrently(profilePaths, state.range(0), saProfiles, multiInstanceSaIds);
+        benchmark::DoNotOptimize(saProfiles);
+    }
+    state.SetItemsProcessed(state.iterations() * PROFILE_FILE_NUM);
+}
+} // namespace
+
+BENCHMARK(LinearGetProfile)->RangeMultiplier(2)->Range(MIN_PROFILE_NUM, MAX_PROFILE_NUM);
+BENCHMARK(IndexedGetProfile)->RangeMultiplier(2)->Range(MIN_PROFILE_NUM, MAX_PROFILE_NUM);
+BENCHMARK(IndexedRemoveSaProfile)->RangeMultiplier(2)->Range(MIN_PROFILE_NUM, MAX_PROFILE_NUM);
+
+BENCHMARK(SerialParseSaProfiles)->UseRealTime();
+BENCHMARK(ConcurrentParseSaProfiles)->RangeMultiplier(2)->Range(1, MAX_PARSE_WORKERS)->UseRealTime();
+
+BENCHMARK_MAIN();
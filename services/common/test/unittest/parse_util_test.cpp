@@ -393,6 +393,49 @@ HWTEST_F(ParseUtilTest, RemoveSaProfile005, TestSize.Level3)
     EXPECT_EQ(profiles.size(), 1);
 }
 
+/**
+ * @tc.name: RemoveSaProfile006
+ * @tc.desc: Verify removed profiles can not be found any more
+ * @tc.type: FUNC
+ */
+HWTEST_F(ParseUtilTest, RemoveSaProfile006, TestSize.Level3)
+{
+    DTEST_LOG << " RemoveSaProfile006 start " << std::endl;
+    bool ret = parser_->ParseSaProfiles(TEST_RESOURCE_PATH + "multi_sa_profile.json");
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(parser_->saProfileIndex_[9997].size(), 2);
+    parser_->RemoveSaProfile(9997);
+    EXPECT_EQ(parser_->saProfileIndex_.count(9997), 0);
+    SaProfile saProfile;
+    EXPECT_FALSE(parser_->GetProfile(9997, saProfile));
+    EXPECT_FALSE(parser_->LoadSaLib(9997));
+    parser_->CloseSo(9997);
+    EXPECT_TRUE(parser_->GetProfile(9998, saProfile));
+    EXPECT_EQ(saProfile.saId, 9998);
+}
+
+/**
+ * @tc.name: GetProfile003
+ * @tc.desc: Verify the first parsed profile is returned for a duplicated id
+ * @tc.type: FUNC
+ */
+HWTEST_F(ParseUtilTest, GetProfile003, TestSize.Level3)
+{
+    DTEST_LOG << " GetProfile003 start " << std::endl;
+    bool ret = parser_->ParseSaProfiles(TEST_RESOURCE_PATH + "multi_sa_profile.json");
+    EXPECT_TRUE(ret);
+    auto first = std::find_if(parser_->saProfiles_.begin(), parser_->saProfiles_.end(),
+        [](const SaProfile& profile) { return profile.saId == 9997; });
+    ASSERT_NE(first, parser_->saProfiles_.end());
+    first->dumpLevel = TEST_NUM;
+    SaProfile saProfile;
+    EXPECT_TRUE(parser_->GetProfile(9997, saProfile));
+    EXPECT_EQ(saProfile.dumpLevel, TEST_NUM);
+    parser_->ClearResource();
+    EXPECT_TRUE(parser_->saProfileIndex_.empty());
+    EXPECT_FALSE(parser_->GetProfile(9997, saProfile));
+}
+
 /**
  * @tc.name: CheckPathExist001
  * @tc.desc:  Verify if can check not exist file
@@ -1393,6 +1436,43 @@ HWTEST_F(ParseUtilTest, ParseMultiInstance001, TestSize.Level3)
     DTEST_LOG << " ParseMultiInstance001 END" << std::endl;
 }
 
+/**
+ * @tc.name: ParseSaProfilesConcurrently001
+ * @tc.desc: parse profiles on several workers, the result equals parsing them one by one
+ * @tc.type: FUNC
+ */
+HWTEST_F(ParseUtilTest, ParseSaProfilesConcurrently001, TestSize.Level3)
+{
+    DTEST_LOG << " ParseSaProfilesConcurrently001 BEGIN" << std::endl;
+    std::vector<std::string> profilePaths = { TEST_RESOURCE_PATH + "multi_sa_profile.json",
+        TEST_RESOURCE_PATH + "notExist", TEST_RESOURCE_PATH + "profile.json",
+        TEST_RESOURCE_PATH + "sa_profile.json", TEST_RESOURCE_PATH + "sa_profile_large.json" };
+    ParseUtil serialParser;
+    for (const auto& profilePath : profilePaths) {
+        serialParser.ParseSaProfiles(profilePath);
+    }
+    const auto& serialProfiles = serialParser.GetAllSaProfiles();
+    for (size_t workerNum : { 0, 1, 3, 16 }) {
+        std::list<SaProfile> saProfiles;
+        std::set<int32_t> multiInstanceSaIds;
+        ParseUtil::ParseSaProfilesConcurrently(profilePaths, workerNum, saProfiles, multiInstanceSaIds);
+        ASSERT_EQ(saProfiles.size(), serialProfiles.size());
+        auto serialIter = serialProfiles.begin();
+        for (const auto& saProfile : saProfiles) {
+            EXPECT_EQ(saProfile.saId, serialIter->saId);
+            EXPECT_EQ(saProfile.process, serialIter->process);
+            EXPECT_EQ(saProfile.libPath, serialIter->libPath);
+            ++serialIter;
+        }
+        EXPECT_EQ(multiInstanceSaIds, serialParser.GetMultiInstanceSaIds());
+    }
+    std::list<SaProfile> saProfiles;
+    std::set<int32_t> multiInstanceSaIds;
+    ParseUtil::ParseSaProfilesConcurrently({}, 4, saProfiles, multiInstanceSaIds);
+    EXPECT_TRUE(saProfiles.empty());
+    DTEST_LOG << " ParseSaProfilesConcurrently001 END" << std::endl;
+}
+
 #ifdef SUPPORT_MULTI_INSTANCE
 /**
  * @tc.name: ParseMultiInstance002
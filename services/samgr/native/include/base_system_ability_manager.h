@@ -16,13 +16,17 @@
 #ifndef SERVICES_SAMGR_NATIVE_INCLUDE_BASE_SYSTEM_ABILITY_MANAGER_H
 #define SERVICES_SAMGR_NATIVE_INCLUDE_BASE_SYSTEM_ABILITY_MANAGER_H
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "ability_death_recipient.h"
 #include "device_status_collect_manager.h"
@@ -33,9 +37,15 @@
 #include "isystem_ability_status_change.h"
 #include "isystem_process_status_change.h"
 #include "rpc_callback_imp.h"
+#include "sa_frequency_counter.h"
+#include "sa_listener_notifier.h"
 #include "sa_profiles.h"
+#include "sa_record_table.h"
+#include "sa_striped_map.h"
+#include "samgr_latency_stats.h"
 #include "schedule/system_ability_state_scheduler.h"
 #include "samgr_ffrt_api.h"
+#include "system_process_executor.h"
 #include "timer.h"
 
 namespace OHOS {
@@ -76,6 +86,8 @@ public:
     virtual sptr<IRemoteObject> GetSystemAbility(int32_t systemAbilityId);
     virtual sptr<IRemoteObject> CheckSystemAbility(int32_t systemAbilityId);
     virtual sptr<IRemoteObject> CheckSystemAbility(int32_t systemAbilityId, bool& isExist);
+    virtual int32_t GetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+        std::vector<sptr<IRemoteObject>>& saList, std::vector<int32_t>& errCodes);
 
     virtual int32_t SubscribeSystemAbility(int32_t systemAbilityId,
         const sptr<ISystemAbilityStatusChange>& listener);
@@ -146,6 +158,12 @@ public:
     bool IsCacheCommonEvent(int32_t systemAbilityId);
     bool IsModuleUpdate(int32_t systemAbilityId);
     void RemoveOnDemandSaInDiedProc(std::shared_ptr<SystemProcessContext>& processContext);
+    // CheckSystemAbility without the caller bookkeeping, for samgr's own lookups
+    sptr<IRemoteObject> PeekSystemAbility(int32_t systemAbilityId);
+    std::shared_ptr<SystemProcessExecutor> GetSystemProcessExecutor() const
+    {
+        return processExecutor_;
+    }
     void RemoveWhiteCommonEvent()
     {
         if (collectManager_ != nullptr) {
@@ -201,7 +219,13 @@ protected:
         int64_t begin;
     };
 
+    // lock wait of these three is shown by the latency dump
+    using AbilityMapLock = WaitTrackedSharedMutex<SamgrLockId::ABILITY_MAP>;
+    using ListenerMapLock = WaitTrackedMutex<SamgrLockId::LISTENER_MAP>;
+    using OnDemandLock = WaitTrackedMutex<SamgrLockId::ON_DEMAND>;
+
     int32_t StartOnDemandAbility(int32_t systemAbilityId, bool& isExist);
+    OnDemandLock& GetOnDemandLock(int32_t systemAbilityId);
     int32_t StartOnDemandAbilityLocked(int32_t systemAbilityId, bool& isExist);
     void StartOnDemandAbility(const std::u16string& name, int32_t systemAbilityId);
     void StartOnDemandAbilityLocked(const std::u16string& name, int32_t systemAbilityId);
@@ -217,6 +241,9 @@ protected:
         const OnDemandEvent& event);
     virtual int32_t StartDynamicSystemProcess(const std::u16string& name, int32_t systemAbilityId,
         const OnDemandEvent& event);
+    void PostStartSystemProcess(const std::u16string& name, int32_t systemAbilityId, const OnDemandEvent& event);
+    void OnStartSystemProcessFailed(const std::u16string& name, int32_t systemAbilityId, int32_t result);
+    void CleanCallbackForStartFailed(int32_t systemAbilityId, int32_t result);
     bool IsInitBootFinished();
 
     void RefreshListenerState(int32_t systemAbilityId);
@@ -227,9 +254,10 @@ protected:
     void NotifySystemAbilityChanged(int32_t systemAbilityId, const std::string& deviceId, int32_t code,
         const sptr<ISystemAbilityStatusChange>& listener);
     void NotifySystemAbilityAddedByAsync(int32_t systemAbilityId,
-        const sptr<ISystemAbilityStatusChange>& listener);
-    void UnSubscribeSystemAbilityLocked(std::list<SAListener>& listenerList,
-        const sptr<IRemoteObject>& listener);
+        const sptr<ISystemAbilityStatusChange>& listener, int32_t callingPid);
+    bool IsListenerSubscribedLocked(const sptr<IRemoteObject>& listener);
+    void UnSubscribeSystemAbilityLocked(int32_t systemAbilityId, const sptr<IRemoteObject>& listener);
+    void EraseListenerLocked(int32_t systemAbilityId, std::list<SAListener>::iterator item);
 
     void SendSystemAbilityAddedMsg(int32_t systemAbilityId, const sptr<IRemoteObject>& remoteObject);
     void SendSystemAbilityRemovedMsg(int32_t systemAbilityId);
@@ -258,26 +286,49 @@ protected:
         const sptr<IRemoteObject>& remoteObject);
 
     void InitSaProfile();
+    void ParseSaProfiles(const std::vector<std::string>& profileFiles, std::list<SaProfile>& saInfos,
+        std::set<int32_t>& multiInstanceSaIds);
+    void SaveSaProfileCache(uint64_t fingerprint, const std::shared_ptr<const std::list<SaProfile>>& saInfos,
+        const std::set<int32_t>& multiInstanceSaIds);
     void SystemAbilityInvalidateCache(int32_t systemAbilityId);
 
-    int32_t UpdateSaFreMap(int32_t uid, int32_t saId);
+    // lookups on the IPC path read abilityTable_ and never touch abilityMapLock_
+    bool FindAbility(int32_t systemAbilityId, SAInfo& saInfo) const;
+    // mirror the abilityMap_ entry of one SA, or all of them, into abilityTable_
+    void PublishAbilityLocked(int32_t systemAbilityId);
+    void RefreshAbilityTableLocked();
+
+    void UpdateSaFreMap(int32_t uid, int32_t saId);
+    // calls of uid to saId since the last report, summed over the shards; only for the slow paths
+    int32_t GetSaFreCount(int32_t uid, int32_t saId);
+    void MergeSaFreMapLocked();
 
-    samgr::shared_mutex abilityMapLock_;
+    AbilityMapLock abilityMapLock_;
     std::map<int32_t, SAInfo> abilityMap_;
+    SaRecordTable<SAInfo> abilityTable_;
 
-    samgr::mutex listenerMapLock_;
+    ListenerMapLock listenerMapLock_;
     std::map<int32_t, std::list<SAListener>> listenerMap_;
+    // listener object -> position of each of its subscriptions in listenerMap_
+    std::unordered_map<IRemoteObject*, std::unordered_map<int32_t, std::list<SAListener>::iterator>> listenerIndex_;
+    // status-change notifications are delivered through here, never under listenerMapLock_
+    std::shared_ptr<SaListenerNotifier> listenerNotifier_ = std::make_shared<SaListenerNotifier>();
     std::map<int32_t, int32_t> subscribeCountMap_;
 
-    samgr::mutex onDemandLock_;
-    std::map<int32_t, std::u16string> onDemandAbilityMap_;
-    std::map<int32_t, AbilityItem> startingAbilityMap_;
+    // on-demand load state is striped by SA id, GetOnDemandLock guards the SA's stripe of both maps
+    std::array<OnDemandLock, SaStripedMap<AbilityItem>::STRIPE_NUM> onDemandLocks_;
+    SaStripedMap<std::u16string> onDemandAbilityMap_;
+    SaStripedMap<AbilityItem> startingAbilityMap_;
 
     samgr::mutex systemProcessMapLock_;
     std::map<std::u16string, sptr<IRemoteObject>> systemProcessMap_;
 
     samgr::mutex startingProcessMapLock_;
     std::map<std::u16string, StartingProcessInfo> startingProcessMap_;
+    // init start/stop round trips run here, never on a binder thread or under a process lock
+    std::shared_ptr<SystemProcessExecutor> processExecutor_ = std::make_shared<SystemProcessExecutor>();
+    // per calling pid across all SAs, taken inside a stripe lock and never the other way round
+    samgr::mutex callbackCountLock_;
     std::map<int32_t, int32_t> callbackCountMap_;
 
     std::map<int32_t, CommonSaProfile> saProfileMap_;
@@ -287,8 +338,9 @@ protected:
     samgr::mutex loadRemoteLock_;
     std::map<std::string, std::list<sptr<ISystemAbilityLoadCallback>>> remoteCallbacks_;
 
+    SaFrequencyCounter saFrequencyCounter_;
     samgr::mutex saFrequencyLock_;
-    std::map<uint64_t, int32_t> saFrequencyMap_; // {pid_said, count}
+    std::map<uint64_t, int32_t> saFrequencyMap_; // {pid_said, count}, merged from saFrequencyCounter_
 #ifdef SUPPORT_MULTI_INSTANCE
     samgr::mutex multiInstanceSaIdsLock_;
     std::set<int32_t> multiInstanceSaIds_;
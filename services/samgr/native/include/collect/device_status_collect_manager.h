@@ -18,6 +18,9 @@
 
 #include <list>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "ffrt_handler.h"
 #include "icollect_plugin.h"
@@ -38,6 +41,8 @@ public:
     void CleanFfrt();
     void SetFfrt();
     void ReportEvent(const OnDemandEvent& event) override;
+    // reported events are queued and resolved in batches on the collect handler
+    void ReportEvents(const std::vector<OnDemandEvent>& events) override;
     void StartCollect();
     void PostTask(std::function<void()> callback) override;
     void PostDelayTask(std::function<void()> callback, int32_t delayTime) override;
@@ -56,7 +61,40 @@ public:
     int32_t IsExistInPluginMap(int32_t eventId);
     void RemoveWhiteCommonEvent();
     const std::vector<int32_t>& GetLowMemPrepareList();
+    void OnSystemAbilityAdded(int32_t systemAbilityId);
+    void OnSystemAbilityRemoved(int32_t systemAbilityId);
 private:
+    struct OnDemandEventKey {
+        int32_t eventId = -1;
+        std::string name;
+        std::string value;
+        bool operator==(const OnDemandEventKey& other) const
+        {
+            return eventId == other.eventId && name == other.name && value == other.value;
+        }
+    };
+    struct OnDemandEventKeyHash {
+        size_t operator()(const OnDemandEventKey& key) const
+        {
+            size_t hash = std::hash<std::string>()(key.name) ^ (std::hash<std::string>()(key.value) << 1);
+            return hash ^ (static_cast<size_t>(key.eventId) << 2);
+        }
+    };
+    // one start or stop of an SA after the reported events of a batch were merged
+    struct OnDemandAction {
+        size_t eventIndex = 0;
+        SaControlInfo saControl;
+    };
+    // one start or stop event of an on-demand SA, ordered as the profile scan used to report it
+    struct OnDemandEventEntry {
+        size_t profileOrder = 0;
+        int32_t ondemandId = START_ON_DEMAND;
+        size_t eventOrder = 0;
+        int32_t saId = -1;
+        bool cacheCommonEvent = false;
+        OnDemandEvent event;
+    };
+
     bool NeedPersistOnDemandEvent(const OnDemandEvent& event);
     void PersistOnDemandEvent(int32_t systemAbilityId, OnDemandPolicyType type,
         const std::vector<OnDemandEvent>& events);
@@ -67,7 +105,15 @@ private:
         std::list<SaControlInfo>& saControlList);
     void GetSaControlListByEvent(const OnDemandEvent& event, std::list<SaControlInfo>& saControlList);
     void SortSaControlListByLoadPriority(std::list<SaControlInfo>& saControlList);
+    void DrainReportedEvents();
+    // keep the last requested action per SA, drop repeats and order the rest by load priority
+    void MergeOnDemandActions(const std::vector<OnDemandEvent>& events, std::list<OnDemandAction>& actions);
+    void DispatchOnDemandActions(const std::vector<OnDemandEvent>& events, const std::list<OnDemandAction>& actions);
     bool CheckEventUsedLocked(const OnDemandEvent& events);
+    void AddEventIndexLocked(const CollMgrSaProfile& profile, size_t profileOrder, OnDemandPolicyType type);
+    void RemoveEventIndexLocked(int32_t systemAbilityId, OnDemandPolicyType type,
+        const std::vector<OnDemandEvent>& events);
+    void FindEventIndexLocked(const OnDemandEventKey& key, std::vector<const OnDemandEventEntry*>& candidates);
     static bool IsSameEvent(const OnDemandEvent& ev1, const OnDemandEvent& ev2);
     bool IsSameEventName(const OnDemandEvent& ev1, const OnDemandEvent& ev2);
     bool CheckConditions(const OnDemandEvent& onDemandEvent);
@@ -79,6 +125,11 @@ private:
     std::weak_ptr<BaseSystemAbilityManager> manager_;
     samgr::shared_mutex saProfilesLock_;
     std::list<CollMgrSaProfile> onDemandSaProfiles_;
+    // (eventId, name, value) -> start/stop events declaring it, guarded by saProfilesLock_
+    std::unordered_map<OnDemandEventKey, std::vector<OnDemandEventEntry>, OnDemandEventKeyHash> eventIndex_;
+    samgr::mutex pendingEventsLock_;
+    std::vector<OnDemandEvent> pendingEvents_;
+    bool eventDrainPosted_ = false;
 };
 } // namespace OHOS
 #endif // OHOS_SYSTEM_ABILITY_MANAGER_DEVICE_STATUS_COLLECT_MANAGER_H
\ No newline at end of file
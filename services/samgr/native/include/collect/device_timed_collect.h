@@ -21,6 +21,7 @@
 #endif
 #include "icollect_plugin.h"
 #include "samgr_ffrt_api.h"
+#include "timed_event_queue.h"
 
 #include <set>
 
@@ -43,7 +44,7 @@ private:
     void SaveTimedEvent(const OnDemandEvent& onDemandEvent);
     void SaveTimedInfos(const OnDemandEvent& onDemandEvent, int32_t interval);
     void ReportEventByTimeInfo(int32_t interval, bool persistence);
-    void PostDelayTaskByTimeInfo(std::function<void()> callback, int32_t interval, int32_t disTime);
+    void GetEventsByTimeInfo(int32_t interval, bool persistence, std::vector<OnDemandEvent>& events);
     int64_t CalculateDelayTime(const std::string& timeString);
     void PostPersistenceLoopTasks();
     void PostNonPersistenceLoopTasks();
@@ -57,8 +58,18 @@ private:
     void ProcessPersistenceLoopTask(int64_t disTime, int64_t triggerTime, std::string strInterval);
     void ProcessPersistenceTimedTask(int64_t disTime, std::string timeString);
 
-    void PostPersistenceDelayTask(std::function<void()> loopTask,
-        int32_t interval, int32_t disTime);
+    void PostPersistenceDelayTask(int32_t interval, int32_t disTime);
+    void SavePersistenceTriggerTime(int32_t interval, int64_t disTime);
+
+    // all loop and order timed events share two deadline queues, one per wakeup source
+    bool ScheduleTimedEvent(const TimedEventKey& key, int64_t delayTime);
+    bool ScheduleTimedEventLocked(const TimedEventKey& key, int64_t deadline);
+    void CancelTimedEvent(const TimedEventKey& key);
+    bool IsTimedEventScheduled(const TimedEventKey& key);
+    void ArmWakeupLocked(bool awake, int64_t now);
+    void OnTimerExpired(bool awake, int64_t armedDeadline);
+    void ProcessDueEventLocked(const DueTimedEvent& dueEvent, int64_t now, std::vector<OnDemandEvent>& events);
+    static int64_t GetBootTimeMs();
 
     void RemoveNonPersistenceLoopTask(int32_t interval);
     void RemovePersistenceLoopTask(int32_t interval);
@@ -69,10 +80,15 @@ private:
     samgr::mutex nonPersitenceTimedEventSetLock;
     samgr::mutex persitenceLoopEventSetLock_;
     samgr::mutex persitenceTimedEventSetLock_;
-    std::map<int32_t, std::function<void()>> nonPersitenceLoopTasks_;
-    std::map<int32_t, std::function<void()>> persitenceLoopTasks_;
     samgr::mutex timeInfosLock_;
     std::map<int32_t, TimeInfo> timeInfos_;
+    samgr::mutex timerLock_;
+    TimedEventQueue normalQueue_;
+    TimedEventQueue awakeQueue_;
+    int64_t normalArmedDeadline_ = -1;
+    int64_t awakeArmedDeadline_ = -1;
+    // the alarm behind awakeArmedDeadline_, so a superseded one does not wake the device for nothing
+    uint64_t awakeTaskId_ = 0;
 #ifdef PREFERENCES_ENABLE
     std::shared_ptr<PreferencesUtil> preferencesUtil_;
 #endif
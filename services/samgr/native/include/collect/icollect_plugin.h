@@ -82,12 +82,15 @@ public:
     {
         return ERR_OK;
     }
+    virtual void OnSystemAbilityAdded(int32_t systemAbilityId) {};
+    virtual void OnSystemAbilityRemoved(int32_t systemAbilityId) {};
     virtual const std::vector<int32_t>& GetLowMemPrepareList()
     {
         static std::vector<int32_t> res;
         return res;
     }
     void ReportEvent(const OnDemandEvent& event);
+    void ReportEvents(const std::vector<OnDemandEvent>& events);
     void PostTask(std::function<void()> callback);
     void PostDelayTask(std::function<void()> callback, int32_t delayTime);
 private:
@@ -16,6 +16,8 @@
 #ifndef OHOS_SYSTEM_ABILITY_MANAGER_REPORT_INTERFACE_H
 #define OHOS_SYSTEM_ABILITY_MANAGER_REPORT_INTERFACE_H
 
+#include <vector>
+
 #include "refbase.h"
 #include "sa_profiles.h"
 
@@ -25,6 +27,7 @@ public:
     IReport() = default;
     virtual ~IReport() = default;
     virtual void ReportEvent(const OnDemandEvent& event) = 0;
+    virtual void ReportEvents(const std::vector<OnDemandEvent>& events) = 0;
     virtual void PostTask(std::function<void()> callback) = 0;
     virtual void PostDelayTask(std::function<void()> callback, int32_t delayTime) = 0;
 };
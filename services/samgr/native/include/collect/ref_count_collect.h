@@ -16,6 +16,8 @@
 #ifndef OHOS_SYSTEM_ABILITY_MANAGER_REF_COUNT_COLLECT_H
 #define OHOS_SYSTEM_ABILITY_MANAGER_REF_COUNT_COLLECT_H
 
+#include <set>
+
 #include "system_ability_manager_proxy.h"
 #include "system_ability_manager.h"
 #include "iservice_registry.h"
@@ -34,11 +36,21 @@ public:
     int32_t OnStart() override;
     int32_t OnStop() override;
     void Init(const std::list<SaProfile>& saProfiles) override;
+    void OnSystemAbilityAdded(int32_t systemAbilityId) override;
+    void OnSystemAbilityRemoved(int32_t systemAbilityId) override;
 
 private:
+    bool IsUnrefUnloadSa(int32_t systemAbilityId) const;
     void IdentifyUnrefOndemand();
+    void ReportUnrefOndemand(std::list<SaControlInfo>&& saControlList);
+    // the poll only runs while an unref-unload SA is loaded, it shortens after a hit and backs off again
+    void SchedulePollLocked();
     std::list<int32_t> unrefUnloadSaList_;
     std::unique_ptr<Utils::Timer> timer_;
+    samgr::mutex pollLock_;
+    std::set<int32_t> loadedUnrefSaSet_;
+    uint32_t pollInterval_;
+    uint32_t timerId_ = 0;
 };
 
 } // namespace OHOS
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SYSTEM_ABILITY_MANAGER_TIMED_EVENT_QUEUE_H
+#define OHOS_SYSTEM_ABILITY_MANAGER_TIMED_EVENT_QUEUE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace OHOS {
+// one loop interval (interval > 0) or one order timed event (interval == 0, keyed by its time string)
+struct TimedEventKey {
+    int32_t interval = 0;
+    bool persistence = false;
+    std::string timeString;
+
+    bool operator<(const TimedEventKey& other) const
+    {
+        return std::tie(interval, persistence, timeString) <
+            std::tie(other.interval, other.persistence, other.timeString);
+    }
+};
+
+struct DueTimedEvent {
+    TimedEventKey key;
+    int64_t deadline = 0;
+};
+
+// Deadline-ordered set of timed events. Everything due within the coalescing window of the earliest
+// deadline is popped together, so one wakeup serves all of them. Not thread safe, the owner locks.
+class TimedEventQueue {
+public:
+    explicit TimedEventQueue(int64_t coalesceWindowMs) : coalesceWindowMs_(coalesceWindowMs) {}
+
+    // add or move key to deadline, return true when it became the earliest deadline
+    bool Schedule(const TimedEventKey& key, int64_t deadline)
+    {
+        Cancel(key);
+        auto iter = deadlines_.emplace(deadline, key);
+        index_[key] = iter;
+        return iter == deadlines_.begin();
+    }
+
+    bool Cancel(const TimedEventKey& key)
+    {
+        auto iter = index_.find(key);
+        if (iter == index_.end()) {
+            return false;
+        }
+        deadlines_.erase(iter->second);
+        index_.erase(iter);
+        return true;
+    }
+
+    bool Contains(const TimedEventKey& key) const
+    {
+        return index_.count(key) > 0;
+    }
+
+    // -1 when nothing is scheduled
+    int64_t NextDeadline() const
+    {
+        return deadlines_.empty() ? -1 : deadlines_.begin()->first;
+    }
+
+    void PopDue(int64_t now, std::vector<DueTimedEvent>& due)
+    {
+        while (!deadlines_.empty() && deadlines_.begin()->first <= now + coalesceWindowMs_) {
+            auto iter = deadlines_.begin();
+            due.push_back({iter->second, iter->first});
+            index_.erase(iter->second);
+            deadlines_.erase(iter);
+        }
+    }
+
+    size_t Size() const
+    {
+        return index_.size();
+    }
+
+private:
+    int64_t coalesceWindowMs_;
+    std::multimap<int64_t, TimedEventKey> deadlines_;
+    std::map<TimedEventKey, std::multimap<int64_t, TimedEventKey>::iterator> index_;
+};
+} // namespace OHOS
+#endif // OHOS_SYSTEM_ABILITY_MANAGER_TIMED_EVENT_QUEUE_H
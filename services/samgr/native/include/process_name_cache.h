@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_PROCESS_NAME_CACHE_H
+#define OHOS_SAMGR_PROCESS_NAME_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "datetime_ex.h"
+#include "samgr_ffrt_api.h"
+
+namespace OHOS {
+// pid -> process name for DFX reporting. An entry is trusted for RECHECK_INTERVAL_MS after it was last
+// checked, after that the pid start time is compared so a reused pid never reports the old name.
+// Owners drop entries of processes they saw die; the least recently checked entry goes when full.
+class ProcessNameCache {
+public:
+    using NameLoader = std::function<std::string(int32_t pid)>;
+    using StartTimeLoader = std::function<uint64_t(int32_t pid)>;
+
+    static constexpr size_t MAX_CACHE_SIZE = 256;
+    static constexpr int64_t RECHECK_INTERVAL_MS = 1000;
+
+    ProcessNameCache(NameLoader nameLoader, StartTimeLoader startTimeLoader)
+        : nameLoader_(std::move(nameLoader)), startTimeLoader_(std::move(startTimeLoader)) {}
+
+    // procfs is read without holding the cache lock
+    std::string Get(int32_t pid)
+    {
+        if (pid <= 0) {
+            return nameLoader_(pid);
+        }
+        int64_t now = GetTickCount();
+        CacheEntry cached;
+        bool found = false;
+        {
+            std::lock_guard<samgr::mutex> autoLock(cacheLock_);
+            auto iter = cache_.find(pid);
+            if (iter != cache_.end()) {
+                if (now - iter->second.checkTick < RECHECK_INTERVAL_MS) {
+                    return iter->second.name;
+                }
+                cached = iter->second;
+                found = true;
+            }
+        }
+        uint64_t startTime = startTimeLoader_(pid);
+        if (found && startTime != 0 && cached.startTime == startTime) {
+            std::lock_guard<samgr::mutex> autoLock(cacheLock_);
+            auto iter = cache_.find(pid);
+            if (iter != cache_.end() && iter->second.startTime == startTime) {
+                iter->second.checkTick = now;
+            }
+            return cached.name;
+        }
+        std::string name = nameLoader_(pid);
+        std::lock_guard<samgr::mutex> autoLock(cacheLock_);
+        if (name.empty() || startTime == 0) {
+            cache_.erase(pid);
+            return name;
+        }
+        if (cache_.count(pid) == 0 && cache_.size() >= MAX_CACHE_SIZE) {
+            EvictOldestLocked();
+        }
+        cache_[pid] = {name, startTime, now};
+        return name;
+    }
+
+    void Remove(int32_t pid)
+    {
+        std::lock_guard<samgr::mutex> autoLock(cacheLock_);
+        cache_.erase(pid);
+    }
+
+    size_t Size()
+    {
+        std::lock_guard<samgr::mutex> autoLock(cacheLock_);
+        return cache_.size();
+    }
+
+private:
+    struct CacheEntry {
+        std::string name;
+        uint64_t startTime = 0;
+        int64_t checkTick = 0;
+    };
+
+    void EvictOldestLocked()
+    {
+        auto oldest = cache_.begin();
+        for (auto iter = cache_.begin(); iter != cache_.end(); ++iter) {
+            if (iter->second.checkTick < oldest->second.checkTick) {
+                oldest = iter;
+            }
+        }
+        if (oldest != cache_.end()) {
+            cache_.erase(oldest);
+        }
+    }
+
+    NameLoader nameLoader_;
+    StartTimeLoader startTimeLoader_;
+    samgr::mutex cacheLock_;
+    std::unordered_map<int32_t, CacheEntry> cache_;
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_PROCESS_NAME_CACHE_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_PROCESS_NAME_TABLE_H
+#define OHOS_SAMGR_PROCESS_NAME_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "samgr_ffrt_api.h"
+#include "string_ex.h"
+
+namespace OHOS {
+using ProcessNameId = uint32_t;
+constexpr ProcessNameId INVALID_PROCESS_NAME_ID = UINT32_MAX;
+
+// Interns process names once, when the profiles are loaded, and keeps both the utf-16 and utf-8 form,
+// so the request paths do not convert or allocate a name again. Ids and returned references stay valid
+// for the life of the process, names are never removed.
+class ProcessNameTable {
+public:
+    static ProcessNameTable& GetInstance()
+    {
+        static ProcessNameTable instance;
+        return instance;
+    }
+
+    ProcessNameId Intern(const std::u16string& name)
+    {
+        {
+            std::shared_lock<samgr::shared_mutex> readLock(lock_);
+            auto iter = ids_.find(name);
+            if (iter != ids_.end()) {
+                return iter->second;
+            }
+        }
+        std::unique_lock<samgr::shared_mutex> writeLock(lock_);
+        auto iter = ids_.find(name);
+        if (iter != ids_.end()) {
+            return iter->second;
+        }
+        ProcessNameId id = static_cast<ProcessNameId>(entries_.size());
+        entries_.push_back({name, Str16ToStr8(name)});
+        ids_.emplace(name, id);
+        return id;
+    }
+
+    // INVALID_PROCESS_NAME_ID when the name was never interned
+    ProcessNameId Find(const std::u16string& name) const
+    {
+        std::shared_lock<samgr::shared_mutex> readLock(lock_);
+        auto iter = ids_.find(name);
+        return (iter == ids_.end()) ? INVALID_PROCESS_NAME_ID : iter->second;
+    }
+
+    const std::string& GetStr8(ProcessNameId id) const
+    {
+        std::shared_lock<samgr::shared_mutex> readLock(lock_);
+        return (id < entries_.size()) ? entries_[id].str8 : emptyEntry_.str8;
+    }
+
+    const std::u16string& GetStr16(ProcessNameId id) const
+    {
+        std::shared_lock<samgr::shared_mutex> readLock(lock_);
+        return (id < entries_.size()) ? entries_[id].str16 : emptyEntry_.str16;
+    }
+
+    // utf-8 form of any name, interning it on first use
+    const std::string& GetStr8(const std::u16string& name)
+    {
+        return GetStr8(Intern(name));
+    }
+
+    size_t GetSize() const
+    {
+        std::shared_lock<samgr::shared_mutex> readLock(lock_);
+        return entries_.size();
+    }
+
+private:
+    struct Entry {
+        std::u16string str16;
+        std::string str8;
+    };
+
+    ProcessNameTable() = default;
+
+    mutable samgr::shared_mutex lock_;
+    // a deque never moves its elements on push_back, which keeps the returned references valid
+    std::deque<Entry> entries_;
+    std::unordered_map<std::u16string, ProcessNameId> ids_;
+    const Entry emptyEntry_;
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_PROCESS_NAME_TABLE_H
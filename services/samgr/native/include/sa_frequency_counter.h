@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_SA_FREQUENCY_COUNTER_H
+#define OHOS_SAMGR_SA_FREQUENCY_COUNTER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "samgr_ffrt_api.h"
+
+namespace OHOS {
+// Call counters split into per-thread shards. Each IPC thread is bound to its own shard the first
+// time it counts, so Increase() only ever takes an uncontended lock; GetCount() and Drain() visit all shards.
+class SaFrequencyCounter {
+public:
+    static constexpr size_t SHARD_NUM = 32;
+
+    // count key in the caller's shard, saturating at maxCount
+    void Increase(uint64_t key, int32_t maxCount)
+    {
+        Shard& shard = shards_[GetShardIndex()];
+        std::lock_guard<samgr::mutex> lock(shard.lock);
+        auto& count = shard.counts[key];
+        if (count < maxCount) {
+            count++;
+        }
+    }
+
+    // return the count of key over all shards since the last Drain(), saturating at maxCount
+    int32_t GetCount(uint64_t key, int32_t maxCount)
+    {
+        int32_t total = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<samgr::mutex> lock(shard.lock);
+            auto iter = shard.counts.find(key);
+            if (iter != shard.counts.end()) {
+                total = (iter->second > maxCount - total) ? maxCount : total + iter->second;
+            }
+        }
+        return total;
+    }
+
+    // move every shard's counts into merged, saturating at maxCount
+    void Drain(std::map<uint64_t, int32_t>& merged, int32_t maxCount)
+    {
+        for (auto& shard : shards_) {
+            std::unordered_map<uint64_t, int32_t> counts;
+            {
+                std::lock_guard<samgr::mutex> lock(shard.lock);
+                counts.swap(shard.counts);
+            }
+            for (const auto& [key, count] : counts) {
+                auto& total = merged[key];
+                total = (count > maxCount - total) ? maxCount : total + count;
+            }
+        }
+    }
+
+    size_t Size()
+    {
+        size_t size = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<samgr::mutex> lock(shard.lock);
+            size += shard.counts.size();
+        }
+        return size;
+    }
+
+private:
+    struct alignas(64) Shard {
+        samgr::mutex lock;
+        std::unordered_map<uint64_t, int32_t> counts;
+    };
+
+    static size_t GetShardIndex()
+    {
+        static std::atomic<size_t> nextIndex {0};
+        thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % SHARD_NUM;
+        return index;
+    }
+
+    std::array<Shard, SHARD_NUM> shards_;
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_SA_FREQUENCY_COUNTER_H
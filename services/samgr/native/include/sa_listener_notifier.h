@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_SA_LISTENER_NOTIFIER_H
+#define OHOS_SAMGR_SA_LISTENER_NOTIFIER_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "isystem_ability_status_change.h"
+#include "samgr_ffrt_api.h"
+
+namespace OHOS {
+struct ListenerNotifyTarget {
+    sptr<ISystemAbilityStatusChange> listener;
+    int32_t callingPid = -1;
+};
+
+struct ListenerNotifyMetrics {
+    int32_t callingPid = -1;
+    uint64_t notifyCount = 0;
+    uint64_t coalescedCount = 0;
+    uint64_t totalCostUs = 0;
+    uint64_t maxCostUs = 0;
+};
+
+// Delivers SA add/remove notifications to status-change listeners away from the caller.
+// Each listener has its own pending queue drained by at most one task at a time: events reach a listener in
+// order, a slow listener only delays itself, and add/remove bursts still pending for one SA are coalesced.
+// Queues are keyed by the listener address plus a generation, so a drain task queued for a removed listener
+// never serves a new listener that was allocated at the same address.
+class SaListenerNotifier : public std::enable_shared_from_this<SaListenerNotifier> {
+public:
+    void Notify(int32_t systemAbilityId, const std::string& deviceId, int32_t code,
+        const std::vector<ListenerNotifyTarget>& targets);
+    // drop the pending events and metrics of a listener that died or unsubscribed everything
+    void RemoveListener(const sptr<IRemoteObject>& listener);
+    size_t GetPendingCount();
+    void GetMetrics(std::vector<ListenerNotifyMetrics>& metrics);
+    void Dump(std::string& result);
+
+    static void Deliver(int32_t systemAbilityId, const std::string& deviceId, int32_t code,
+        const sptr<ISystemAbilityStatusChange>& listener);
+
+private:
+    struct PendingEvent {
+        int32_t systemAbilityId = -1;
+        std::string deviceId;
+        int32_t code = 0;
+    };
+
+    struct ListenerQueue {
+        sptr<ISystemAbilityStatusChange> listener;
+        std::list<PendingEvent> events;
+        bool draining = false;
+        uint64_t generation = 0;
+        ListenerNotifyMetrics metrics;
+    };
+
+    void EnqueueLocked(ListenerQueue& queue, int32_t systemAbilityId, const std::string& deviceId, int32_t code);
+    void Drain(IRemoteObject* key, uint64_t generation);
+
+    samgr::mutex queueLock_;
+    std::map<IRemoteObject*, ListenerQueue> queues_;
+    uint64_t nextGeneration_ = 1;
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_SA_LISTENER_NOTIFIER_H
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_SA_PROFILE_CACHE_H
+#define OHOS_SAMGR_SA_PROFILE_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "sa_profiles.h"
+
+namespace OHOS {
+// Binary snapshot of the parsed SA profiles, so boot does not need to run the json parser when the
+// profile files have not changed since the snapshot was written.
+// A loaded cache replaces the profiles under /system, so Load only trusts a cache that samgr alone can
+// write: the file and its directory must be owned by samgr's uid and not writable by group or others.
+// /data/samgr is created 0740 samgr samgr by samgr_standard.cfg and carries the samgr-only data label.
+class SaProfileCache {
+public:
+    // bump whenever the encoding or SaProfile changes, older caches are then ignored; a static_assert in
+    // sa_profile_cache.cpp fails when a cached struct gains or loses a field without a bump
+    static constexpr uint32_t CACHE_VERSION = 1;
+    static constexpr uint32_t CACHE_MAGIC = 0x43504153; // "SAPC"
+
+    // identifies one set of profile files by path, size and modification time
+    static uint64_t GetFingerprint(const std::vector<std::string>& files);
+    static bool Load(const std::string& cachePath, uint64_t fingerprint, std::list<SaProfile>& saProfiles,
+        std::set<int32_t>& multiInstanceSaIds);
+    static bool Save(const std::string& cachePath, uint64_t fingerprint, const std::list<SaProfile>& saProfiles,
+        const std::set<int32_t>& multiInstanceSaIds);
+
+private:
+    struct CacheHeader {
+        uint32_t magic = CACHE_MAGIC;
+        uint32_t version = CACHE_VERSION;
+        uint64_t fingerprint = 0;
+        uint32_t profileCount = 0;
+        uint32_t multiInstanceCount = 0;
+        uint64_t payloadSize = 0;
+        uint64_t checksum = 0;
+    };
+
+    static uint64_t Hash(const void* data, size_t size, uint64_t seed);
+    static bool IsTrusted(const std::string& cachePath, int32_t fd);
+    static bool Decode(const CacheHeader& header, const uint8_t* payload, std::list<SaProfile>& saProfiles,
+        std::set<int32_t>& multiInstanceSaIds);
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_SA_PROFILE_CACHE_H
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_SA_RECORD_TABLE_H
+#define OHOS_SAMGR_SA_RECORD_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+// Epochs behind the deferred reclamation of SaRecordTable. A reader announces the global epoch in a
+// cache line of its own before it touches a record and clears it afterwards. A record unlinked by a
+// writer is tagged with the epoch of its removal and freed once every announced epoch is newer.
+class SaReadEpoch {
+public:
+    // readers beyond this many threads share one counter, and reclamation waits for them to drain
+    static constexpr size_t SLOT_NUM = 128;
+
+    static SaReadEpoch& GetInstance()
+    {
+        static SaReadEpoch instance;
+        return instance;
+    }
+
+    // pins the records the calling thread can reach for its lifetime, guards may nest
+    class Guard {
+    public:
+        Guard()
+        {
+            SaReadEpoch::GetInstance().Enter();
+        }
+
+        ~Guard()
+        {
+            SaReadEpoch::GetInstance().Exit();
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    // called after a record was unlinked, returns the tag it is retired with
+    uint64_t Advance()
+    {
+        return epoch_.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    // records retired with a tag below this are unreachable
+    uint64_t GetMinActiveEpoch() const
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (overflowReaders_.load(std::memory_order_acquire) != 0) {
+            return 0;
+        }
+        uint64_t minEpoch = std::numeric_limits<uint64_t>::max();
+        for (const auto& slot : slots_) {
+            uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+            if (epoch != 0) {
+                minEpoch = std::min(minEpoch, epoch);
+            }
+        }
+        return minEpoch;
+    }
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch {0};
+        std::atomic<bool> owned {false};
+    };
+
+    // a thread claims its slot on first use and gives it back when it exits
+    struct ThreadState {
+        size_t index = SLOT_NUM;
+        uint32_t depth = 0;
+
+        ThreadState()
+        {
+            index = SaReadEpoch::GetInstance().ClaimSlot();
+        }
+
+        ~ThreadState()
+        {
+            if (index < SLOT_NUM) {
+                SaReadEpoch::GetInstance().slots_[index].owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    SaReadEpoch() = default;
+
+    static ThreadState& GetThreadState()
+    {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    size_t ClaimSlot()
+    {
+        for (size_t index = 0; index < SLOT_NUM; ++index) {
+            bool owned = false;
+            if (slots_[index].owned.compare_exchange_strong(owned, true, std::memory_order_acq_rel)) {
+                return index;
+            }
+        }
+        return SLOT_NUM;
+    }
+
+    void Enter()
+    {
+        ThreadState& state = GetThreadState();
+        if (state.depth++ != 0) {
+            return;
+        }
+        if (state.index < SLOT_NUM) {
+            slots_[state.index].epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        } else {
+            overflowReaders_.fetch_add(1, std::memory_order_relaxed);
+        }
+        // pairs with the fence in GetMinActiveEpoch: either the writer sees this reader or the
+        // reader sees the writer's unlink
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void Exit()
+    {
+        ThreadState& state = GetThreadState();
+        if (--state.depth != 0) {
+            return;
+        }
+        if (state.index < SLOT_NUM) {
+            slots_[state.index].epoch.store(0, std::memory_order_release);
+        } else {
+            overflowReaders_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    std::atomic<uint64_t> epoch_ {1};
+    std::atomic<uint32_t> overflowReaders_ {0};
+    std::array<ReaderSlot, SLOT_NUM> slots_;
+};
+
+// Records indexed by SA id in lazily allocated pages of atomic slots. A lookup loads one slot and
+// copies the record out under a SaReadEpoch::Guard, without a lock or a write to shared memory.
+// Writers must be serialized by the owner; a write replaces one slot, the record it unlinks is freed
+// by a later write once no reader can still hold it.
+template <typename Record>
+class SaRecordTable {
+public:
+    static constexpr int32_t MAX_ID = 0x00ffffff;
+    static constexpr uint32_t PAGE_BITS = 10;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+    static constexpr uint32_t PAGE_NUM = (static_cast<uint32_t>(MAX_ID) >> PAGE_BITS) + 1;
+
+    SaRecordTable() = default;
+
+    ~SaRecordTable()
+    {
+        for (auto& page : pages_) {
+            Page* current = page.load(std::memory_order_relaxed);
+            if (current == nullptr) {
+                continue;
+            }
+            for (auto& slot : current->slots) {
+                delete slot.load(std::memory_order_relaxed);
+            }
+            delete current;
+        }
+        for (auto& [tag, record] : retired_) {
+            delete record;
+        }
+    }
+
+    SaRecordTable(const SaRecordTable&) = delete;
+    SaRecordTable& operator=(const SaRecordTable&) = delete;
+
+    // copies the SA's record out, false when it has none
+    bool Find(int32_t systemAbilityId, Record& record) const
+    {
+        if (systemAbilityId < 0 || systemAbilityId > MAX_ID) {
+            return false;
+        }
+        const Page* page = pages_[GetPageIndex(systemAbilityId)].load(std::memory_order_acquire);
+        if (page == nullptr) {
+            return false;
+        }
+        SaReadEpoch::Guard guard;
+        const Record* current = page->slots[GetSlotIndex(systemAbilityId)].load(std::memory_order_acquire);
+        if (current == nullptr) {
+            return false;
+        }
+        record = *current;
+        return true;
+    }
+
+    // publishes a copy of record for the SA, nullptr removes it
+    void PublishLocked(int32_t systemAbilityId, const Record* record)
+    {
+        if (systemAbilityId < 0 || systemAbilityId > MAX_ID) {
+            return;
+        }
+        auto& pageSlot = pages_[GetPageIndex(systemAbilityId)];
+        Page* page = pageSlot.load(std::memory_order_relaxed);
+        if (page == nullptr) {
+            if (record == nullptr) {
+                return;
+            }
+            page = new Page();
+            pageSlot.store(page, std::memory_order_release);
+        }
+        const Record* published = (record != nullptr) ? new Record(*record) : nullptr;
+        const Record* unlinked = page->slots[GetSlotIndex(systemAbilityId)].exchange(published,
+            std::memory_order_seq_cst);
+        if (unlinked != nullptr) {
+            retired_.emplace_back(SaReadEpoch::GetInstance().Advance(), unlinked);
+        }
+        ReclaimLocked();
+    }
+
+    void ClearLocked()
+    {
+        for (uint32_t pageIndex = 0; pageIndex < PAGE_NUM; ++pageIndex) {
+            Page* page = pages_[pageIndex].load(std::memory_order_relaxed);
+            if (page == nullptr) {
+                continue;
+            }
+            for (uint32_t slotIndex = 0; slotIndex < PAGE_SIZE; ++slotIndex) {
+                if (page->slots[slotIndex].load(std::memory_order_relaxed) != nullptr) {
+                    PublishLocked(static_cast<int32_t>((pageIndex << PAGE_BITS) | slotIndex), nullptr);
+                }
+            }
+        }
+    }
+
+    size_t GetRetiredCountLocked() const
+    {
+        return retired_.size();
+    }
+
+private:
+    struct Page {
+        std::array<std::atomic<const Record*>, PAGE_SIZE> slots {};
+    };
+
+    static uint32_t GetPageIndex(int32_t systemAbilityId)
+    {
+        return static_cast<uint32_t>(systemAbilityId) >> PAGE_BITS;
+    }
+
+    static uint32_t GetSlotIndex(int32_t systemAbilityId)
+    {
+        return static_cast<uint32_t>(systemAbilityId) & (PAGE_SIZE - 1);
+    }
+
+    void ReclaimLocked()
+    {
+        if (retired_.empty()) {
+            return;
+        }
+        uint64_t minEpoch = SaReadEpoch::GetInstance().GetMinActiveEpoch();
+        auto iter = std::remove_if(retired_.begin(), retired_.end(),
+            [minEpoch](const std::pair<uint64_t, const Record*>& item) {
+                if (item.first >= minEpoch) {
+                    return false;
+                }
+                delete item.second;
+                return true;
+            });
+        retired_.erase(iter, retired_.end());
+    }
+
+    std::array<std::atomic<Page*>, PAGE_NUM> pages_ {};
+    std::vector<std::pair<uint64_t, const Record*>> retired_;
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_SA_RECORD_TABLE_H
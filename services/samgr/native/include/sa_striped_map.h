@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_SA_STRIPED_MAP_H
+#define OHOS_SAMGR_SA_STRIPED_MAP_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace OHOS {
+// Map keyed by SA id and split into fixed stripes. The owner guards stripe i with its own lock i, so
+// SAs in different stripes never share a lock. Element access needs the lock of the SA's stripe,
+// whole-map access needs every stripe lock. size() is kept in an atomic and may lag concurrent writers.
+template <typename Value>
+class SaStripedMap {
+public:
+    static constexpr size_t STRIPE_NUM = 32;
+    using Stripe = std::map<int32_t, Value>;
+
+    static size_t GetStripeIndex(int32_t systemAbilityId)
+    {
+        return static_cast<uint32_t>(systemAbilityId) % STRIPE_NUM;
+    }
+
+    Stripe& GetStripe(size_t index)
+    {
+        return stripes_[index];
+    }
+
+    Value& operator[](int32_t systemAbilityId)
+    {
+        auto [iter, inserted] = stripes_[GetStripeIndex(systemAbilityId)].try_emplace(systemAbilityId);
+        if (inserted) {
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return iter->second;
+    }
+
+    bool emplace(int32_t systemAbilityId, Value value)
+    {
+        bool inserted = stripes_[GetStripeIndex(systemAbilityId)].emplace(systemAbilityId, std::move(value)).second;
+        if (inserted) {
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return inserted;
+    }
+
+    // nullptr when the SA has no entry
+    Value* find(int32_t systemAbilityId)
+    {
+        auto& stripe = stripes_[GetStripeIndex(systemAbilityId)];
+        auto iter = stripe.find(systemAbilityId);
+        return (iter == stripe.end()) ? nullptr : &iter->second;
+    }
+
+    size_t count(int32_t systemAbilityId) const
+    {
+        return stripes_[GetStripeIndex(systemAbilityId)].count(systemAbilityId);
+    }
+
+    size_t erase(int32_t systemAbilityId)
+    {
+        size_t erased = stripes_[GetStripeIndex(systemAbilityId)].erase(systemAbilityId);
+        size_.fetch_sub(erased, std::memory_order_relaxed);
+        return erased;
+    }
+
+    typename Stripe::iterator Erase(size_t index, typename Stripe::iterator iter)
+    {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return stripes_[index].erase(iter);
+    }
+
+    void ClearStripe(size_t index)
+    {
+        size_.fetch_sub(stripes_[index].size(), std::memory_order_relaxed);
+        stripes_[index].clear();
+    }
+
+    void clear()
+    {
+        for (size_t index = 0; index < STRIPE_NUM; ++index) {
+            ClearStripe(index);
+        }
+    }
+
+    size_t size() const
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    std::array<Stripe, STRIPE_NUM> stripes_;
+    std::atomic<size_t> size_ {0};
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_SA_STRIPED_MAP_H
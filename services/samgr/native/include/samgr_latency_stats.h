@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_LATENCY_STATS_H
+#define OHOS_SAMGR_LATENCY_STATS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "samgr_ffrt_api.h"
+
+namespace OHOS {
+inline uint64_t GetLatencyNowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Point-in-time copy of a LatencyHistogram. Percentiles are resolved to the upper bound of the bucket
+// they fall in, capped by the largest sample, so they may overstate by up to 2x but never understate.
+struct LatencySnapshot {
+    static constexpr size_t BUCKET_NUM = 24;
+
+    uint64_t count = 0;
+    uint64_t sumUs = 0;
+    uint64_t maxUs = 0;
+    std::array<uint64_t, BUCKET_NUM> buckets {};
+
+    uint64_t GetAvgUs() const
+    {
+        return (count == 0) ? 0 : sumUs / count;
+    }
+
+    uint64_t GetPercentileUs(uint32_t percent) const
+    {
+        uint64_t total = 0;
+        for (uint64_t bucketCount : buckets) {
+            total += bucketCount;
+        }
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t rank = (total * percent + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t index = 0; index < BUCKET_NUM; ++index) {
+            seen += buckets[index];
+            if (seen >= rank && seen > 0) {
+                return std::min<uint64_t>(uint64_t(1) << index, maxUs);
+            }
+        }
+        return maxUs;
+    }
+};
+
+// Log2 histogram of microsecond samples: bucket 0 counts samples under 1us, bucket i counts samples in
+// [2^(i-1), 2^i) and the last bucket everything above. Every field is a relaxed atomic, recording never
+// blocks and a concurrent snapshot may see a sample in count before it shows up in its bucket.
+class LatencyHistogram {
+public:
+    void Record(uint64_t us)
+    {
+        size_t index = 0;
+        while (index + 1 < LatencySnapshot::BUCKET_NUM && (us >> index) != 0) {
+            ++index;
+        }
+        buckets_[index].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sumUs_.fetch_add(us, std::memory_order_relaxed);
+        uint64_t maxUs = maxUs_.load(std::memory_order_relaxed);
+        while (us > maxUs && !maxUs_.compare_exchange_weak(maxUs, us, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencySnapshot GetSnapshot() const
+    {
+        LatencySnapshot snapshot;
+        snapshot.count = count_.load(std::memory_order_relaxed);
+        snapshot.sumUs = sumUs_.load(std::memory_order_relaxed);
+        snapshot.maxUs = maxUs_.load(std::memory_order_relaxed);
+        for (size_t index = 0; index < LatencySnapshot::BUCKET_NUM; ++index) {
+            snapshot.buckets[index] = buckets_[index].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    void Reset()
+    {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sumUs_.store(0, std::memory_order_relaxed);
+        maxUs_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, LatencySnapshot::BUCKET_NUM> buckets_ {};
+    std::atomic<uint64_t> count_ {0};
+    std::atomic<uint64_t> sumUs_ {0};
+    std::atomic<uint64_t> maxUs_ {0};
+};
+
+enum class SamgrLockId : size_t {
+    ABILITY_MAP = 0,
+    LISTENER_MAP,
+    ON_DEMAND,
+    LOCK_NUM,
+};
+
+// Per transaction code service time and lock wait of SystemAbilityManagerStub::OnRemoteRequest, and the
+// wait time of the contended samgr locks, shown by "hidumper -s 10 -a --latency".
+class SamgrLatencyStats {
+public:
+    // transaction codes from here on share the last slot
+    static constexpr uint32_t TRACKED_CODE_NUM = 64;
+    static constexpr size_t LOCK_NUM = static_cast<size_t>(SamgrLockId::LOCK_NUM);
+
+    struct CodeStats {
+        LatencyHistogram service;
+        LatencyHistogram lockWait;
+    };
+
+    static SamgrLatencyStats& GetInstance()
+    {
+        static SamgrLatencyStats instance;
+        return instance;
+    }
+
+    // binder hands samgr no enqueue time, so the time a request spends queued behind other requests on
+    // the samgr locks is what is accounted as its wait; it is summed per thread while the request runs
+    static uint64_t& GetThreadLockWaitUs()
+    {
+        static thread_local uint64_t lockWaitUs = 0;
+        return lockWaitUs;
+    }
+
+    void RecordLockWait(SamgrLockId lockId, uint64_t waitUs)
+    {
+        locks_[static_cast<size_t>(lockId)].Record(waitUs);
+        GetThreadLockWaitUs() += waitUs;
+    }
+
+    void RecordRequest(uint32_t code, uint64_t serviceUs, uint64_t lockWaitUs)
+    {
+        CodeStats& codeStats = codes_[std::min(code, TRACKED_CODE_NUM)];
+        codeStats.service.Record(serviceUs);
+        codeStats.lockWait.Record(lockWaitUs);
+    }
+
+    const CodeStats& GetCodeStats(uint32_t code) const
+    {
+        return codes_[std::min(code, TRACKED_CODE_NUM)];
+    }
+
+    const LatencyHistogram& GetLockStats(SamgrLockId lockId) const
+    {
+        return locks_[static_cast<size_t>(lockId)];
+    }
+
+    void Reset()
+    {
+        for (auto& codeStats : codes_) {
+            codeStats.service.Reset();
+            codeStats.lockWait.Reset();
+        }
+        for (auto& lockStats : locks_) {
+            lockStats.Reset();
+        }
+    }
+
+private:
+    SamgrLatencyStats() = default;
+
+    std::array<CodeStats, TRACKED_CODE_NUM + 1> codes_;
+    std::array<LatencyHistogram, LOCK_NUM> locks_;
+};
+
+// Times one OnRemoteRequest from construction to destruction.
+class SamgrRequestTimer {
+public:
+    explicit SamgrRequestTimer(uint32_t code) : code_(code), beginUs_(GetLatencyNowUs())
+    {
+        SamgrLatencyStats::GetThreadLockWaitUs() = 0;
+    }
+
+    ~SamgrRequestTimer()
+    {
+        SamgrLatencyStats::GetInstance().RecordRequest(code_, GetLatencyNowUs() - beginUs_,
+            SamgrLatencyStats::GetThreadLockWaitUs());
+    }
+
+private:
+    uint32_t code_;
+    uint64_t beginUs_;
+};
+
+// samgr::mutex that records how long lock() waited. The uncontended path is one try_lock and reads no
+// clock, so only a lock that actually blocked pays for the timing.
+template <SamgrLockId LOCK_ID>
+class WaitTrackedMutex {
+public:
+    void lock()
+    {
+        if (mutex_.try_lock()) {
+            return;
+        }
+        uint64_t beginUs = GetLatencyNowUs();
+        mutex_.lock();
+        SamgrLatencyStats::GetInstance().RecordLockWait(LOCK_ID, GetLatencyNowUs() - beginUs);
+    }
+
+    bool try_lock()
+    {
+        return mutex_.try_lock();
+    }
+
+    void unlock()
+    {
+        mutex_.unlock();
+    }
+
+private:
+    samgr::mutex mutex_;
+};
+
+// samgr::shared_mutex counterpart of WaitTrackedMutex, readers and writers are recorded alike.
+template <SamgrLockId LOCK_ID>
+class WaitTrackedSharedMutex {
+public:
+    void lock()
+    {
+        if (mutex_.try_lock()) {
+            return;
+        }
+        uint64_t beginUs = GetLatencyNowUs();
+        mutex_.lock();
+        SamgrLatencyStats::GetInstance().RecordLockWait(LOCK_ID, GetLatencyNowUs() - beginUs);
+    }
+
+    bool try_lock()
+    {
+        return mutex_.try_lock();
+    }
+
+    void unlock()
+    {
+        mutex_.unlock();
+    }
+
+    void lock_shared()
+    {
+        if (mutex_.try_lock_shared()) {
+            return;
+        }
+        uint64_t beginUs = GetLatencyNowUs();
+        mutex_.lock_shared();
+        SamgrLatencyStats::GetInstance().RecordLockWait(LOCK_ID, GetLatencyNowUs() - beginUs);
+    }
+
+    bool try_lock_shared()
+    {
+        return mutex_.try_lock_shared();
+    }
+
+    void unlock_shared()
+    {
+        mutex_.unlock_shared();
+    }
+
+private:
+    samgr::shared_mutex mutex_;
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_LATENCY_STATS_H
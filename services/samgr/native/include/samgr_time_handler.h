@@ -19,21 +19,31 @@
 #include <thread>
 #include <string>
 #include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
 #include <sys/epoll.h>
 #include <signal.h>
 #include <sys/timerfd.h>
 #include <sys/time.h>
 #include <errno.h>
+#include <time.h>
 #include <unistd.h>
-#include <concurrent_map.h>
-#include <atomic>
+#include "samgr_ffrt_api.h"
 namespace OHOS {
+// Runs delayed tasks on an alarm timer that wakes the device. All tasks share one timerfd, armed to the
+// earliest deadline of a min-heap, and one thread that lives as long as the handler.
 class SamgrTimeHandler {
 public:
     typedef std::function<void()> TaskType;
+    static constexpr uint64_t INVALID_TASK_ID = 0;
     ~SamgrTimeHandler();
     static SamgrTimeHandler* GetInstance();
     bool PostTask(TaskType func, uint64_t delayTime);
+    // taskId is set for CancelTask, INVALID_TASK_ID when the post failed
+    bool PostTask(TaskType func, uint64_t delayTime, uint64_t& taskId);
+    // false when the task already ran or was cancelled
+    bool CancelTask(uint64_t taskId);
 
 private:
     SamgrTimeHandler();
@@ -47,13 +57,33 @@ private:
             }
         }
     };
-    void StartThread();
-    void OnTime(SamgrTimeHandler &handle, int number, struct epoll_event events[]);
+    struct Deadline {
+        int64_t time = 0;
+        uint64_t taskId = INVALID_TASK_ID;
+        bool operator>(const Deadline& other) const
+        {
+            return time > other.time;
+        }
+    };
+    bool StartThreadLocked();
+    void Loop();
+    void OnTime(std::vector<TaskType>& dueTasks);
+    void ArmTimerLocked();
+    int64_t GetNowNs() const;
     int CreateAndRetry();
 
 private:
     int epollfd = -1;
-    ConcurrentMap <uint32_t, TaskType> timeFunc;
+    int timerfd_ = -1;
+    clockid_t clockId_ = CLOCK_BOOTTIME;
+    samgr::mutex taskLock_;
+    // cancelled tasks leave their heap entry behind, it is skipped once it reaches the top
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+    std::unordered_map<uint64_t, TaskType> tasks_;
+    uint64_t nextTaskId_ = INVALID_TASK_ID + 1;
+    int64_t armedTime_ = -1;
+    bool stopped_ = false;
+    std::thread loopThread_;
     static SamgrTimeHandler* volatile singleton;
     static Deletor deletor;
 };
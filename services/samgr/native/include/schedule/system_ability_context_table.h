@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SYSTEM_ABILITY_MANAGER_SYSTEM_ABILITY_CONTEXT_TABLE_H
+#define OHOS_SYSTEM_ABILITY_MANAGER_SYSTEM_ABILITY_CONTEXT_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "schedule/system_ability_state_context.h"
+
+namespace OHOS {
+// Flat snapshot of the scheduler contexts, built once the profiles are loaded and never modified after.
+// SA ids are paged into dense slot arrays, so a lookup is two array reads; process names are interned
+// to slots once, so the hot path hashes the name instead of walking a tree of u16string compares.
+class SystemAbilityContextTable {
+public:
+    SystemAbilityContextTable(const std::map<int32_t, std::shared_ptr<SystemAbilityContext>>& abilityContexts,
+        const std::map<std::u16string, std::shared_ptr<SystemProcessContext>>& processContexts)
+    {
+        abilitySlots_.reserve(abilityContexts.size());
+        for (const auto& [saId, abilityContext] : abilityContexts) {
+            if (abilityContext == nullptr || saId < 0) {
+                continue;
+            }
+            uint32_t slot = static_cast<uint32_t>(abilitySlots_.size());
+            abilitySlots_.emplace_back(abilityContext);
+            if (saId >= MAX_PAGED_SA_ID) {
+                // the map iterates in id order, so the sparse ids stay sorted for the binary search
+                sparseSlots_.emplace_back(saId, slot);
+                continue;
+            }
+            size_t pageNum = static_cast<size_t>(saId) >> PAGE_BITS;
+            if (pageNum >= pageIndex_.size()) {
+                pageIndex_.resize(pageNum + 1, INVALID_SLOT);
+            }
+            if (pageIndex_[pageNum] == INVALID_SLOT) {
+                pageIndex_[pageNum] = static_cast<uint32_t>(pages_.size());
+                pages_.emplace_back();
+                pages_.back().fill(INVALID_SLOT);
+            }
+            pages_[pageIndex_[pageNum]][static_cast<size_t>(saId) & PAGE_MASK] = slot;
+        }
+        processSlots_.reserve(processContexts.size());
+        processIndex_.reserve(processContexts.size());
+        for (const auto& [processName, processContext] : processContexts) {
+            if (processContext == nullptr) {
+                continue;
+            }
+            processIndex_.emplace(processName, static_cast<uint32_t>(processSlots_.size()));
+            processSlots_.emplace_back(processContext);
+        }
+    }
+
+    // nullptr when the SA has no context; the slot lives as long as the table
+    const std::shared_ptr<SystemAbilityContext>* FindAbility(int32_t saId) const
+    {
+        uint32_t slot = INVALID_SLOT;
+        if (saId >= 0 && saId < MAX_PAGED_SA_ID) {
+            size_t pageNum = static_cast<size_t>(saId) >> PAGE_BITS;
+            if (pageNum < pageIndex_.size() && pageIndex_[pageNum] != INVALID_SLOT) {
+                slot = pages_[pageIndex_[pageNum]][static_cast<size_t>(saId) & PAGE_MASK];
+            }
+        } else {
+            auto iter = std::lower_bound(sparseSlots_.begin(), sparseSlots_.end(), std::make_pair(saId, 0u));
+            if (iter != sparseSlots_.end() && iter->first == saId) {
+                slot = iter->second;
+            }
+        }
+        return (slot == INVALID_SLOT) ? nullptr : &abilitySlots_[slot];
+    }
+
+    const std::shared_ptr<SystemProcessContext>* FindProcess(const std::u16string& processName) const
+    {
+        auto iter = processIndex_.find(processName);
+        return (iter == processIndex_.end()) ? nullptr : &processSlots_[iter->second];
+    }
+
+    size_t GetAbilityCount() const
+    {
+        return abilitySlots_.size();
+    }
+
+    size_t GetProcessCount() const
+    {
+        return processSlots_.size();
+    }
+
+private:
+    static constexpr uint32_t PAGE_BITS = 8;
+    static constexpr uint32_t PAGE_MASK = (1u << PAGE_BITS) - 1;
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+    // real SA ids are clustered well below this, larger ones fall back to a sorted array
+    static constexpr int32_t MAX_PAGED_SA_ID = 1 << 20;
+
+    std::vector<std::shared_ptr<SystemAbilityContext>> abilitySlots_;
+    std::vector<uint32_t> pageIndex_;
+    std::vector<std::array<uint32_t, 1u << PAGE_BITS>> pages_;
+    std::vector<std::pair<int32_t, uint32_t>> sparseSlots_;
+    std::vector<std::shared_ptr<SystemProcessContext>> processSlots_;
+    std::unordered_map<std::u16string, uint32_t> processIndex_;
+};
+} // namespace OHOS
+#endif // OHOS_SYSTEM_ABILITY_MANAGER_SYSTEM_ABILITY_CONTEXT_TABLE_H
@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 
+#include "process_name_table.h"
 #include "samgr_ffrt_api.h"
 #include "refbase.h"
 #include "sa_profiles.h"
@@ -76,6 +77,17 @@ struct SystemProcessContext {
     SystemProcessState state = SystemProcessState::NOT_STARTED;
     bool enableRestart = true;
     int64_t lastStopTime = -1;
+    ProcessNameId processNameId = INVALID_PROCESS_NAME_ID;
+
+    // cached utf-8 form of processName, contexts not built from the profiles are interned on first use
+    const std::string& GetProcessNameStr8() const
+    {
+        auto& processNames = ProcessNameTable::GetInstance();
+        if (processNameId != INVALID_PROCESS_NAME_ID) {
+            return processNames.GetStr8(processNameId);
+        }
+        return processNames.GetStr8(processName);
+    }
 };
 
 struct SystemAbilityContext {
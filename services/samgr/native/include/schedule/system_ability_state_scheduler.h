@@ -16,15 +16,19 @@
 #ifndef OHOS_SYSTEM_ABILITY_MANAGER_SYSTEM_ABILITY_STATE_SCHEDULER_H
 #define OHOS_SYSTEM_ABILITY_MANAGER_SYSTEM_ABILITY_STATE_SCHEDULER_H
 
+#include <atomic>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "ffrt_handler.h"
 #include "isystem_process_status_change.h"
 #include "if_system_ability_manager.h"
 #include "nlohmann/json.hpp"
 #include "sa_profiles.h"
+#include "schedule/system_ability_context_table.h"
 #include "schedule/system_ability_event_handler.h"
 
 namespace OHOS {
@@ -32,6 +36,17 @@ constexpr int32_t UNLOAD_DELAY_TIME = 20 * 1000;
 
 class BaseSystemAbilityManager;
 
+// what the dump shows of one SA, copied out under the locks and formatted after they are released
+struct SystemAbilityDumpInfo {
+    int32_t systemAbilityId = -1;
+    SystemAbilityState state = SystemAbilityState::NOT_LOADED;
+    PendingEvent pendingEvent = PendingEvent::NO_EVENT;
+    // interned name owned by ProcessNameTable, nullptr when the SA has no process context
+    const std::string* processName = nullptr;
+    int32_t pid = -1;
+    int32_t uid = -1;
+};
+
 class SystemAbilityStateScheduler : public SystemAbilityStateListener,
     public std::enable_shared_from_this<SystemAbilityStateScheduler> {
 public:
@@ -65,6 +80,9 @@ public:
     void GetSystemAbilityInfo(int32_t said, std::string& result);
     void GetProcessInfo(const std::string& processName, std::string& result);
     void GetAllSystemAbilityInfoByState(const std::string& state, std::string& result);
+    void GetAllSystemAbilityDumpInfo(std::vector<SystemAbilityDumpInfo>& dumpInfos);
+    static bool IsSystemAbilityInState(const SystemAbilityDumpInfo& dumpInfo, const std::string& state);
+    static void FormatSystemAbilityDumpInfo(const SystemAbilityDumpInfo& dumpInfo, std::string& result);
     int32_t SubscribeSystemProcess(const sptr<ISystemProcessStatusChange>& listener);
     int32_t UnSubscribeSystemProcess(const sptr<ISystemProcessStatusChange>& listener);
     int32_t SubscribeLowMemSystemProcess(const sptr<ISystemProcessStatusChange>& listener);
@@ -86,6 +104,7 @@ public:
 private:
     void InitStateContext(const std::list<SaProfile>& saProfiles);
     void InitLowMemProcessList(const std::list<SaProfile>& saProfiles);
+    void SealContextTable();
 
     int32_t LimitDelayUnloadTime(int32_t delayUnloadTime);
     bool GetSystemAbilityContext(int32_t systemAbilityId,
@@ -134,6 +153,9 @@ private:
     bool CanKillSystemProcess(const std::shared_ptr<SystemProcessContext>& processContext);
     bool CanKillSystemProcessLocked(const std::shared_ptr<SystemProcessContext>& processContext);
     int32_t KillSystemProcessLocked(const std::shared_ptr<SystemProcessContext>& processContext);
+    static int32_t StopSystemProcess(const std::u16string& processName);
+    static void OnSystemProcessStopped(const std::u16string& processName, int32_t pid, int32_t uid,
+        int32_t result, int64_t duration);
 
     bool CanRestartProcessLocked(const std::shared_ptr<SystemProcessContext>& processContext);
     int32_t GetAbnormallyDiedAbilityLocked(std::shared_ptr<SystemProcessContext>& processContext,
@@ -183,6 +205,9 @@ private:
     samgr::shared_mutex processMapLock_;
     std::map<int32_t, std::shared_ptr<SystemAbilityContext>> abilityContextMap_;
     std::map<std::u16string, std::shared_ptr<SystemProcessContext>> processContextMap_;
+    // published once init is done, lookups then skip the map locks; retired tables live as long as the scheduler
+    std::atomic<const SystemAbilityContextTable*> contextTable_ {nullptr};
+    std::list<std::unique_ptr<const SystemAbilityContextTable>> contextTables_;
     std::shared_ptr<UnloadEventHandler> unloadEventHandler_;
     std::shared_ptr<FFRTHandler> processHandler_;
     samgr::mutex procListenerMapLock_;
@@ -71,6 +71,9 @@ public:
 
     sptr<IRemoteObject> CheckSystemAbility(int32_t systemAbilityId, bool& isExist) override;
 
+    int32_t GetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+        std::vector<sptr<IRemoteObject>>& saList, std::vector<int32_t>& errCodes) override;
+
     int32_t AddSystemAbility(int32_t systemAbilityId, const sptr<IRemoteObject>& ability,
         const SAExtraProp& extraProp) override;
     void StartDfxTimer();
@@ -16,6 +16,7 @@
 #ifndef SERVICES_SAMGR_NATIVE_INCLUDE_SYSTEM_ABILITY_MANAGER_DUMPER_H
 #define SERVICES_SAMGR_NATIVE_INCLUDE_SYSTEM_ABILITY_MANAGER_DUMPER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,27 @@ enum {
 };
 constexpr int32_t IPC_STAT_CMD_LEN = 3;
 
+// the fields of one SAListener the listener dump prints, copied out under listenerMapLock_
+struct SAListenerDumpInfo {
+    int32_t systemAbilityId = -1;
+    int32_t callingPid = -1;
+    // identifies the listener object to count distinct listeners, never dereferenced
+    uintptr_t listenerKey = 0;
+};
+
+// bounded buffer in front of the dump fd, written out each time it fills up
+class DumpFdWriter {
+public:
+    explicit DumpFdWriter(int32_t fd);
+    void Append(const std::string& content);
+    bool Flush();
+
+private:
+    int32_t fd_ = -1;
+    bool isOk_ = true;
+    std::string buffer_;
+};
+
 class SystemAbilityManagerDumper {
 public:
     static bool Dump(std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler,
@@ -59,8 +81,14 @@ public:
         std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler, int32_t processId);
     static bool GetFfrtDumpInfoProc(std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler,
         const std::vector<std::string>& args, std::string& result);
-    static int32_t ListenerDumpProc(std::map<int32_t, std::list<SAListener>>& listeners,
+    static bool IsStreamDump(const std::vector<std::string>& args);
+    static int32_t StreamDumpProc(std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler,
         int32_t fd, const std::vector<std::string>& args);
+    static void GetListenerDumpInfo(const std::map<int32_t, std::list<SAListener>>& listeners,
+        std::vector<SAListenerDumpInfo>& dumpInfos);
+    static int32_t ListenerDumpProc(const std::vector<SAListenerDumpInfo>& dumpInfos,
+        int32_t fd, const std::vector<std::string>& args,
+        const std::shared_ptr<SaListenerNotifier>& listenerNotifier = nullptr);
 
 private:
     SystemAbilityManagerDumper() = default;
@@ -74,6 +102,7 @@ private:
     static void ClearFfrtStatistics();
     static bool CanDump();
     static void ShowHelp(std::string& result);
+    static void ShowLatencyStats(std::string& result);
     static void ShowAllSystemAbilityInfo(std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler,
         std::string& result);
     static void ShowSystemAbilityInfo(int32_t said,
@@ -90,15 +119,15 @@ private:
         std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler, int32_t pid, std::string& result);
     static int32_t SaveDumpResultToFd(int32_t fd, const std::string& result);
     static void GetSAMgrFfrtInfo(std::string& result);
-    static void GetListenerDumpProc(std::map<int32_t, std::list<SAListener>>& listeners,
-        const std::vector<std::string>& args, std::string& result);
-    static void ShowAllBySA(std::map<int32_t, std::list<SAListener>>& listeners, std::string& result);
-    static void ShowAllByCallingPid(std::map<int32_t, std::list<SAListener>>& listeners,
-        std::string& result);
-    static void ShowCallingPidBySA(std::map<int32_t, std::list<SAListener>>& listeners,
-        int32_t said, std::string& result);
-    static void ShowSAByCallingPid(std::map<int32_t, std::list<SAListener>>& listeners,
-        int32_t pid, std::string& result);
+    static void GetListenerDumpProc(const std::vector<SAListenerDumpInfo>& dumpInfos,
+        const std::vector<std::string>& args, DumpFdWriter& writer,
+        const std::shared_ptr<SaListenerNotifier>& listenerNotifier = nullptr);
+    static void ShowAllBySA(const std::vector<SAListenerDumpInfo>& dumpInfos, DumpFdWriter& writer);
+    static void ShowAllByCallingPid(const std::vector<SAListenerDumpInfo>& dumpInfos, DumpFdWriter& writer);
+    static void ShowCallingPidBySA(const std::vector<SAListenerDumpInfo>& dumpInfos,
+        int32_t said, DumpFdWriter& writer);
+    static void ShowSAByCallingPid(const std::vector<SAListenerDumpInfo>& dumpInfos,
+        int32_t pid, DumpFdWriter& writer);
     static void ShowListenerHelp(std::string& result);
     static std::shared_ptr<FFRTHandler> handler_;
     static char* ffrtMetricBuffer;
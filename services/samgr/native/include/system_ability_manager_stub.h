@@ -16,6 +16,7 @@
 #ifndef SERVICES_SAMGR_NATIVE_INCLUDE_SYSTEM_ABILITY_MANAGER_STUB_H
 #define SERVICES_SAMGR_NATIVE_INCLUDE_SYSTEM_ABILITY_MANAGER_STUB_H
 
+#include <array>
 #include <map>
 #include <set>
 #include "if_system_ability_manager.h"
@@ -86,6 +87,11 @@ private:
     {
         return stub->CheckSystemAbilityInner(data, reply);
     }
+    static int32_t LocalGetSystemAbilities(SystemAbilityManagerStub* stub,
+        MessageParcel& data, MessageParcel& reply)
+    {
+        return stub->GetSystemAbilitiesInner(data, reply);
+    }
     static int32_t LocalAddSystemProcess(SystemAbilityManagerStub* stub,
         MessageParcel& data, MessageParcel& reply)
     {
@@ -237,6 +243,8 @@ private:
     int32_t AddSystemAbilityInner(MessageParcel& data, MessageParcel& reply);
     int32_t GetSystemAbilityInner(MessageParcel& data, MessageParcel& reply);
     int32_t CheckSystemAbilityInner(MessageParcel& data, MessageParcel& reply);
+    int32_t GetSystemAbilitiesInner(MessageParcel& data, MessageParcel& reply);
+    int32_t CheckGetSystemAbilities(const std::vector<int32_t>& systemAbilityIds, std::vector<int32_t>& errCodes);
     int32_t AddSystemProcessInner(MessageParcel& data, MessageParcel& reply);
     int32_t RemoveSystemAbilityInner(MessageParcel& data, MessageParcel& reply);
     int32_t GetSystemProcessInfoInner(MessageParcel& data, MessageParcel& reply);
@@ -276,12 +284,16 @@ private:
     void SetPengLai(bool isPengLai);
     bool isPengLai_ = false;
 #endif
-    void SetAbilityFuncMap();
-    void SetProcessFuncMap();
 
     using SystemAbilityManagerStubFunc =
         int32_t (*)(SystemAbilityManagerStub* stub, MessageParcel& data, MessageParcel& reply);
-    std::map<uint32_t, SystemAbilityManagerStubFunc> memberFuncMap_;
+    // transaction codes are small and dense, indexed directly by code
+    static constexpr uint32_t FUNC_TABLE_SIZE = 64;
+    using FuncTable = std::array<SystemAbilityManagerStubFunc, FUNC_TABLE_SIZE>;
+    static constexpr void SetAbilityFuncTable(FuncTable& table);
+    static constexpr void SetProcessFuncTable(FuncTable& table);
+    static constexpr FuncTable BuildFuncTable();
+    static const FuncTable memberFuncTable_;
 };
 } // namespace OHOS
 
@@ -57,6 +57,7 @@ public:
     static void SetModuleUpdateParam(const std::string& key, const std::string& value);
     static void SendUpdateSaState(int32_t systemAbilityId, const std::string& updateSaState);
     static void InvalidateSACache();
+    static void InvalidateSACache(int32_t systemAbilityId);
     static void FilterCommonSaProfile(const SaProfile& oldProfile, CommonSaProfile& newProfile);
     static bool CheckPengLai();
     static bool CheckSystemProcessStarted(const std::u16string& procName);
@@ -72,6 +73,10 @@ public:
     static void DeviceIdToNetworkId(std::string& networkId);
 #endif
     static std::string GetProcessNameFromCmdline(int32_t pid);
+    // 0 when the pid is gone, compared against a cached entry to detect pid reuse
+    static uint64_t GetProcessStartTime(int32_t pid);
+    static std::string GetCachedProcessName(int32_t pid);
+    static void RemoveCachedProcessName(int32_t pid);
     static int ParsePeerBinderPid(std::ifstream& fin, int32_t pid, int32_t tid);
     static bool KillProcessByPid(int32_t pid, int32_t tid);
 private:
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SAMGR_SYSTEM_PROCESS_EXECUTOR_H
+#define OHOS_SAMGR_SYSTEM_PROCESS_EXECUTOR_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "ffrt_handler.h"
+#include "samgr_ffrt_api.h"
+
+namespace OHOS {
+// Runs init start/stop requests of system processes away from binder threads and scheduler locks.
+// Requests of one process run one at a time in submit order, so a start never overtakes an earlier stop;
+// requests of different processes run concurrently. The requests block on init, so they run on a few serial
+// queues of their own instead of the shared ffrt workers; a process always lands on the same queue.
+// The completion gets the request result and its cost.
+class SystemProcessExecutor : public std::enable_shared_from_this<SystemProcessExecutor> {
+public:
+    SystemProcessExecutor();
+
+    using ProcessRequest = std::function<int32_t()>;
+    using ProcessCompletion = std::function<void(int32_t result, int64_t durationMs)>;
+
+    void Submit(const std::u16string& processName, ProcessRequest request, ProcessCompletion completion);
+    size_t GetPendingCount();
+
+private:
+    struct PendingRequest {
+        ProcessRequest request;
+        ProcessCompletion completion;
+    };
+
+    struct ProcessQueue {
+        std::list<PendingRequest> requests;
+        bool running = false;
+    };
+
+    void Drain(const std::u16string& processName);
+    std::shared_ptr<FFRTHandler>& GetHandler(const std::u16string& processName);
+
+    static constexpr size_t HANDLER_NUM = 4;
+    std::array<std::shared_ptr<FFRTHandler>, HANDLER_NUM> handlers_;
+    samgr::mutex queueLock_;
+    std::map<std::u16string, ProcessQueue> queues_;
+};
+} // namespace OHOS
+#endif // OHOS_SAMGR_SYSTEM_PROCESS_EXECUTOR_H
@@ -32,6 +32,8 @@
 #include "ipc_skeleton.h"
 #include "local_ability_manager_proxy.h"
 #include "parse_util.h"
+#include "process_name_table.h"
+#include "sa_profile_cache.h"
 #include "parameter.h"
 #include "parameters.h"
 #include "sam_log.h"
@@ -104,6 +106,8 @@ namespace OHOS {
 namespace {
 constexpr const char* PREFIX = "profile";
 constexpr const char* SYSTEM_PREFIX = "/system/profile";
+constexpr const char* SA_PROFILE_CACHE_PATH = "/data/samgr/sa_profile.cache";
+constexpr size_t MAX_PROFILE_PARSE_WORKERS = 8;
 constexpr const char* LOCAL_DEVICE = "local";
 constexpr const char* RESOURCE_SCHEDULE_PROCESS_NAME = "resource_schedule_service";
 constexpr const char* BOOT_INIT_TIME_PARAM = "ohos.boot.time.init";
@@ -131,13 +135,14 @@ BaseSystemAbilityManager::~BaseSystemAbilityManager()
 
 void BaseSystemAbilityManager::RemoveAbilityDeathRecipients()
 {
-    unique_lock<samgr::shared_mutex> writeLock(abilityMapLock_);
+    unique_lock<AbilityMapLock> writeLock(abilityMapLock_);
     for (auto& [saId, saInfo] : abilityMap_) {
         if (saInfo.remoteObj != nullptr && abilityDeath_ != nullptr) {
             saInfo.remoteObj->RemoveDeathRecipient(abilityDeath_);
         }
     }
     abilityMap_.clear();
+    abilityTable_.ClearLocked();
 }
 
 void BaseSystemAbilityManager::RemoveProcessDeathRecipients()
@@ -153,7 +158,7 @@ void BaseSystemAbilityManager::RemoveProcessDeathRecipients()
 
 void BaseSystemAbilityManager::RemoveListenerDeathRecipients()
 {
-    lock_guard<samgr::mutex> autoLock(listenerMapLock_);
+    lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
     for (auto& [saId, listeners] : listenerMap_) {
         for (auto& item : listeners) {
             if (item.listener != nullptr && abilityStatusDeath_ != nullptr) {
@@ -162,23 +167,35 @@ void BaseSystemAbilityManager::RemoveListenerDeathRecipients()
         }
     }
     listenerMap_.clear();
+    listenerIndex_.clear();
     subscribeCountMap_.clear();
 }
 
 void BaseSystemAbilityManager::RemoveOnDemandDeathRecipients()
 {
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
-    for (auto& [saId, abilityItem] : startingAbilityMap_) {
-        for (auto& [deviceId, callbacks] : abilityItem.callbackMap) {
-            RemoveCallbackDeathRecipients(callbacks, abilityCallbackDeath_);
+    for (size_t index = 0; index < onDemandLocks_.size(); ++index) {
+        lock_guard<OnDemandLock> autoLock(onDemandLocks_[index]);
+        for (auto& [saId, abilityItem] : startingAbilityMap_.GetStripe(index)) {
+            for (auto& [deviceId, callbacks] : abilityItem.callbackMap) {
+                RemoveCallbackDeathRecipients(callbacks, abilityCallbackDeath_);
+            }
         }
+        startingAbilityMap_.ClearStripe(index);
+        onDemandAbilityMap_.ClearStripe(index);
+    }
+    {
+        lock_guard<samgr::mutex> autoLock(startingProcessMapLock_);
+        startingProcessMap_.clear();
     }
-    startingAbilityMap_.clear();
-    onDemandAbilityMap_.clear();
-    startingProcessMap_.clear();
+    lock_guard<samgr::mutex> autoLock(callbackCountLock_);
     callbackCountMap_.clear();
 }
 
+BaseSystemAbilityManager::OnDemandLock& BaseSystemAbilityManager::GetOnDemandLock(int32_t systemAbilityId)
+{
+    return onDemandLocks_[SaStripedMap<AbilityItem>::GetStripeIndex(systemAbilityId)];
+}
+
 void BaseSystemAbilityManager::RemoveCallbackDeathRecipients(
     CallbackList& callbackList, const sptr<IRemoteObject::DeathRecipient>& deathRecipient)
 {
@@ -262,7 +279,7 @@ void BaseSystemAbilityManager::InitSaProfile()
     int64_t begin = GetTickCount();
     std::vector<std::string> fileNames;
     SamgrUtil::GetFilesByPriority(PREFIX, fileNames);
-    auto parser = std::make_shared<ParseUtil>();
+    std::vector<std::string> profileFiles;
     for (const auto& file : fileNames) {
         if (fs::path(file).parent_path().string() != SYSTEM_PREFIX) {
             HILOGI("InitSaProfile file : %{public}s!", file.c_str());
@@ -271,9 +288,18 @@ void BaseSystemAbilityManager::InitSaProfile()
             file.find("_trust.json") != std::string::npos) {
             continue;
         }
-        parser->ParseSaProfiles(file);
+        profileFiles.emplace_back(file);
+    }
+    // one profile set shared by every consumer and the cache writer, never modified after parsing
+    auto saInfosPtr = std::make_shared<std::list<SaProfile>>();
+    std::set<int32_t> multiInstanceSaIds;
+    uint64_t fingerprint = SaProfileCache::GetFingerprint(profileFiles);
+    bool fromCache = SaProfileCache::Load(SA_PROFILE_CACHE_PATH, fingerprint, *saInfosPtr, multiInstanceSaIds);
+    if (!fromCache) {
+        ParseSaProfiles(profileFiles, *saInfosPtr, multiInstanceSaIds);
+        SaveSaProfileCache(fingerprint, saInfosPtr, multiInstanceSaIds);
     }
-    std::list<SaProfile> saInfos = parser->GetAllSaProfiles();
+    const std::list<SaProfile>& saInfos = *saInfosPtr;
     if (abilityStateScheduler_ != nullptr) {
         abilityStateScheduler_->Init(saInfos);
     }
@@ -284,7 +310,9 @@ void BaseSystemAbilityManager::InitSaProfile()
     onDemandSaIdsSet_.insert(DEVICE_INFO_SERVICE_SA);
     onDemandSaIdsSet_.insert(HIDUMPER_SERVICE_SA);
     onDemandSaIdsSet_.insert(MEDIA_ANALYSIS_SERVICE_SA);
+    auto& processNames = ProcessNameTable::GetInstance();
     for (const auto& saInfo : saInfos) {
+        processNames.Intern(saInfo.process);
         SamgrUtil::FilterCommonSaProfile(saInfo, saProfileMap_[saInfo.saId]);
         if (!saInfo.runOnCreate) {
             HILOGD("InitProfile saId %{public}d", saInfo.saId);
@@ -294,10 +322,29 @@ void BaseSystemAbilityManager::InitSaProfile()
 #ifdef SUPPORT_MULTI_INSTANCE
     {
         lock_guard<samgr::mutex> autoLock(multiInstanceSaIdsLock_);
-        multiInstanceSaIds_ = parser->GetMultiInstanceSaIds();
+        multiInstanceSaIds_ = multiInstanceSaIds;
     }
 #endif
-    KHILOGI("InitProfile spend %{public}" PRId64 "ms", GetTickCount() - begin);
+    KHILOGI("InitProfile spend %{public}" PRId64 "ms, cache:%{public}d", GetTickCount() - begin, fromCache);
+}
+
+void BaseSystemAbilityManager::ParseSaProfiles(const std::vector<std::string>& profileFiles,
+    std::list<SaProfile>& saInfos, std::set<int32_t>& multiInstanceSaIds)
+{
+    size_t workerNum = std::min<size_t>(std::thread::hardware_concurrency(), MAX_PROFILE_PARSE_WORKERS);
+    ParseUtil::ParseSaProfilesConcurrently(profileFiles, workerNum, saInfos, multiInstanceSaIds);
+}
+
+void BaseSystemAbilityManager::SaveSaProfileCache(uint64_t fingerprint,
+    const std::shared_ptr<const std::list<SaProfile>>& saInfos, const std::set<int32_t>& multiInstanceSaIds)
+{
+    // only reached when the profiles changed, keep the write off the boot path
+    auto saveTask = [fingerprint, saInfos, multiInstanceSaIds]() {
+        SaProfileCache::Save(SA_PROFILE_CACHE_PATH, fingerprint, *saInfos, multiInstanceSaIds);
+    };
+    if (workHandler_ == nullptr || !workHandler_->PostTask(saveTask)) {
+        HILOGW("SaveSaProfileCache PostTask fail");
+    }
 }
 
 #ifdef SUPPORT_MULTI_INSTANCE
@@ -410,17 +457,54 @@ sptr<IRemoteObject> BaseSystemAbilityManager::CheckSystemAbility(int32_t systemA
         HILOGW("CheckSystemAbility CheckSystemAbility invalid!");
         return nullptr;
     }
-    int32_t count = UpdateSaFreMap(IPCSkeleton::GetCallingUid(), systemAbilityId);
-    shared_lock<samgr::shared_mutex> readLock(abilityMapLock_);
-    auto iter = abilityMap_.find(systemAbilityId);
-    if (iter != abilityMap_.end()) {
+    int32_t callingUid = IPCSkeleton::GetCallingUid();
+    UpdateSaFreMap(callingUid, systemAbilityId);
+    SAInfo saInfo;
+    if (FindAbility(systemAbilityId, saInfo)) {
         HILOGD("found SA:%{public}d,callpid:%{public}d", systemAbilityId, IPCSkeleton::GetCallingPid());
-        return iter->second.remoteObj;
+        return saInfo.remoteObj;
     }
-    HILOGI("NF SA:%{public}d,%{public}d_%{public}d", systemAbilityId, IPCSkeleton::GetCallingPid(), count);
+    HILOGI("NF SA:%{public}d,%{public}d_%{public}d", systemAbilityId, IPCSkeleton::GetCallingPid(),
+        GetSaFreCount(callingUid, systemAbilityId));
     return nullptr;
 }
 
+sptr<IRemoteObject> BaseSystemAbilityManager::PeekSystemAbility(int32_t systemAbilityId)
+{
+    SAInfo saInfo;
+    return FindAbility(systemAbilityId, saInfo) ? saInfo.remoteObj : nullptr;
+}
+
+int32_t BaseSystemAbilityManager::GetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+    std::vector<sptr<IRemoteObject>>& saList, std::vector<int32_t>& errCodes)
+{
+    HILOGD("%{public}s called, size:%{public}zu", __func__, systemAbilityIds.size());
+    saList.clear();
+    errCodes.clear();
+    saList.reserve(systemAbilityIds.size());
+    errCodes.reserve(systemAbilityIds.size());
+    int32_t callingUid = IPCSkeleton::GetCallingUid();
+    for (auto systemAbilityId : systemAbilityIds) {
+        if (!CheckInputSysAbilityId(systemAbilityId)) {
+            saList.emplace_back(nullptr);
+            errCodes.emplace_back(ERR_INVALID_VALUE);
+            continue;
+        }
+        UpdateSaFreMap(callingUid, systemAbilityId);
+        SAInfo saInfo;
+        if (!FindAbility(systemAbilityId, saInfo)) {
+            HILOGI("NF SA:%{public}d,%{public}d_%{public}d", systemAbilityId, IPCSkeleton::GetCallingPid(),
+                GetSaFreCount(callingUid, systemAbilityId));
+            saList.emplace_back(nullptr);
+            errCodes.emplace_back(ERR_NULL_OBJECT);
+            continue;
+        }
+        saList.emplace_back(std::move(saInfo.remoteObj));
+        errCodes.emplace_back(ERR_OK);
+    }
+    return ERR_OK;
+}
+
 int32_t BaseSystemAbilityManager::FindSystemAbilityNotify(int32_t systemAbilityId, int32_t code)
 {
     return FindSystemAbilityNotify(systemAbilityId, "", code);
@@ -429,50 +513,40 @@ int32_t BaseSystemAbilityManager::FindSystemAbilityNotify(int32_t systemAbilityI
 void BaseSystemAbilityManager::NotifySystemAbilityChanged(int32_t systemAbilityId, const std::string& deviceId,
     int32_t code, const sptr<ISystemAbilityStatusChange>& listener)
 {
-    HILOGD("NotifySystemAbilityChanged, SA:%{public}d", systemAbilityId);
-    if (listener == nullptr) {
-        HILOGE("%{public}s listener null pointer!", __func__);
-        return;
-    }
-
-    switch (code) {
-        case static_cast<uint32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION): {
-            listener->OnAddSystemAbility(systemAbilityId, deviceId);
-            break;
-        }
-        case static_cast<uint32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION): {
-            listener->OnRemoveSystemAbility(systemAbilityId, deviceId);
-            break;
-        }
-        default:
-            break;
-    }
+    SaListenerNotifier::Deliver(systemAbilityId, deviceId, code, listener);
 }
 
 int32_t BaseSystemAbilityManager::FindSystemAbilityNotify(int32_t systemAbilityId, const std::string& deviceId,
     int32_t code)
 {
-    lock_guard<samgr::mutex> autoLock(listenerMapLock_);
-    HILOGI("FindSaNotify SA:%{public}d,%{public}d_%{public}zu", systemAbilityId, code, listenerMap_.size());
-    auto iter = listenerMap_.find(systemAbilityId);
-    if (iter == listenerMap_.end()) {
-        return ERR_OK;
-    }
-    auto& listeners = iter->second;
-    if (code == static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION)) {
-        for (auto& item : listeners) {
-            if (item.state == ListenerState::INIT) {
-                NotifySystemAbilityChanged(systemAbilityId, deviceId, code, item.listener);
-                item.state = ListenerState::NOTIFIED;
-            } else {
-                HILOGI("FindSaNotify Listener has been notified,SA:%{public}d,callingPid:%{public}d",
-                    systemAbilityId, item.callingPid);
+    std::vector<ListenerNotifyTarget> targets;
+    {
+        lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
+        HILOGI("FindSaNotify SA:%{public}d,%{public}d_%{public}zu", systemAbilityId, code, listenerMap_.size());
+        auto iter = listenerMap_.find(systemAbilityId);
+        if (iter == listenerMap_.end()) {
+            return ERR_OK;
+        }
+        auto& listeners = iter->second;
+        if (code == static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION)) {
+            for (auto& item : listeners) {
+                if (item.state == ListenerState::INIT) {
+                    targets.push_back({item.listener, item.callingPid});
+                    item.state = ListenerState::NOTIFIED;
+                } else {
+                    HILOGI("FindSaNotify Listener has been notified,SA:%{public}d,callingPid:%{public}d",
+                        systemAbilityId, item.callingPid);
+                }
+            }
+        } else if (code == static_cast<int32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION)) {
+            for (auto& item : listeners) {
+                targets.push_back({item.listener, item.callingPid});
+                item.state = ListenerState::INIT;
             }
         }
-    } else if (code == static_cast<int32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION)) {
-        for (auto& item : listeners) {
-            NotifySystemAbilityChanged(systemAbilityId, deviceId, code, item.listener);
-            item.state = ListenerState::INIT;
+        // enqueued under listenerMapLock_, so each listener's queue follows the order of its state changes
+        if (!targets.empty()) {
+            listenerNotifier_->Notify(systemAbilityId, deviceId, code, targets);
         }
     }
     return ERR_OK;
@@ -480,12 +554,11 @@ int32_t BaseSystemAbilityManager::FindSystemAbilityNotify(int32_t systemAbilityI
 
 void BaseSystemAbilityManager::StartOnDemandAbilityLocked(const std::u16string& procName, int32_t systemAbilityId)
 {
-    auto iter = startingAbilityMap_.find(systemAbilityId);
-    if (iter == startingAbilityMap_.end()) {
+    AbilityItem* abilityItem = startingAbilityMap_.find(systemAbilityId);
+    if (abilityItem == nullptr) {
         return;
     }
-    auto& abilityItem = iter->second;
-    StartOnDemandAbilityInner(procName, systemAbilityId, abilityItem);
+    StartOnDemandAbilityInner(procName, systemAbilityId, *abilityItem);
 }
 
 int32_t BaseSystemAbilityManager::StartOnDemandAbilityInner(const std::u16string& procName, int32_t systemAbilityId,
@@ -533,7 +606,7 @@ int32_t BaseSystemAbilityManager::AddOnDemandSystemAbilityInfo(int32_t systemAbi
         return ERR_INVALID_VALUE;
     }
 
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
+    lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
     auto onDemandSaSize = onDemandAbilityMap_.size();
     if (onDemandSaSize >= MAX_SERVICES) {
         HILOGE("map size error, (Has been greater than %{public}zu)",
@@ -566,25 +639,26 @@ int32_t BaseSystemAbilityManager::AddOnDemandSystemAbilityInfo(int32_t systemAbi
 
 void BaseSystemAbilityManager::RemoveOnDemandSaInDiedProc(std::shared_ptr<SystemProcessContext>& processContext)
 {
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
+    SamgrUtil::RemoveCachedProcessName(processContext->pid);
     for (auto& saId : processContext->saList) {
+        lock_guard<OnDemandLock> autoLock(GetOnDemandLock(saId));
         onDemandAbilityMap_.erase(saId);
     }
-    HILOGI("remove onDemandSA. proc:%{public}s, size:%{public}zu", Str16ToStr8(processContext->processName).c_str(),
+    HILOGI("remove onDemandSA. proc:%{public}s, size:%{public}zu", processContext->GetProcessNameStr8().c_str(),
         onDemandAbilityMap_.size());
 }
 
 int32_t BaseSystemAbilityManager::StartOnDemandAbilityLocked(int32_t systemAbilityId, bool& isExist)
 {
-    auto iter = onDemandAbilityMap_.find(systemAbilityId);
-    if (iter == onDemandAbilityMap_.end()) {
+    std::u16string* procName = onDemandAbilityMap_.find(systemAbilityId);
+    if (procName == nullptr) {
         isExist = false;
         HILOGI("NF onDemand SA:%{public}d", systemAbilityId);
         return ERR_INVALID_VALUE;
     }
     isExist = true;
     AbilityItem& abilityItem = startingAbilityMap_[systemAbilityId];
-    return StartOnDemandAbilityInner(iter->second, systemAbilityId, abilityItem);
+    return StartOnDemandAbilityInner(*procName, systemAbilityId, abilityItem);
 }
 
 sptr<IRemoteObject> BaseSystemAbilityManager::CheckSystemAbility(int32_t systemAbilityId, bool& isExist)
@@ -611,19 +685,18 @@ sptr<IRemoteObject> BaseSystemAbilityManager::CheckSystemAbility(int32_t systemA
 
 bool BaseSystemAbilityManager::DoLoadOnDemandAbility(int32_t systemAbilityId, bool& isExist)
 {
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
+    lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
     sptr<IRemoteObject> abilityProxy = CheckSystemAbility(systemAbilityId);
     if (abilityProxy != nullptr) {
         isExist = true;
         return true;
     }
-    auto iter = startingAbilityMap_.find(systemAbilityId);
-    if (iter != startingAbilityMap_.end() && iter->second.state == AbilityState::STARTING) {
+    AbilityItem* startingItem = startingAbilityMap_.find(systemAbilityId);
+    if (startingItem != nullptr && startingItem->state == AbilityState::STARTING) {
         isExist = true;
         return true;
     }
-    auto onDemandIter = onDemandAbilityMap_.find(systemAbilityId);
-    if (onDemandIter == onDemandAbilityMap_.end()) {
+    if (onDemandAbilityMap_.count(systemAbilityId) == 0) {
         isExist = false;
         return false;
     }
@@ -639,7 +712,7 @@ int32_t BaseSystemAbilityManager::RemoveSystemAbility(int32_t systemAbilityId)
         return ERR_INVALID_VALUE;
     }
     {
-        unique_lock<samgr::shared_mutex> writeLock(abilityMapLock_);
+        unique_lock<AbilityMapLock> writeLock(abilityMapLock_);
         auto itSystemAbility = abilityMap_.find(systemAbilityId);
         if (itSystemAbility == abilityMap_.end()) {
             HILOGI("RemoveSystemAbility not found!");
@@ -650,6 +723,7 @@ int32_t BaseSystemAbilityManager::RemoveSystemAbility(int32_t systemAbilityId)
             ability->RemoveDeathRecipient(abilityDeath_);
         }
         (void)abilityMap_.erase(itSystemAbility);
+        PublishAbilityLocked(systemAbilityId);
         KHILOGI("rm SA:%{public}d_%{public}zu", systemAbilityId, abilityMap_.size());
     }
     if (abilityStateScheduler_ == nullptr) {
@@ -675,11 +749,12 @@ int32_t BaseSystemAbilityManager::RemoveSystemAbility(const sptr<IRemoteObject>&
 
     int32_t saId = 0;
     {
-        unique_lock<samgr::shared_mutex> writeLock(abilityMapLock_);
+        unique_lock<AbilityMapLock> writeLock(abilityMapLock_);
         for (auto iter = abilityMap_.begin(); iter != abilityMap_.end(); ++iter) {
             if (iter->second.remoteObj == ability) {
                 saId = iter->first;
                 (void)abilityMap_.erase(iter);
+                PublishAbilityLocked(saId);
                 if (abilityDeath_ != nullptr) {
                     ability->RemoveDeathRecipient(abilityDeath_);
                 }
@@ -708,7 +783,7 @@ int32_t BaseSystemAbilityManager::RemoveSystemAbility(const sptr<IRemoteObject>&
 int32_t BaseSystemAbilityManager::RemoveDiedSystemAbility(int32_t systemAbilityId)
 {
     {
-        unique_lock<samgr::shared_mutex> writeLock(abilityMapLock_);
+        unique_lock<AbilityMapLock> writeLock(abilityMapLock_);
         auto itSystemAbility = abilityMap_.find(systemAbilityId);
         if (itSystemAbility == abilityMap_.end()) {
             return ERR_OK;
@@ -718,6 +793,7 @@ int32_t BaseSystemAbilityManager::RemoveDiedSystemAbility(int32_t systemAbilityI
             ability->RemoveDeathRecipient(abilityDeath_);
         }
         (void)abilityMap_.erase(itSystemAbility);
+        PublishAbilityLocked(systemAbilityId);
         ReportSaCrash(systemAbilityId);
         KHILOGI("rm DeadObj SA:%{public}d_%{public}zu", systemAbilityId, abilityMap_.size());
     }
@@ -728,7 +804,7 @@ int32_t BaseSystemAbilityManager::RemoveDiedSystemAbility(int32_t systemAbilityI
 vector<u16string> BaseSystemAbilityManager::ListSystemAbilities(uint32_t dumpFlags)
 {
     vector<u16string> list;
-    shared_lock<samgr::shared_mutex> readLock(abilityMapLock_);
+    shared_lock<AbilityMapLock> readLock(abilityMapLock_);
     for (auto iter = abilityMap_.begin(); iter != abilityMap_.end(); iter++) {
         list.emplace_back(Str8ToStr16(to_string(iter->first)));
     }
@@ -736,24 +812,11 @@ vector<u16string> BaseSystemAbilityManager::ListSystemAbilities(uint32_t dumpFla
 }
 
 void BaseSystemAbilityManager::NotifySystemAbilityAddedByAsync(int32_t systemAbilityId,
-    const sptr<ISystemAbilityStatusChange>& listener)
+    const sptr<ISystemAbilityStatusChange>& listener, int32_t callingPid)
 {
-    if (workHandler_ == nullptr) {
-        HILOGE("NotifySystemAbilityAddedByAsync workHandler is nullptr");
-        return;
-    } else {
-        auto listenerNotifyTask = [systemAbilityId, listener, weakThis = weak_from_this()]() {
-            auto self = weakThis.lock();
-            if (self == nullptr) {
-                return;
-            }
-            self->NotifySystemAbilityChanged(systemAbilityId, "",
-                static_cast<uint32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION), listener);
-        };
-        if (!workHandler_->PostTask(listenerNotifyTask)) {
-            HILOGE("NotifySystemAbilityAddedByAsync PostTask fail SA:%{public}d", systemAbilityId);
-        }
-    }
+    // through the listener's queue, so it cannot overtake the add/remove events already pending for it
+    listenerNotifier_->Notify(systemAbilityId, "",
+        static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION), { { listener, callingPid } });
 }
 
 void BaseSystemAbilityManager::CheckListenerNotify(int32_t systemAbilityId,
@@ -763,22 +826,25 @@ void BaseSystemAbilityManager::CheckListenerNotify(int32_t systemAbilityId,
     if (targetObject == nullptr) {
         return;
     }
-    lock_guard<samgr::mutex> autoLock(listenerMapLock_);
-    auto& listeners = listenerMap_[systemAbilityId];
-    for (auto& itemListener : listeners) {
-        if (listener->AsObject() == itemListener.listener->AsObject()) {
-            int32_t callingPid = itemListener.callingPid;
-            if (itemListener.state == ListenerState::INIT) {
-                HILOGI("NotifyAddSA:%{public}d,%{public}d_%{public}d",
-                    systemAbilityId, callingPid, subscribeCountMap_[callingPid]);
-                NotifySystemAbilityAddedByAsync(systemAbilityId, listener);
-                itemListener.state = ListenerState::NOTIFIED;
-            } else {
-                HILOGI("Subscribe Listener has been notified,SA:%{public}d,callpid:%{public}d",
-                    systemAbilityId, callingPid);
-            }
-            break;
-        }
+    lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
+    auto indexIter = listenerIndex_.find(listener->AsObject().GetRefPtr());
+    if (indexIter == listenerIndex_.end()) {
+        return;
+    }
+    auto posIter = indexIter->second.find(systemAbilityId);
+    if (posIter == indexIter->second.end()) {
+        return;
+    }
+    auto& itemListener = *(posIter->second);
+    int32_t callingPid = itemListener.callingPid;
+    if (itemListener.state == ListenerState::INIT) {
+        HILOGI("NotifyAddSA:%{public}d,%{public}d_%{public}d",
+            systemAbilityId, callingPid, subscribeCountMap_[callingPid]);
+        NotifySystemAbilityAddedByAsync(systemAbilityId, listener, callingPid);
+        itemListener.state = ListenerState::NOTIFIED;
+    } else {
+        HILOGI("Subscribe Listener has been notified,SA:%{public}d,callpid:%{public}d",
+            systemAbilityId, callingPid);
     }
 }
 
@@ -792,14 +858,14 @@ int32_t BaseSystemAbilityManager::SubscribeSystemAbility(int32_t systemAbilityId
 
     auto callingPid = IPCSkeleton::GetCallingPid();
     {
-        lock_guard<samgr::mutex> autoLock(listenerMapLock_);
-        auto& listeners = listenerMap_[systemAbilityId];
-        for (const auto& itemListener : listeners) {
-            if (listener->AsObject() == itemListener.listener->AsObject()) {
-                HILOGI("already exist listener object SA:%{public}d", systemAbilityId);
-                return ERR_OK;
-            }
+        lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
+        IRemoteObject* key = listener->AsObject().GetRefPtr();
+        auto indexIter = listenerIndex_.find(key);
+        if (indexIter != listenerIndex_.end() && indexIter->second.count(systemAbilityId) != 0) {
+            HILOGI("already exist listener object SA:%{public}d", systemAbilityId);
+            return ERR_OK;
         }
+        auto& listeners = listenerMap_[systemAbilityId];
         auto& count = subscribeCountMap_[callingPid];
         if (count >= MAX_SUBSCRIBE_COUNT) {
             HILOGE("SubscribeSystemAbility pid:%{public}d overflow max subscribe count!", callingPid);
@@ -810,6 +876,7 @@ int32_t BaseSystemAbilityManager::SubscribeSystemAbility(int32_t systemAbilityId
         if (abilityStatusDeath_ != nullptr) {
             ret = listener->AsObject()->AddDeathRecipient(abilityStatusDeath_);
             listeners.emplace_back(listener, callingPid);
+            listenerIndex_[key][systemAbilityId] = std::prev(listeners.end());
         }
         HILOGI("SubscribeSA:%{public}d,%{public}d_%{public}zu_%{public}d%{public}s",
             systemAbilityId, callingPid, listeners.size(), count, ret ? "" : ",AddDeath fail");
@@ -818,22 +885,28 @@ int32_t BaseSystemAbilityManager::SubscribeSystemAbility(int32_t systemAbilityId
     return ERR_OK;
 }
 
-void BaseSystemAbilityManager::UnSubscribeSystemAbilityLocked(
-    std::list<SAListener>& listenerList, const sptr<IRemoteObject>& listener)
+void BaseSystemAbilityManager::UnSubscribeSystemAbilityLocked(int32_t systemAbilityId,
+    const sptr<IRemoteObject>& listener)
 {
-    auto item = listenerList.begin();
-    for (; item != listenerList.end(); item++) {
-        if (item->listener == nullptr) {
-            HILOGE("listener is null");
-            return;
-        }
-        if (item->listener->AsObject() == listener) {
-            break;
-        }
+    auto indexIter = listenerIndex_.find(listener.GetRefPtr());
+    if (indexIter == listenerIndex_.end()) {
+        return;
     }
-    if (item == listenerList.end()) {
+    auto& positions = indexIter->second;
+    auto posIter = positions.find(systemAbilityId);
+    if (posIter == positions.end()) {
         return;
     }
+    EraseListenerLocked(systemAbilityId, posIter->second);
+    positions.erase(posIter);
+    if (positions.empty()) {
+        listenerIndex_.erase(indexIter);
+    }
+}
+
+void BaseSystemAbilityManager::EraseListenerLocked(int32_t systemAbilityId, std::list<SAListener>::iterator item)
+{
+    auto& listenerList = listenerMap_[systemAbilityId];
     int32_t callpid = item->callingPid;
     auto iterPair = subscribeCountMap_.find(callpid);
     if (iterPair != subscribeCountMap_.end()) {
@@ -855,32 +928,44 @@ int32_t BaseSystemAbilityManager::UnSubscribeSystemAbility(int32_t systemAbility
     }
 
     auto callingPid = IPCSkeleton::GetCallingPid();
-    lock_guard<samgr::mutex> autoLock(listenerMapLock_);
-    auto& listeners = listenerMap_[systemAbilityId];
-    UnSubscribeSystemAbilityLocked(listeners, listener->AsObject());
+    lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
+    UnSubscribeSystemAbilityLocked(systemAbilityId, listener->AsObject());
     if (abilityStatusDeath_ != nullptr) {
         listener->AsObject()->RemoveDeathRecipient(abilityStatusDeath_);
     }
-    HILOGI("UnSubscribeSA:%{public}d_%{public}d_%{public}zu", systemAbilityId, callingPid, listeners.size());
+    if (!IsListenerSubscribedLocked(listener->AsObject())) {
+        listenerNotifier_->RemoveListener(listener->AsObject());
+    }
+    HILOGI("UnSubscribeSA:%{public}d_%{public}d_%{public}zu", systemAbilityId, callingPid,
+        listenerMap_[systemAbilityId].size());
     return ERR_OK;
 }
 
+bool BaseSystemAbilityManager::IsListenerSubscribedLocked(const sptr<IRemoteObject>& listener)
+{
+    return listenerIndex_.find(listener.GetRefPtr()) != listenerIndex_.end();
+}
+
 void BaseSystemAbilityManager::UnSubscribeSystemAbility(const sptr<IRemoteObject>& remoteObject)
 {
-    lock_guard<samgr::mutex> autoLock(listenerMapLock_);
-    HILOGD("UnSubscribeSA remote object dead! size:%{public}zu", listenerMap_.size());
-    for (auto& item : listenerMap_) {
-        auto& listeners = item.second;
-        UnSubscribeSystemAbilityLocked(listeners, remoteObject);
+    lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
+    auto indexIter = listenerIndex_.find(remoteObject.GetRefPtr());
+    if (indexIter != listenerIndex_.end()) {
+        HILOGD("UnSubscribeSA remote object dead! size:%{public}zu", indexIter->second.size());
+        for (const auto& [saId, item] : indexIter->second) {
+            EraseListenerLocked(saId, item);
+        }
+        listenerIndex_.erase(indexIter);
     }
     if (abilityStatusDeath_ != nullptr) {
         remoteObject->RemoveDeathRecipient(abilityStatusDeath_);
     }
+    listenerNotifier_->RemoveListener(remoteObject);
 }
 
 void BaseSystemAbilityManager::RefreshListenerState(int32_t systemAbilityId)
 {
-    lock_guard<samgr::mutex> autoLock(listenerMapLock_);
+    lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
     auto iter = listenerMap_.find(systemAbilityId);
     if (iter != listenerMap_.end()) {
         auto& listeners = iter->second;
@@ -904,7 +989,7 @@ int32_t BaseSystemAbilityManager::AddSystemAbility(int32_t systemAbilityId, cons
         return ERR_INVALID_VALUE;
     }
     {
-        unique_lock<samgr::shared_mutex> writeLock(abilityMapLock_);
+        unique_lock<AbilityMapLock> writeLock(abilityMapLock_);
         auto saSize = abilityMap_.size();
         if (saSize >= MAX_SERVICES) {
             HILOGE("map size error, (Has been greater than %zu)", saSize);
@@ -920,6 +1005,7 @@ int32_t BaseSystemAbilityManager::AddSystemAbility(int32_t systemAbilityId, cons
                 systemAbilityId, callingPid, callingUid);
         }
         abilityMap_[systemAbilityId] = std::move(saInfo);
+        PublishAbilityLocked(systemAbilityId);
         KHILOGI("insert SA:%{public}d_%{public}zu", systemAbilityId, abilityMap_.size());
     }
     RemoveCheckLoadedMsg(systemAbilityId);
@@ -937,6 +1023,25 @@ int32_t BaseSystemAbilityManager::AddSystemAbility(int32_t systemAbilityId, cons
     return ERR_OK;
 }
 
+bool BaseSystemAbilityManager::FindAbility(int32_t systemAbilityId, SAInfo& saInfo) const
+{
+    return abilityTable_.Find(systemAbilityId, saInfo);
+}
+
+void BaseSystemAbilityManager::PublishAbilityLocked(int32_t systemAbilityId)
+{
+    auto iter = abilityMap_.find(systemAbilityId);
+    abilityTable_.PublishLocked(systemAbilityId, (iter != abilityMap_.end()) ? &iter->second : nullptr);
+}
+
+void BaseSystemAbilityManager::RefreshAbilityTableLocked()
+{
+    abilityTable_.ClearLocked();
+    for (const auto& [saId, saInfo] : abilityMap_) {
+        abilityTable_.PublishLocked(saId, &saInfo);
+    }
+}
+
 void BaseSystemAbilityManager::SystemAbilityInvalidateCache(int32_t systemAbilityId)
 {
     auto pos = onDemandSaIdsSet_.find(systemAbilityId);
@@ -944,7 +1049,7 @@ void BaseSystemAbilityManager::SystemAbilityInvalidateCache(int32_t systemAbilit
         HILOGD("SystemAbilityInvalidateCache SA:%{public}d.", systemAbilityId);
         return;
     }
-    SamgrUtil::InvalidateSACache();
+    SamgrUtil::InvalidateSACache(systemAbilityId);
 }
 
 int32_t BaseSystemAbilityManager::AddSystemProcess(const u16string& procName,
@@ -1126,6 +1231,9 @@ int32_t BaseSystemAbilityManager::GetOnDemandReasonExtraData(int64_t extraDataId
 void BaseSystemAbilityManager::SendSystemAbilityAddedMsg(int32_t systemAbilityId,
     const sptr<IRemoteObject>& remoteObject)
 {
+    if (collectManager_ != nullptr) {
+        collectManager_->OnSystemAbilityAdded(systemAbilityId);
+    }
     if (workHandler_ == nullptr) {
         HILOGE("SendSaAddedMsg work handler not init");
         return;
@@ -1148,6 +1256,9 @@ void BaseSystemAbilityManager::SendSystemAbilityAddedMsg(int32_t systemAbilityId
 
 void BaseSystemAbilityManager::SendSystemAbilityRemovedMsg(int32_t systemAbilityId)
 {
+    if (collectManager_ != nullptr) {
+        collectManager_->OnSystemAbilityRemoved(systemAbilityId);
+    }
     if (workHandler_ == nullptr) {
         HILOGE("SendSaRemovedMsg work handler not init");
         return;
@@ -1223,13 +1334,13 @@ void BaseSystemAbilityManager::CleanCallbackForLoadFailed(int32_t systemAbilityI
             startingProcessMap_.erase(iterStarting);
         }
     }
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
-    auto iter = startingAbilityMap_.find(systemAbilityId);
-    if (iter == startingAbilityMap_.end()) {
+    lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
+    AbilityItem* startingItem = startingAbilityMap_.find(systemAbilityId);
+    if (startingItem == nullptr) {
         HILOGI("CleanCallback SA:%{public}d not in startingAbilityMap.", systemAbilityId);
         return;
     }
-    auto& abilityItem = iter->second;
+    auto& abilityItem = *startingItem;
     for (auto& callbackItem : abilityItem.callbackMap[srcDeviceId]) {
         if (callback->AsObject() != callbackItem.first->AsObject()) {
             continue;
@@ -1259,7 +1370,7 @@ void BaseSystemAbilityManager::CleanCallbackForLoadFailed(int32_t systemAbilityI
 
     if (abilityItem.callbackMap.empty()) {
         HILOGD("CleanCallback startingAbilityMap remove SA:%{public}d.", systemAbilityId);
-        startingAbilityMap_.erase(iter);
+        startingAbilityMap_.erase(systemAbilityId);
     }
 }
 
@@ -1309,20 +1420,19 @@ void BaseSystemAbilityManager::NotifySystemAbilityLoaded(int32_t systemAbilityId
 void BaseSystemAbilityManager::NotifySystemAbilityLoaded(int32_t systemAbilityId,
     const sptr<IRemoteObject>& remoteObject)
 {
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
-    auto iter = startingAbilityMap_.find(systemAbilityId);
-    if (iter == startingAbilityMap_.end()) {
+    lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
+    AbilityItem* abilityItem = startingAbilityMap_.find(systemAbilityId);
+    if (abilityItem == nullptr) {
         return;
     }
-    auto& abilityItem = iter->second;
-    for (auto& [deviceId, callbackList] : abilityItem.callbackMap) {
+    for (auto& [deviceId, callbackList] : abilityItem->callbackMap) {
         for (auto& callbackItem : callbackList) {
             HILOGI("notify SA:%{public}d,%{public}d", systemAbilityId, callbackItem.second);
             NotifySystemAbilityLoaded(systemAbilityId, remoteObject, callbackItem.first);
             RemoveStartingAbilityCallbackLocked(callbackItem);
         }
     }
-    startingAbilityMap_.erase(iter);
+    startingAbilityMap_.erase(systemAbilityId);
     if (!startingAbilityMap_.empty()) {
         HILOGI("startingAbility size:%{public}zu", startingAbilityMap_.size());
     }
@@ -1351,34 +1461,108 @@ int32_t BaseSystemAbilityManager::StartDynamicSystemProcess(const std::u16string
     std::string eventStr = std::to_string(systemAbilityId) + "#" + std::to_string(event.eventId) + "#"
         + event.name + "#" + event.value + "#" + std::to_string(event.extraDataId) + "#";
     auto extraArgv = eventStr.c_str();
-    if (abilityStateScheduler_ && !abilityStateScheduler_->IsSystemProcessNeverStartedLocked(name)) {
-        // Waiting for the init subsystem to perceive process death
-        int ret = ServiceWaitForStatus(Str16ToStr8(name).c_str(), ServiceStatus::SERVICE_STOPPED, 1);
-        if (ret != 0) {
-            HILOGE("ServiceWaitForStatus proc:%{public}s,SA:%{public}d timeout",
-                Str16ToStr8(name).c_str(), systemAbilityId);
-        }
-    }
+    const std::string& procName = ProcessNameTable::GetInstance().GetStr8(name);
     int64_t begin = GetTickCount();
     int result = ERR_INVALID_VALUE;
     if (!IsInitBootFinished()) {
-        result = ServiceControlWithExtra(Str16ToStr8(name).c_str(), ServiceAction::START, &extraArgv, 1);
+        result = ServiceControlWithExtra(procName.c_str(), ServiceAction::START, &extraArgv, 1);
     } else {
         SamgrXCollie samgrXCollie("samgr--startProccess_" + ToString(systemAbilityId));
-        result = ServiceControlWithExtra(Str16ToStr8(name).c_str(), ServiceAction::START, &extraArgv, 1);
+        result = ServiceControlWithExtra(procName.c_str(), ServiceAction::START, &extraArgv, 1);
     }
 
     int64_t duration = GetTickCount() - begin;
-    auto callingPid = IPCSkeleton::GetCallingPid();
-    auto callingUid = IPCSkeleton::GetCallingUid();
-    if (result != 0) {
-        ReportProcessStartFail(Str16ToStr8(name), callingPid, callingUid, "err:" + ToString(result));
-    }
     KHILOGI("Start dynamic proc:%{public}s,%{public}d,%{public}d_%{public}" PRId64 "ms",
-        Str16ToStr8(name).c_str(), systemAbilityId, result, duration);
+        procName.c_str(), systemAbilityId, result, duration);
     return result;
 }
 
+void BaseSystemAbilityManager::PostStartSystemProcess(const std::u16string& name,
+    int32_t systemAbilityId, const OnDemandEvent& event)
+{
+    // decided now, under the caller's process lock, rather than on the executor
+    bool waitForStopped = abilityStateScheduler_ != nullptr &&
+        !abilityStateScheduler_->IsSystemProcessNeverStartedLocked(name);
+    auto startRequest = [name, systemAbilityId, event, waitForStopped, weakThis = weak_from_this()]() {
+        auto self = weakThis.lock();
+        if (self == nullptr) {
+            return static_cast<int32_t>(ERR_INVALID_VALUE);
+        }
+        if (waitForStopped) {
+            // Waiting for the init subsystem to perceive process death
+            const std::string& procName = ProcessNameTable::GetInstance().GetStr8(name);
+            int ret = ServiceWaitForStatus(procName.c_str(), ServiceStatus::SERVICE_STOPPED, 1);
+            if (ret != 0) {
+                HILOGE("ServiceWaitForStatus proc:%{public}s,SA:%{public}d timeout",
+                    procName.c_str(), systemAbilityId);
+            }
+        }
+        return self->StartDynamicSystemProcess(name, systemAbilityId, event);
+    };
+    auto startCompletion = [name, systemAbilityId, weakThis = weak_from_this()](int32_t result, int64_t) {
+        if (result == ERR_OK) {
+            return;
+        }
+        auto self = weakThis.lock();
+        if (self == nullptr) {
+            return;
+        }
+        self->OnStartSystemProcessFailed(name, systemAbilityId, result);
+    };
+    processExecutor_->Submit(name, startRequest, startCompletion);
+}
+
+void BaseSystemAbilityManager::OnStartSystemProcessFailed(const std::u16string& name,
+    int32_t systemAbilityId, int32_t result)
+{
+    int32_t callingPid = -1;
+    int32_t callingUid = -1;
+    {
+        lock_guard<samgr::mutex> autoLock(startingProcessMapLock_);
+        auto iterStarting = startingProcessMap_.find(name);
+        if (iterStarting != startingProcessMap_.end()) {
+            callingPid = iterStarting->second.callingPid;
+            callingUid = iterStarting->second.callUid;
+            startingProcessMap_.erase(iterStarting);
+        }
+    }
+    ReportProcessStartFail(Str16ToStr8(name), callingPid, callingUid, "err:" + ToString(result));
+    CleanCallbackForStartFailed(systemAbilityId, result);
+    if (abilityStateScheduler_ == nullptr) {
+        HILOGE("abilityStateScheduler is nullptr");
+        return;
+    }
+    // the SA entered LOADING when the start was submitted
+    abilityStateScheduler_->SendAbilityStateEvent(systemAbilityId, AbilityStateEvent::ABILITY_LOAD_FAILED_EVENT);
+}
+
+void BaseSystemAbilityManager::CleanCallbackForStartFailed(int32_t systemAbilityId, int32_t result)
+{
+    // init rejected the start, fail the pending load callbacks now instead of at the check-loaded timeout
+    RemoveCheckLoadedMsg(systemAbilityId);
+    std::map<std::string, CallbackList> callbackMap;
+    {
+        lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
+        AbilityItem* startingItem = startingAbilityMap_.find(systemAbilityId);
+        if (startingItem == nullptr) {
+            HILOGI("CleanCallback SA:%{public}d not in startingAbilityMap.", systemAbilityId);
+            return;
+        }
+        for (auto& [deviceId, callbackList] : startingItem->callbackMap) {
+            for (auto& callbackItem : callbackList) {
+                RemoveStartingAbilityCallbackLocked(callbackItem);
+            }
+        }
+        callbackMap.swap(startingItem->callbackMap);
+        startingAbilityMap_.erase(systemAbilityId);
+    }
+    for (const auto& [deviceId, callbackList] : callbackMap) {
+        for (const auto& callbackItem : callbackList) {
+            NotifySystemAbilityLoadFail(systemAbilityId, callbackItem.first, result);
+        }
+    }
+}
+
 int32_t BaseSystemAbilityManager::StartingSystemProcessLocked(const std::u16string& procName,
     int32_t systemAbilityId, const OnDemandEvent& event)
 {
@@ -1401,21 +1585,14 @@ int32_t BaseSystemAbilityManager::StartingSystemProcessLocked(const std::u16stri
         } else {
             auto callPid = IPCSkeleton::GetCallingPid();
             auto callUid = IPCSkeleton::GetCallingUid();
-            auto callPname = SamgrUtil::GetProcessNameFromCmdline(callPid);
+            auto callPname = SamgrUtil::GetCachedProcessName(callPid);
             int64_t begin = GetTickCount();
             StartingProcessInfo startingProcessInfo = {procName, callPid, callUid, callPname, systemAbilityId, begin};
             startingProcessMap_.emplace(procName, std::move(startingProcessInfo));
         }
     }
-    int32_t result = StartDynamicSystemProcess(procName, systemAbilityId, event);
-    if (result != ERR_OK) {
-        lock_guard<samgr::mutex> autoLock(startingProcessMapLock_);
-        auto iterStarting = startingProcessMap_.find(procName);
-        if (iterStarting != startingProcessMap_.end()) {
-            startingProcessMap_.erase(iterStarting);
-        }
-    }
-    return result;
+    PostStartSystemProcess(procName, systemAbilityId, event);
+    return ERR_OK;
 }
 
 int32_t BaseSystemAbilityManager::StartingSystemProcess(const std::u16string& procName,
@@ -1440,21 +1617,14 @@ int32_t BaseSystemAbilityManager::StartingSystemProcess(const std::u16string& pr
         } else {
             auto callPid = IPCSkeleton::GetCallingPid();
             auto callUid = IPCSkeleton::GetCallingUid();
-            auto callPname = SamgrUtil::GetProcessNameFromCmdline(callPid);
+            auto callPname = SamgrUtil::GetCachedProcessName(callPid);
             int64_t begin = GetTickCount();
             StartingProcessInfo startingProcessInfo = {procName, callPid, callUid, callPname, systemAbilityId, begin};
             startingProcessMap_.emplace(procName, std::move(startingProcessInfo));
         }
     }
-    int32_t result = StartDynamicSystemProcess(procName, systemAbilityId, event);
-    if (result != ERR_OK) {
-        lock_guard<samgr::mutex> autoLock(startingProcessMapLock_);
-        auto iterStarting = startingProcessMap_.find(procName);
-        if (iterStarting != startingProcessMap_.end()) {
-            startingProcessMap_.erase(iterStarting);
-        }
-    }
-    return result;
+    PostStartSystemProcess(procName, systemAbilityId, event);
+    return ERR_OK;
 }
 
 int32_t BaseSystemAbilityManager::DoLoadSystemAbility(int32_t systemAbilityId, const std::u16string& procName,
@@ -1471,7 +1641,7 @@ int32_t BaseSystemAbilityManager::DoLoadSystemAbility(int32_t systemAbilityId, c
     }
     int32_t result = ERR_INVALID_VALUE;
     {
-        lock_guard<samgr::mutex> autoLock(onDemandLock_);
+        lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
         auto& abilityItem = startingAbilityMap_[systemAbilityId];
         for (const auto& itemCallback : abilityItem.callbackMap[LOCAL_DEVICE]) {
             if (callback->AsObject() == itemCallback.first->AsObject()) {
@@ -1479,12 +1649,16 @@ int32_t BaseSystemAbilityManager::DoLoadSystemAbility(int32_t systemAbilityId, c
                 return ERR_OK;
             }
         }
-        auto& count = callbackCountMap_[callingPid];
-        if (count >= MAX_SUBSCRIBE_COUNT) {
-            HILOGE("LoadSystemAbility pid:%{public}d overflow max callback count!", callingPid);
-            return CALLBACK_MAP_SIZE_LIMIT;
+        int32_t count = 0;
+        {
+            lock_guard<samgr::mutex> countLock(callbackCountLock_);
+            auto& callbackCount = callbackCountMap_[callingPid];
+            if (callbackCount >= MAX_SUBSCRIBE_COUNT) {
+                HILOGE("LoadSystemAbility pid:%{public}d overflow max callback count!", callingPid);
+                return CALLBACK_MAP_SIZE_LIMIT;
+            }
+            count = ++callbackCount;
         }
-        ++count;
         abilityItem.callbackMap[LOCAL_DEVICE].emplace_back(callback, callingPid);
         abilityItem.event = event;
         bool ret = false;
@@ -1495,7 +1669,7 @@ int32_t BaseSystemAbilityManager::DoLoadSystemAbility(int32_t systemAbilityId, c
             abilityItem.callbackMap[LOCAL_DEVICE].size(), count, ret ? "" : ",AddDeath fail");
     }
     auto callPid = IPCSkeleton::GetCallingPid();
-    auto callPname = SamgrUtil::GetProcessNameFromCmdline(callPid);
+    auto callPname = SamgrUtil::GetCachedProcessName(callPid);
     SystemProcessInfo procInfo;
     if (abilityStateScheduler_ != nullptr) {
         abilityStateScheduler_->GetRunningSystemProcess(procName, procInfo);
@@ -1581,7 +1755,7 @@ int32_t BaseSystemAbilityManager::DoUnloadSystemAbility(int32_t systemAbilityId,
         return ERR_OK;
     }
     {
-        lock_guard<samgr::mutex> autoLock(onDemandLock_);
+        lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
         bool result = StopOnDemandAbilityInner(procName, systemAbilityId, event);
         if (!result) {
             HILOGE("unload system ability failed, SA:%{public}d", systemAbilityId);
@@ -1656,29 +1830,27 @@ int32_t BaseSystemAbilityManager::OnStartSystemAbilityFail(int32_t systemAbility
     }
     auto callingPid = IPCSkeleton::GetCallingPid();
     auto callingProc = SamgrUtil::GetProcessNameFromCmdline(callingPid);
-    if (Str16ToStr8(saProfile.process) != callingProc) {
+    if (ProcessNameTable::GetInstance().GetStr8(saProfile.process) != callingProc) {
         HILOGE("OnStartSystemAbilityFail invalid pid:%{public}d, SA:%{public}d", callingPid, systemAbilityId);
         return INVALID_CALL_PROC;
     }
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
-    auto onDemandIter = onDemandAbilityMap_.find(systemAbilityId);
-    if (onDemandIter == onDemandAbilityMap_.end()) {
+    lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
+    if (onDemandAbilityMap_.count(systemAbilityId) == 0) {
         onDemandAbilityMap_[systemAbilityId] = saProfile.process;
     }
-    auto iter = startingAbilityMap_.find(systemAbilityId);
-    if (iter == startingAbilityMap_.end()) {
+    AbilityItem* abilityItem = startingAbilityMap_.find(systemAbilityId);
+    if (abilityItem == nullptr) {
         return ERR_OK;
     }
     RemoveCheckLoadedMsg(systemAbilityId);
-    auto& abilityItem = iter->second;
-    for (auto& [deviceId, callbackList] : abilityItem.callbackMap) {
+    for (auto& [deviceId, callbackList] : abilityItem->callbackMap) {
         for (auto& callbackItem : callbackList) {
             HILOGI("notify SA:%{public}d,%{public}d", systemAbilityId, callbackItem.second);
             NotifySystemAbilityLoadFail(systemAbilityId, callbackItem.first, errCode);
             RemoveStartingAbilityCallbackLocked(callbackItem);
         }
     }
-    startingAbilityMap_.erase(iter);
+    startingAbilityMap_.erase(systemAbilityId);
     if (!startingAbilityMap_.empty()) {
         HILOGI("startingAbility size:%{public}zu", startingAbilityMap_.size());
     }
@@ -1739,6 +1911,7 @@ void BaseSystemAbilityManager::RemoveStartingAbilityCallbackLocked(
     if (abilityCallbackDeath_ != nullptr) {
         itemPair.first->AsObject()->RemoveDeathRecipient(abilityCallbackDeath_);
     }
+    lock_guard<samgr::mutex> autoLock(callbackCountLock_);
     auto iterCount = callbackCountMap_.find(itemPair.second);
     if (iterCount != callbackCountMap_.end()) {
         --iterCount->second;
@@ -1771,6 +1944,7 @@ void BaseSystemAbilityManager::RemoveStartingAbilityCallback(CallbackList& callb
     while (iterCallback != callbackList.end()) {
         auto& callbackPair = *iterCallback;
         if (callbackPair.first->AsObject() == remoteObject) {
+            SamgrUtil::RemoveCachedProcessName(callbackPair.second);
             RemoveStartingAbilityCallbackLocked(callbackPair);
             iterCallback = callbackList.erase(iterCallback);
             break;
@@ -1786,15 +1960,19 @@ void BaseSystemAbilityManager::OnAbilityCallbackDied(const sptr<IRemoteObject>&
     if (remoteObject == nullptr) {
         return;
     }
-    lock_guard<samgr::mutex> autoLock(onDemandLock_);
-    auto iter = startingAbilityMap_.begin();
-    while (iter != startingAbilityMap_.end()) {
-        AbilityItem& abilityItem = iter->second;
-        RemoveStartingAbilityCallbackForDevice(abilityItem, remoteObject);
-        if (abilityItem.callbackMap.empty()) {
-            startingAbilityMap_.erase(iter++);
-        } else {
-            ++iter;
+    // one stripe at a time, loads in the other stripes keep going
+    for (size_t index = 0; index < onDemandLocks_.size(); ++index) {
+        lock_guard<OnDemandLock> autoLock(onDemandLocks_[index]);
+        auto& stripe = startingAbilityMap_.GetStripe(index);
+        auto iter = stripe.begin();
+        while (iter != stripe.end()) {
+            AbilityItem& abilityItem = iter->second;
+            RemoveStartingAbilityCallbackForDevice(abilityItem, remoteObject);
+            if (abilityItem.callbackMap.empty()) {
+                iter = startingAbilityMap_.Erase(index, iter);
+            } else {
+                ++iter;
+            }
         }
     }
 }
@@ -1832,20 +2010,29 @@ void BaseSystemAbilityManager::RemoveRemoteCallbackLocked(std::list<sptr<ISystem
     }
 }
 
-int32_t BaseSystemAbilityManager::UpdateSaFreMap(int32_t uid, int32_t saId)
+void BaseSystemAbilityManager::UpdateSaFreMap(int32_t uid, int32_t saId)
 {
     if (uid < 0) {
         HILOGW("UpdateSaFreMap return, uid not valid!");
-        return -1;
+        return;
     }
 
     uint64_t key = SamgrUtil::GenerateFreKey(uid, saId);
-    lock_guard<samgr::mutex> autoLock(saFrequencyLock_);
-    auto& count = saFrequencyMap_[key];
-    if (count < MAX_SA_FREQUENCY_COUNT) {
-        count++;
+    saFrequencyCounter_.Increase(key, MAX_SA_FREQUENCY_COUNT);
+}
+
+int32_t BaseSystemAbilityManager::GetSaFreCount(int32_t uid, int32_t saId)
+{
+    if (uid < 0) {
+        return -1;
     }
-    return count;
+    uint64_t key = SamgrUtil::GenerateFreKey(uid, saId);
+    return saFrequencyCounter_.GetCount(key, MAX_SA_FREQUENCY_COUNT);
+}
+
+void BaseSystemAbilityManager::MergeSaFreMapLocked()
+{
+    saFrequencyCounter_.Drain(saFrequencyMap_, MAX_SA_FREQUENCY_COUNT);
 }
 
 int32_t BaseSystemAbilityManager::GetOnDemandSystemAbilityIds(std::vector<int32_t>& systemAbilityIds)
@@ -1910,7 +2097,7 @@ int32_t BaseSystemAbilityManager::GetExtensionRunningSaList(const std::string& e
     for (const auto& [saId, value] : saProfileMap_) {
         if (std::find(value.extension.begin(), value.extension.end(), extension)
             != value.extension.end()) {
-            shared_lock<samgr::shared_mutex> readLock(abilityMapLock_);
+            shared_lock<AbilityMapLock> readLock(abilityMapLock_);
             auto iter = abilityMap_.find(saId);
             if (iter != abilityMap_.end() && iter->second.remoteObj != nullptr) {
                 saList.push_back(iter->second.remoteObj);
@@ -1933,7 +2120,7 @@ int32_t BaseSystemAbilityManager::GetRunningSaExtensionInfoList(const std::strin
                 HILOGD("get SaExtInfoList sa not load,ext:%{public}s SA:%{public}d", extension.c_str(), saId);
                 continue;
             }
-            shared_lock<samgr::shared_mutex> readLock(abilityMapLock_);
+            shared_lock<AbilityMapLock> readLock(abilityMapLock_);
             auto iter = abilityMap_.find(saId);
             if (iter == abilityMap_.end() || iter->second.remoteObj == nullptr) {
                 HILOGD("getRunningSaExtInfoList SA:%{public}d not load,ext:%{public}s", saId, extension.c_str());
@@ -2045,20 +2232,20 @@ bool BaseSystemAbilityManager::IsModuleUpdate(int32_t systemAbilityId)
 
 int32_t BaseSystemAbilityManager::StartOnDemandAbility(int32_t systemAbilityId, bool& isExist)
 {
-    std::lock_guard<samgr::mutex> onDemandAbilityLock(onDemandLock_);
+    std::lock_guard<OnDemandLock> onDemandAbilityLock(GetOnDemandLock(systemAbilityId));
     return StartOnDemandAbilityLocked(systemAbilityId, isExist);
 }
 
 void BaseSystemAbilityManager::StartOnDemandAbility(const std::u16string& name, int32_t systemAbilityId)
 {
-    std::lock_guard<samgr::mutex> autoLock(onDemandLock_);
+    std::lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
     StartOnDemandAbilityLocked(name, systemAbilityId);
 }
 
 bool BaseSystemAbilityManager::StopOnDemandAbility(const std::u16string& name, int32_t systemAbilityId,
     const OnDemandEvent& event)
 {
-    std::lock_guard<samgr::mutex> autoLock(onDemandLock_);
+    std::lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
     return StopOnDemandAbilityInner(name, systemAbilityId, event);
 }
 
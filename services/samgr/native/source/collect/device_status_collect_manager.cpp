@@ -15,6 +15,9 @@
 
 #include "device_status_collect_manager.h"
 
+#include <algorithm>
+#include <tuple>
+
 #include "base_system_ability_manager.h"
 #include "datetime_ex.h"
 #include "device_timed_collect.h"
@@ -90,10 +93,57 @@ void DeviceStatusCollectManager::FilterOnDemandSaProfiles(const std::list<SaProf
         collMgrSaProfile.stopOnDemandEvents.assign(saProfile.stopOnDemand.onDemandEvents.begin(),
             saProfile.stopOnDemand.onDemandEvents.end());
         collMgrSaProfile.cacheCommonEvent = saProfile.cacheCommonEvent;
+        size_t profileOrder = onDemandSaProfiles_.size();
+        AddEventIndexLocked(collMgrSaProfile, profileOrder, OnDemandPolicyType::START_POLICY);
+        AddEventIndexLocked(collMgrSaProfile, profileOrder, OnDemandPolicyType::STOP_POLICY);
         onDemandSaProfiles_.push_back(collMgrSaProfile);
     }
 }
 
+void DeviceStatusCollectManager::AddEventIndexLocked(const CollMgrSaProfile& profile, size_t profileOrder,
+    OnDemandPolicyType type)
+{
+    bool isStart = (type == OnDemandPolicyType::START_POLICY);
+    const auto& events = isStart ? profile.startOnDemandEvents : profile.stopOnDemandEvents;
+    for (size_t i = 0; i < events.size(); i++) {
+        OnDemandEventKey key = { events[i].eventId, events[i].name, events[i].value };
+        OnDemandEventEntry entry = { profileOrder, isStart ? START_ON_DEMAND : STOP_ON_DEMAND, i,
+            profile.saId, profile.cacheCommonEvent, events[i] };
+        eventIndex_[key].emplace_back(std::move(entry));
+    }
+}
+
+void DeviceStatusCollectManager::RemoveEventIndexLocked(int32_t systemAbilityId, OnDemandPolicyType type,
+    const std::vector<OnDemandEvent>& events)
+{
+    int32_t ondemandId = (type == OnDemandPolicyType::START_POLICY) ? START_ON_DEMAND : STOP_ON_DEMAND;
+    for (auto& event : events) {
+        auto iter = eventIndex_.find({ event.eventId, event.name, event.value });
+        if (iter == eventIndex_.end()) {
+            continue;
+        }
+        auto& entries = iter->second;
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [systemAbilityId, ondemandId](auto& entry) {
+            return entry.saId == systemAbilityId && entry.ondemandId == ondemandId;
+        }), entries.end());
+        if (entries.empty()) {
+            eventIndex_.erase(iter);
+        }
+    }
+}
+
+void DeviceStatusCollectManager::FindEventIndexLocked(const OnDemandEventKey& key,
+    std::vector<const OnDemandEventEntry*>& candidates)
+{
+    auto iter = eventIndex_.find(key);
+    if (iter == eventIndex_.end()) {
+        return;
+    }
+    for (auto& entry : iter->second) {
+        candidates.emplace_back(&entry);
+    }
+}
+
 void DeviceStatusCollectManager::GetSaControlListByPersistEvent(const OnDemandEvent& event,
     std::list<SaControlInfo>& saControlList)
 {
@@ -130,30 +180,30 @@ void DeviceStatusCollectManager::GetSaControlListByEvent(const OnDemandEvent& ev
     std::list<SaControlInfo>& saControlList)
 {
     std::shared_lock<samgr::shared_mutex> readLock(saProfilesLock_);
-    for (auto& profile : onDemandSaProfiles_) {
-        // start on demand
-        for (auto iterStart = profile.startOnDemandEvents.begin();
-            iterStart != profile.startOnDemandEvents.end(); iterStart++) {
-            if (IsSameEvent(event, *iterStart) && CheckConditions(*iterStart) &&
-                CheckExtraMessages(event, *iterStart)) {
-                // maybe the process is being killed, let samgr make decisions.
-                SaControlInfo control = { START_ON_DEMAND, profile.saId, iterStart->enableOnce,
-                    iterStart->loadPriority, profile.cacheCommonEvent };
-                saControlList.emplace_back(control);
-                break;
-            }
+    // an empty value in the profile matches any reported value
+    std::vector<const OnDemandEventEntry*> candidates;
+    FindEventIndexLocked({ event.eventId, event.name, event.value }, candidates);
+    if (!event.value.empty()) {
+        FindEventIndexLocked({ event.eventId, event.name, "" }, candidates);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto* entry1, const auto* entry2) {
+        return std::tie(entry1->profileOrder, entry1->ondemandId, entry1->eventOrder) <
+            std::tie(entry2->profileOrder, entry2->ondemandId, entry2->eventOrder);
+    });
+    const OnDemandEventEntry* lastMatched = nullptr;
+    for (auto entry : candidates) {
+        // only the first matching event of each start/stop list counts, as before
+        if (lastMatched != nullptr && lastMatched->profileOrder == entry->profileOrder &&
+            lastMatched->ondemandId == entry->ondemandId) {
+            continue;
         }
-        // stop on demand
-        for (auto iterStop = profile.stopOnDemandEvents.begin();
-            iterStop != profile.stopOnDemandEvents.end(); iterStop++) {
-            if (IsSameEvent(event, *iterStop) && CheckConditions(*iterStop) &&
-                CheckExtraMessages(event, *iterStop)) {
-                // maybe the process is starting, let samgr make decisions.
-                SaControlInfo control = { STOP_ON_DEMAND, profile.saId, iterStop->enableOnce,
-                    iterStop->loadPriority, profile.cacheCommonEvent };
-                saControlList.emplace_back(control);
-                break;
-            }
+        if (IsSameEvent(event, entry->event) && CheckConditions(entry->event) &&
+            CheckExtraMessages(event, entry->event)) {
+            // maybe the process is being killed or starting, let samgr make decisions.
+            SaControlInfo control = { entry->ondemandId, entry->saId, entry->event.enableOnce,
+                entry->event.loadPriority, entry->cacheCommonEvent };
+            saControlList.emplace_back(control);
+            lastMatched = entry;
         }
     }
     HILOGD("DeviceStaMgr saControlList size %{public}zu", saControlList.size());
@@ -281,29 +331,115 @@ void DeviceStatusCollectManager::StartCollect()
 }
 
 void DeviceStatusCollectManager::ReportEvent(const OnDemandEvent& event)
+{
+    ReportEvents({ event });
+}
+
+void DeviceStatusCollectManager::ReportEvents(const std::vector<OnDemandEvent>& events)
 {
     if (collectHandler_ == nullptr) {
         HILOGW("DeviceStaMgr collectHandler_ is nullptr");
         return;
     }
-    auto callback = [event, this] () {
+    {
+        std::lock_guard<samgr::mutex> autoLock(pendingEventsLock_);
+        pendingEvents_.insert(pendingEvents_.end(), events.begin(), events.end());
+        if (eventDrainPosted_) {
+            return;
+        }
+        eventDrainPosted_ = true;
+    }
+    auto callback = [this] () {
+        DrainReportedEvents();
+    };
+    if (!collectHandler_->PostTask(callback)) {
+        // the events stay pending, the next report posts the drain again
+        HILOGE("DeviceStaMgr post event drain failed");
+        std::lock_guard<samgr::mutex> autoLock(pendingEventsLock_);
+        eventDrainPosted_ = false;
+    }
+}
+
+void DeviceStatusCollectManager::DrainReportedEvents()
+{
+    // everything reported while the previous batch was being dispatched forms the next window
+    while (true) {
+        std::vector<OnDemandEvent> events;
+        {
+            std::lock_guard<samgr::mutex> autoLock(pendingEventsLock_);
+            if (pendingEvents_.empty()) {
+                eventDrainPosted_ = false;
+                return;
+            }
+            events.swap(pendingEvents_);
+        }
+        std::list<OnDemandAction> actions;
+        MergeOnDemandActions(events, actions);
+        DispatchOnDemandActions(events, actions);
+    }
+}
+
+void DeviceStatusCollectManager::MergeOnDemandActions(const std::vector<OnDemandEvent>& events,
+    std::list<OnDemandAction>& actions)
+{
+    std::unordered_map<int32_t, std::list<OnDemandAction>::iterator> pendingActions;
+    size_t droppedCount = 0;
+    for (size_t eventIndex = 0; eventIndex < events.size(); ++eventIndex) {
+        const auto& event = events[eventIndex];
         std::list<SaControlInfo> saControlList;
         GetSaControlListByEvent(event, saControlList);
         GetSaControlListByPersistEvent(event, saControlList);
-        SortSaControlListByLoadPriority(saControlList);
         if (saControlList.empty()) {
             HILOGD("DeviceStaMgr no matched event");
             if (event.eventId == DEVICE_ONLINE) {
                 HILOGI("deviceOnline is empty");
             }
-            return;
+            continue;
         }
-        auto strongManager = manager_.lock();
-        if (strongManager != nullptr) {
-            strongManager->ProcessOnDemandEvent(event, saControlList);
+        for (const auto& saControl : saControlList) {
+            auto iter = pendingActions.find(saControl.saId);
+            if (iter == pendingActions.end()) {
+                actions.push_back({ eventIndex, saControl });
+                pendingActions[saControl.saId] = std::prev(actions.end());
+                continue;
+            }
+            droppedCount++;
+            if (iter->second->saControl.ondemandId != saControl.ondemandId) {
+                // the SA ends the window in the state it was asked for last, the earlier opposite action goes
+                actions.erase(iter->second);
+                actions.push_back({ eventIndex, saControl });
+                iter->second = std::prev(actions.end());
+            }
         }
-    };
-    collectHandler_->PostTask(callback);
+    }
+    // list::sort is stable, so same-priority actions keep their report order
+    actions.sort([](const OnDemandAction& action1, const OnDemandAction& action2) {
+        return action1.saControl.loadPriority < action2.saControl.loadPriority;
+    });
+    if (droppedCount > 0) {
+        HILOGI("DeviceStaMgr merge events:%{public}zu, actions:%{public}zu, dropped:%{public}zu",
+            events.size(), actions.size(), droppedCount);
+    }
+}
+
+void DeviceStatusCollectManager::DispatchOnDemandActions(const std::vector<OnDemandEvent>& events,
+    const std::list<OnDemandAction>& actions)
+{
+    auto strongManager = manager_.lock();
+    if (strongManager == nullptr || actions.empty()) {
+        return;
+    }
+    // consecutive actions of the same event still reach the manager as one list
+    auto iter = actions.begin();
+    while (iter != actions.end()) {
+        size_t eventIndex = iter->eventIndex;
+        std::list<SaControlInfo> saControlList;
+        while (iter != actions.end() && iter->eventIndex == eventIndex) {
+            saControlList.push_back(iter->saControl);
+            ++iter;
+        }
+        strongManager->ProcessOnDemandEvent(events[eventIndex], saControlList);
+    }
 }
 
 void DeviceStatusCollectManager::PostTask(std::function<void()> callback)
@@ -591,6 +727,8 @@ int32_t DeviceStatusCollectManager::UpdateOnDemandEvents(int32_t systemAbilityId
         HILOGE("UpdateOnDemandEvents policy types");
         return ERR_INVALID_VALUE;
     }
+    RemoveEventIndexLocked(systemAbilityId, type, oldEvents);
+    AddEventIndexLocked(*iter, static_cast<size_t>(std::distance(onDemandSaProfiles_.begin(), iter)), type);
     PersistOnDemandEvent(systemAbilityId, type, events);
     if (RemoveUnusedEventsLocked(oldEvents) != ERR_OK) {
         HILOGE("RemoveUnusedEventsLocked failed saId:%{public}d", systemAbilityId);
@@ -602,4 +740,20 @@ const std::vector<int32_t>& DeviceStatusCollectManager::GetLowMemPrepareList()
 {
     return collectPluginMap_[PARAM]->GetLowMemPrepareList();
 }
+
+void DeviceStatusCollectManager::OnSystemAbilityAdded(int32_t systemAbilityId)
+{
+    if (IsExistInPluginMap(UNREF_EVENT) != ERR_OK) {
+        return;
+    }
+    collectPluginMap_[UNREF_EVENT]->OnSystemAbilityAdded(systemAbilityId);
+}
+
+void DeviceStatusCollectManager::OnSystemAbilityRemoved(int32_t systemAbilityId)
+{
+    if (IsExistInPluginMap(UNREF_EVENT) != ERR_OK) {
+        return;
+    }
+    collectPluginMap_[UNREF_EVENT]->OnSystemAbilityRemoved(systemAbilityId);
+}
 }  // namespace OHOS
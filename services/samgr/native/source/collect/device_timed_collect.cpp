@@ -16,6 +16,7 @@
 #include "device_timed_collect.h"
 
 #include <algorithm>
+#include <ctime>
 
 #ifdef PREFERENCES_ENABLE
 #include "preferences_errno.h"
@@ -37,10 +38,13 @@ constexpr const char* AWAKE_LOOP_EVENT = "awakeloopevent";
 constexpr const char* ORDER_TIMED_EVENT = "timedevent";
 constexpr int32_t MIN_INTERVAL = 30;
 constexpr int32_t MIN_AWAKE_INTERVAL = 3600;
+constexpr int64_t MS_PER_SECOND = 1000;
+// events due this close to each other are reported by the same wakeup
+constexpr int64_t COALESCE_WINDOW_MS = 1000;
 }
 
 DeviceTimedCollect::DeviceTimedCollect(const sptr<IReport>& report)
-    : ICollectPlugin(report)
+    : ICollectPlugin(report), normalQueue_(COALESCE_WINDOW_MS), awakeQueue_(COALESCE_WINDOW_MS)
 {
 }
 
@@ -91,25 +95,15 @@ void DeviceTimedCollect::ProcessPersistenceTimedTask(int64_t disTime, std::strin
         preferencesUtil_->Remove(timeString);
         return;
     }
-    auto timedTask = [this, timeString] () {
-        OnDemandEvent event = { TIMED_EVENT, ORDER_TIMED_EVENT, timeString, -1, true };
-        ReportEvent(event);
-        preferencesUtil_->Remove(timeString);
-    };
-    if (!SamgrTimeHandler::GetInstance()->PostTask(timedTask, disTime)) {
-        PostDelayTask(timedTask, disTime);
-    }
+    ScheduleTimedEvent({ 0, true, timeString }, disTime);
 #endif
 }
 
 void DeviceTimedCollect::ProcessPersistenceLoopTask(int64_t disTime, int64_t triggerTime, std::string strInterval)
 {
-    int64_t interval = atoi(strInterval.c_str());
-    {
-        lock_guard<samgr::mutex> autoLock(persitenceLoopEventSetLock_);
-        if (persitenceLoopTasks_.count(interval) > 0) {
-            return;
-        }
+    int32_t interval = atoi(strInterval.c_str());
+    if (IsTimedEventScheduled({ interval, true })) {
+        return;
     }
 #ifdef PREFERENCES_ENABLE
     int64_t currentTime = TimeUtils::GetTimestamp();
@@ -122,45 +116,39 @@ void DeviceTimedCollect::ProcessPersistenceLoopTask(int64_t disTime, int64_t tri
         HILOGW("interval is not true");
         return;
     }
-    auto task = [this, interval] () {
-        lock_guard<samgr::mutex> autoLock(persitenceLoopEventSetLock_);
-        if (persitenceLoopTasks_.find(interval) != persitenceLoopTasks_.end()) {
-            HILOGI("DeviceTimedCollect Persistence ReportEvent interval: %{public}" PRId64, interval);
-            ReportEventByTimeInfo(interval, true);
-            PostPersistenceDelayTask(persitenceLoopTasks_[interval], interval, interval);
-        } else {
-            HILOGI("DeviceTimedCollect Persistence interval %{public}" PRId64 " has been remove", interval);
-        }
-    };
-    {
-        lock_guard<samgr::mutex> autoLock(persitenceLoopEventSetLock_);
-        persitenceLoopTasks_[interval] = task;
-    }
     if (disTime <= 0) {
         ReportEventByTimeInfo(interval, true);
         // In order to enable the timer to start on time next time and make up for the missing time
         disTime = interval - abs(disTime) % interval;
-        PostPersistenceDelayTask(task, interval, disTime);
+        PostPersistenceDelayTask(interval, disTime);
     } else {
-        PostDelayTaskByTimeInfo(task, interval, disTime);
+        ScheduleTimedEvent({ interval, true }, disTime);
     }
 }
 
 void DeviceTimedCollect::ReportEventByTimeInfo(int32_t interval, bool persistence)
+{
+    std::vector<OnDemandEvent> events;
+    GetEventsByTimeInfo(interval, persistence, events);
+    if (!events.empty()) {
+        ReportEvents(events);
+    }
+}
+
+void DeviceTimedCollect::GetEventsByTimeInfo(int32_t interval, bool persistence, std::vector<OnDemandEvent>& events)
 {
     lock_guard<samgr::mutex> autoLock(timeInfosLock_);
-    if (timeInfos_.count(interval) == 0) {
+    auto iter = timeInfos_.find(interval);
+    if (iter == timeInfos_.end()) {
         return;
     }
-    if (timeInfos_[interval].normal) {
-        OnDemandEvent event = { TIMED_EVENT, LOOP_EVENT, to_string(interval), -1, persistence };
+    if (iter->second.normal) {
         HILOGI("report normal:%{public}d ,persistence:%{public}d", interval, persistence);
-        ReportEvent(event);
+        events.push_back({ TIMED_EVENT, LOOP_EVENT, to_string(interval), -1, persistence });
     }
-    if (timeInfos_[interval].awake) {
-        OnDemandEvent event = { TIMED_EVENT, AWAKE_LOOP_EVENT, to_string(interval), -1, persistence };
+    if (iter->second.awake) {
         HILOGI("report awake:%{public}d ,persistence:%{public}d", interval, persistence);
-        ReportEvent(event);
+        events.push_back({ TIMED_EVENT, AWAKE_LOOP_EVENT, to_string(interval), -1, persistence });
     }
 }
 
@@ -208,67 +196,163 @@ void DeviceTimedCollect::SaveTimedEvent(const OnDemandEvent& onDemandEvent)
 
 void DeviceTimedCollect::PostPersistenceLoopTaskLocked(int32_t interval)
 {
-    if (persitenceLoopTasks_.count(interval) > 0) {
+    if (IsTimedEventScheduled({ interval, true })) {
         return;
     }
-    persitenceLoopTasks_[interval] = [this, interval] () {
-        lock_guard<samgr::mutex> autoLock(persitenceLoopEventSetLock_);
-        if (persitenceLoopTasks_.find(interval) != persitenceLoopTasks_.end()) {
-            HILOGI("DeviceTimedCollect PostPersistence ReportEvent interval: %{public}d", interval);
-            ReportEventByTimeInfo(interval, true);
-            PostPersistenceDelayTask(persitenceLoopTasks_[interval], interval, interval);
-        } else {
-            HILOGI("DeviceTimedCollect PostPersistence interval %{public}d has been remove", interval);
-        }
-    };
-    PostPersistenceDelayTask(persitenceLoopTasks_[interval], interval, interval);
+    PostPersistenceDelayTask(interval, interval);
 }
 
 void DeviceTimedCollect::PostNonPersistenceLoopTaskLocked(int32_t interval)
 {
-    if (nonPersitenceLoopTasks_.count(interval) > 0) {
+    if (IsTimedEventScheduled({ interval, false })) {
         HILOGE("DeviceTimedCollect interval has been post");
         return;
     }
-    nonPersitenceLoopTasks_[interval] = [this, interval] () {
-        lock_guard<samgr::mutex> autoLock(nonPersitenceLoopEventSetLock_);
-        if (nonPersitenceLoopEventSet_.find(interval) != nonPersitenceLoopEventSet_.end()) {
-            HILOGI("DeviceTimedCollect ReportEvent interval: %{public}d", interval);
-            ReportEventByTimeInfo(interval, false);
-            PostDelayTaskByTimeInfo(nonPersitenceLoopTasks_[interval], interval, interval);
-        } else {
-            HILOGI("DeviceTimedCollect interval %{public}d has been remove", interval);
+    ScheduleTimedEvent({ interval, false }, interval);
+}
+
+void DeviceTimedCollect::PostPersistenceDelayTask(int32_t interval, int32_t disTime)
+{
+#ifdef PREFERENCES_ENABLE
+    SavePersistenceTriggerTime(interval, disTime);
+    ScheduleTimedEvent({ interval, true }, disTime);
+#endif
+}
+
+void DeviceTimedCollect::SavePersistenceTriggerTime(int32_t interval, int64_t disTime)
+{
+#ifdef PREFERENCES_ENABLE
+    int64_t currentTime = TimeUtils::GetTimestamp();
+    int64_t upgradeTime = currentTime + disTime;
+    preferencesUtil_->SaveLong(to_string(interval), upgradeTime);
+    HILOGI("save persistence time %{public}d, interval time %{public}d", static_cast<int32_t>(upgradeTime), interval);
+#endif
+}
+
+int64_t DeviceTimedCollect::GetBootTimeMs()
+{
+    // boot time keeps counting while suspended, the same clock the awake timers use
+    struct timespec ts = { 0, 0 };
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * MS_PER_SECOND + ts.tv_nsec / (MS_PER_SECOND * MS_PER_SECOND);
+}
+
+bool DeviceTimedCollect::ScheduleTimedEvent(const TimedEventKey& key, int64_t delayTime)
+{
+    lock_guard<samgr::mutex> autoLock(timerLock_);
+    return ScheduleTimedEventLocked(key, GetBootTimeMs() + delayTime * MS_PER_SECOND);
+}
+
+bool DeviceTimedCollect::ScheduleTimedEventLocked(const TimedEventKey& key, int64_t deadline)
+{
+    // order timed events always need to wake the device, loop events only when configured as awake
+    bool awake = true;
+    if (key.interval > 0) {
+        lock_guard<samgr::mutex> autoLock(timeInfosLock_);
+        auto iter = timeInfos_.find(key.interval);
+        if (iter == timeInfos_.end()) {
+            return false;
         }
-    };
-    PostDelayTaskByTimeInfo(nonPersitenceLoopTasks_[interval], interval, interval);
+        awake = iter->second.awake;
+    }
+    (awake ? normalQueue_ : awakeQueue_).Cancel(key);
+    (awake ? awakeQueue_ : normalQueue_).Schedule(key, deadline);
+    ArmWakeupLocked(awake, GetBootTimeMs());
+    return true;
 }
 
-void DeviceTimedCollect::PostDelayTaskByTimeInfo(std::function<void()> callback,
-    int32_t interval, int32_t disTime)
+void DeviceTimedCollect::CancelTimedEvent(const TimedEventKey& key)
 {
-    lock_guard<samgr::mutex> autoLock(timeInfosLock_);
-    if (timeInfos_.count(interval) == 0) {
+    // a wakeup armed for the cancelled event stays posted and finds nothing due,
+    // unless it was the last awake event and its alarm can go
+    lock_guard<samgr::mutex> autoLock(timerLock_);
+    normalQueue_.Cancel(key);
+    if (awakeQueue_.Cancel(key) && awakeQueue_.Size() == 0 &&
+        SamgrTimeHandler::GetInstance()->CancelTask(awakeTaskId_)) {
+        awakeArmedDeadline_ = -1;
+    }
+}
+
+bool DeviceTimedCollect::IsTimedEventScheduled(const TimedEventKey& key)
+{
+    lock_guard<samgr::mutex> autoLock(timerLock_);
+    return normalQueue_.Contains(key) || awakeQueue_.Contains(key);
+}
+
+void DeviceTimedCollect::ArmWakeupLocked(bool awake, int64_t now)
+{
+    const TimedEventQueue& queue = awake ? awakeQueue_ : normalQueue_;
+    int64_t& armedDeadline = awake ? awakeArmedDeadline_ : normalArmedDeadline_;
+    int64_t deadline = queue.NextDeadline();
+    if (deadline < 0 || (armedDeadline >= 0 && armedDeadline <= deadline)) {
         return;
     }
-    if (timeInfos_[interval].awake) {
-        if (!SamgrTimeHandler::GetInstance()->PostTask(callback, disTime)) {
-            PostDelayTask(callback, disTime);
+    armedDeadline = deadline;
+    int64_t delayTime = (std::max<int64_t>(deadline - now, 0) + MS_PER_SECOND - 1) / MS_PER_SECOND;
+    auto wakeup = [this, awake, deadline] () {
+        OnTimerExpired(awake, deadline);
+    };
+    if (awake && delayTime > 0) {
+        // the earlier alarm takes over from the one armed before, if that is still pending
+        SamgrTimeHandler::GetInstance()->CancelTask(awakeTaskId_);
+        if (SamgrTimeHandler::GetInstance()->PostTask(wakeup, delayTime, awakeTaskId_)) {
+            return;
         }
-    } else {
-        PostDelayTask(callback, disTime);
+    }
+    PostDelayTask(wakeup, static_cast<int32_t>(delayTime));
+}
+
+void DeviceTimedCollect::OnTimerExpired(bool awake, int64_t armedDeadline)
+{
+    std::vector<OnDemandEvent> events;
+    {
+        lock_guard<samgr::mutex> autoLock(timerLock_);
+        int64_t& currentArmed = awake ? awakeArmedDeadline_ : normalArmedDeadline_;
+        if (currentArmed == armedDeadline) {
+            currentArmed = -1;
+        }
+        // the device is up now, so whatever is due on either queue rides along
+        int64_t now = GetBootTimeMs();
+        std::vector<DueTimedEvent> dueEvents;
+        normalQueue_.PopDue(now, dueEvents);
+        awakeQueue_.PopDue(now, dueEvents);
+        for (const auto& dueEvent : dueEvents) {
+            ProcessDueEventLocked(dueEvent, now, events);
+        }
+        ArmWakeupLocked(false, now);
+        ArmWakeupLocked(true, now);
+        HILOGI("DeviceTimedCollect wakeup awake:%{public}d, due:%{public}zu, events:%{public}zu",
+            awake, dueEvents.size(), events.size());
+    }
+    if (!events.empty()) {
+        ReportEvents(events);
     }
 }
 
-void DeviceTimedCollect::PostPersistenceDelayTask(std::function<void()> postTask,
-    int32_t interval, int32_t disTime)
+void DeviceTimedCollect::ProcessDueEventLocked(const DueTimedEvent& dueEvent, int64_t now,
+    std::vector<OnDemandEvent>& events)
 {
+    const TimedEventKey& key = dueEvent.key;
+    if (key.interval == 0) {
+        events.push_back({ TIMED_EVENT, ORDER_TIMED_EVENT, key.timeString, -1, key.persistence });
 #ifdef PREFERENCES_ENABLE
-    int64_t currentTime = TimeUtils::GetTimestamp();
-    int64_t upgradeTime = currentTime + static_cast<int64_t>(disTime);
-    preferencesUtil_->SaveLong(to_string(interval), upgradeTime);
-    PostDelayTaskByTimeInfo(postTask, interval, disTime);
-    HILOGI("save persistence time %{public}d, interval time %{public}d", static_cast<int32_t>(upgradeTime), interval);
+        if (key.persistence) {
+            preferencesUtil_->Remove(key.timeString);
+        }
 #endif
+        return;
+    }
+    GetEventsByTimeInfo(key.interval, key.persistence, events);
+    // keep the loop anchored to its own deadlines, unless it fell a whole interval behind
+    int64_t intervalMs = static_cast<int64_t>(key.interval) * MS_PER_SECOND;
+    int64_t nextDeadline = dueEvent.deadline + intervalMs;
+    if (nextDeadline <= now) {
+        nextDeadline = now + intervalMs;
+    }
+    if (key.persistence) {
+        SavePersistenceTriggerTime(key.interval, (nextDeadline - now) / MS_PER_SECOND);
+    }
+    ScheduleTimedEventLocked(key, nextDeadline);
 }
 
 int32_t DeviceTimedCollect::OnStart()
@@ -320,33 +404,20 @@ void DeviceTimedCollect::PostPersistenceTimedTaskLocked(std::string timeString,
         HILOGE("PostPersistenceTimedTask invalid timeGap: %{public}" PRId64 "ms", timeGap);
         return;
     }
-    auto timedTask = [this, timeString] () {
-        OnDemandEvent event = { TIMED_EVENT, ORDER_TIMED_EVENT, timeString, -1, true };
-        ReportEvent(event);
-        preferencesUtil_->Remove(timeString);
-    };
     int64_t currentTime = TimeUtils::GetTimestamp();
     int64_t upgradeTime = currentTime + timeGap;
     preferencesUtil_->SaveLong(timeString, upgradeTime);
-    if (!SamgrTimeHandler::GetInstance()->PostTask(timedTask, timeGap)) {
-        PostDelayTask(timedTask, timeGap);
-    }
+    ScheduleTimedEvent({ 0, true, timeString }, timeGap);
 #endif
 }
 
 void DeviceTimedCollect::PostNonPersistenceTimedTaskLocked(std::string timeString, int64_t timeGap)
 {
-    auto timedTask = [this, timeString] () {
-        OnDemandEvent event = { TIMED_EVENT, ORDER_TIMED_EVENT, timeString };
-        ReportEvent(event);
-    };
     if (timeGap <= 0) {
         HILOGE("PostNonPersistenceTimedTask invalid timeGap: %{public}" PRId64 "ms", timeGap);
         return;
     }
-    if (!SamgrTimeHandler::GetInstance()->PostTask(timedTask, timeGap)) {
-        PostDelayTask(timedTask, timeGap);
-    }
+    ScheduleTimedEvent({ 0, false, timeString }, timeGap);
 }
 
 int32_t DeviceTimedCollect::AddCollectEvent(const std::vector<OnDemandEvent>& events)
@@ -436,7 +507,7 @@ void DeviceTimedCollect::RemoveNonPersistenceLoopTask(int32_t interval)
     auto iter = nonPersitenceLoopEventSet_.find(interval);
     if (iter != nonPersitenceLoopEventSet_.end()) {
         nonPersitenceLoopEventSet_.erase(iter);
-        nonPersitenceLoopTasks_.erase(interval);
+        CancelTimedEvent({ interval, false });
     }
 }
 
@@ -446,7 +517,7 @@ void DeviceTimedCollect::RemovePersistenceLoopTask(int32_t interval)
     auto iter = persitenceLoopEventSet_.find(interval);
     if (iter != persitenceLoopEventSet_.end()) {
         persitenceLoopEventSet_.erase(iter);
-        persitenceLoopTasks_.erase(interval);
+        CancelTimedEvent({ interval, true });
     }
 }
 }
@@ -33,6 +33,15 @@ void ICollectPlugin::ReportEvent(const OnDemandEvent& event)
     }
 }
 
+void ICollectPlugin::ReportEvents(const std::vector<OnDemandEvent>& events)
+{
+    if (report_ != nullptr) {
+        report_->ReportEvents(events);
+    } else {
+        HILOGE("report_ is nullptr");
+    }
+}
+
 void ICollectPlugin::PostTask(std::function<void()> callback)
 {
     if (report_ != nullptr) {
@@ -15,14 +15,19 @@
 
 #include "ref_count_collect.h"
 
+#include <algorithm>
+
 namespace OHOS {
 namespace {
-constexpr int32_t REF_ONDEMAND_TIMER_INTERVAL = 1000 * 60 * 1;
+// polled this often right after an SA went idle, others in the same batch tend to follow
+constexpr uint32_t REF_ONDEMAND_MIN_INTERVAL = 1000 * 5;
+// the fixed poll period before the backoff, the poll starts here and an idle SA is never found later
+constexpr uint32_t REF_ONDEMAND_MAX_INTERVAL = 1000 * 60;
 }
 
 RefCountCollect::RefCountCollect(const sptr<IReport>& report,
     const std::weak_ptr<BaseSystemAbilityManager>& manager)
-    : ICollectPlugin(report, manager), timer_(nullptr) {}
+    : ICollectPlugin(report, manager), timer_(nullptr), pollInterval_(REF_ONDEMAND_MAX_INTERVAL) {}
 
 void RefCountCollect::Init(const std::list<SaProfile>& saProfiles)
 {
@@ -36,37 +41,94 @@ void RefCountCollect::Init(const std::list<SaProfile>& saProfiles)
 
 int32_t RefCountCollect::OnStart()
 {
-    uint32_t timerId = 0;
-    timer_ = std::make_unique<Utils::Timer>("RefCountCollectTimer");
-    timer_->Setup();
-
-    if (!unrefUnloadSaList_.empty()) {
-        timerId = timer_->Register(std::bind(&RefCountCollect::IdentifyUnrefOndemand, this),
-            REF_ONDEMAND_TIMER_INTERVAL);
-        HILOGI("RefCountCollect register ondemand timerId:%{public}u, interval:%{public}d",
-            timerId, REF_ONDEMAND_TIMER_INTERVAL);
+    if (unrefUnloadSaList_.empty()) {
+        return ERR_OK;
     }
+    auto timer = std::make_unique<Utils::Timer>("RefCountCollectTimer");
+    timer->Setup();
 
+    // SAs published before the plugin started never reach OnSystemAbilityAdded
+    auto strongManager = manager_.lock();
+    std::lock_guard<samgr::mutex> autoLock(pollLock_);
+    timer_ = std::move(timer);
+    for (const auto& saId : unrefUnloadSaList_) {
+        if (strongManager != nullptr && strongManager->PeekSystemAbility(saId) != nullptr) {
+            loadedUnrefSaSet_.insert(saId);
+        }
+    }
+    pollInterval_ = REF_ONDEMAND_MAX_INTERVAL;
+    SchedulePollLocked();
+    HILOGI("RefCountCollect start, loaded unref SA size:%{public}zu", loadedUnrefSaSet_.size());
     return ERR_OK;
 }
 
 int32_t RefCountCollect::OnStop()
 {
-    if (timer_ != nullptr) {
+    std::unique_ptr<Utils::Timer> timer;
+    {
+        std::lock_guard<samgr::mutex> autoLock(pollLock_);
+        timer = std::move(timer_);
+        timerId_ = 0;
+    }
+    // a running poll takes pollLock_, so shut down outside of it
+    if (timer != nullptr) {
         HILOGI("RefCountCollect stop timer");
-        timer_->Shutdown(true);
-        timer_.reset();
+        timer->Shutdown(true);
     }
     return ERR_OK;
 }
 
+bool RefCountCollect::IsUnrefUnloadSa(int32_t systemAbilityId) const
+{
+    return std::find(unrefUnloadSaList_.begin(), unrefUnloadSaList_.end(), systemAbilityId) !=
+        unrefUnloadSaList_.end();
+}
+
+void RefCountCollect::OnSystemAbilityAdded(int32_t systemAbilityId)
+{
+    if (!IsUnrefUnloadSa(systemAbilityId)) {
+        return;
+    }
+    std::lock_guard<samgr::mutex> autoLock(pollLock_);
+    loadedUnrefSaSet_.insert(systemAbilityId);
+    SchedulePollLocked();
+}
+
+void RefCountCollect::OnSystemAbilityRemoved(int32_t systemAbilityId)
+{
+    std::lock_guard<samgr::mutex> autoLock(pollLock_);
+    loadedUnrefSaSet_.erase(systemAbilityId);
+    if (loadedUnrefSaSet_.empty() && timer_ != nullptr && timerId_ != 0) {
+        timer_->Unregister(timerId_);
+        timerId_ = 0;
+    }
+    if (loadedUnrefSaSet_.empty()) {
+        pollInterval_ = REF_ONDEMAND_MAX_INTERVAL;
+    }
+}
+
+void RefCountCollect::SchedulePollLocked()
+{
+    if (timer_ == nullptr || timerId_ != 0 || loadedUnrefSaSet_.empty()) {
+        return;
+    }
+    timerId_ = timer_->Register(std::bind(&RefCountCollect::IdentifyUnrefOndemand, this), pollInterval_, true);
+    HILOGD("RefCountCollect register ondemand timerId:%{public}u, interval:%{public}u", timerId_, pollInterval_);
+}
+
 void RefCountCollect::IdentifyUnrefOndemand()
 {
+    std::set<int32_t> loadedSaSet;
+    {
+        std::lock_guard<samgr::mutex> autoLock(pollLock_);
+        timerId_ = 0;
+        loadedSaSet = loadedUnrefSaSet_;
+    }
     auto strongManager = manager_.lock();
     std::list<SaControlInfo> saControlList;
 
-    for (const auto& saId : unrefUnloadSaList_) {
-        sptr<IRemoteObject> object = strongManager != nullptr ? strongManager->CheckSystemAbility(saId) : nullptr;
+    for (const auto& saId : loadedSaSet) {
+        sptr<IRemoteObject> object = strongManager != nullptr ? strongManager->PeekSystemAbility(saId) : nullptr;
         if (object == nullptr) {
             continue;
         }
@@ -82,11 +144,21 @@ void RefCountCollect::IdentifyUnrefOndemand()
             saControlList.push_back(control);
         }
     }
-    if (saControlList.empty()) {
-        return;
+    {
+        std::lock_guard<samgr::mutex> autoLock(pollLock_);
+        // back off only while nothing is found, an SA that just went idle keeps the poll short
+        pollInterval_ = saControlList.empty() ? std::min(pollInterval_ * 2, REF_ONDEMAND_MAX_INTERVAL) :
+            REF_ONDEMAND_MIN_INTERVAL;
+        SchedulePollLocked();
     }
+    if (!saControlList.empty()) {
+        ReportUnrefOndemand(std::move(saControlList));
+    }
+}
 
-    if (strongManager == nullptr) {
+void RefCountCollect::ReportUnrefOndemand(std::list<SaControlInfo>&& saControlList)
+{
+    if (manager_.lock() == nullptr) {
         HILOGE("IdentifyUnrefOndemand manager is null");
         return;
     }
@@ -101,4 +173,4 @@ void RefCountCollect::IdentifyUnrefOndemand()
     };
     PostTask(callback);
 }
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -87,13 +87,6 @@ int32_t MultiSystemAbilityManager::StartDynamicSystemProcess(const std::u16strin
         + event.name + "#" + event.value + "#" + std::to_string(event.extraDataId) + "#"
         + std::to_string(userId_) + "#";
     auto extraArgv = eventStr.c_str();
-    if (abilityStateScheduler_ && !abilityStateScheduler_->IsSystemProcessNeverStartedLocked(name)) {
-        int ret = ServiceWaitForStatus(Str16ToStr8(name).c_str(), ServiceStatus::SERVICE_STOPPED, 1);
-        if (ret != 0) {
-            HILOGE("ServiceWaitForStatus proc:%{public}s,SA:%{public}d timeout",
-                Str16ToStr8(name).c_str(), systemAbilityId);
-        }
-    }
     int64_t begin = GetTickCount();
     int result = ERR_INVALID_VALUE;
     if (!IsInitBootFinished()) {
@@ -105,11 +98,6 @@ int32_t MultiSystemAbilityManager::StartDynamicSystemProcess(const std::u16strin
             ServiceAction::START, &extraArgv, 1);
     }
     int64_t duration = GetTickCount() - begin;
-    auto callingPid = IPCSkeleton::GetCallingPid();
-    auto callingUid = IPCSkeleton::GetCallingUid();
-    if (result != 0) {
-        ReportProcessStartFail(Str16ToStr8(name), callingPid, callingUid, "err:" + ToString(result));
-    }
     HILOGI("StartUserProc:%{public}s,SA:%{public}d,ret:%{public}d,%{public}" PRId64 "ms,uid:%{public}d",
         Str16ToStr8(name).c_str(), systemAbilityId, result, duration, userId_);
     return result;
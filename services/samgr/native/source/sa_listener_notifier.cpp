@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sa_listener_notifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "ffrt.h"
+#include "sam_log.h"
+#include "samgr_ipc_interface_code.h"
+
+namespace OHOS {
+namespace {
+constexpr int32_t ADD_CODE = static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION);
+constexpr int32_t REMOVE_CODE = static_cast<int32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION);
+}
+
+void SaListenerNotifier::Deliver(int32_t systemAbilityId, const std::string& deviceId, int32_t code,
+    const sptr<ISystemAbilityStatusChange>& listener)
+{
+    HILOGD("NotifySystemAbilityChanged, SA:%{public}d", systemAbilityId);
+    if (listener == nullptr) {
+        HILOGE("%{public}s listener null pointer!", __func__);
+        return;
+    }
+
+    switch (code) {
+        case ADD_CODE: {
+            listener->OnAddSystemAbility(systemAbilityId, deviceId);
+            break;
+        }
+        case REMOVE_CODE: {
+            listener->OnRemoveSystemAbility(systemAbilityId, deviceId);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void SaListenerNotifier::Notify(int32_t systemAbilityId, const std::string& deviceId, int32_t code,
+    const std::vector<ListenerNotifyTarget>& targets)
+{
+    std::vector<std::pair<IRemoteObject*, uint64_t>> drainKeys;
+    {
+        std::lock_guard<samgr::mutex> autoLock(queueLock_);
+        for (const auto& target : targets) {
+            if (target.listener == nullptr || target.listener->AsObject() == nullptr) {
+                continue;
+            }
+            IRemoteObject* key = target.listener->AsObject().GetRefPtr();
+            auto& queue = queues_[key];
+            if (queue.listener == nullptr) {
+                queue.listener = target.listener;
+                queue.generation = nextGeneration_++;
+                queue.metrics.callingPid = target.callingPid;
+            }
+            EnqueueLocked(queue, systemAbilityId, deviceId, code);
+            if (!queue.draining && !queue.events.empty()) {
+                queue.draining = true;
+                drainKeys.emplace_back(key, queue.generation);
+            }
+        }
+    }
+    for (const auto& [key, generation] : drainKeys) {
+        auto drainTask = [key = key, generation = generation, weakThis = weak_from_this()]() {
+            auto self = weakThis.lock();
+            if (self == nullptr) {
+                return;
+            }
+            self->Drain(key, generation);
+        };
+        ffrt::submit(drainTask);
+    }
+}
+
+void SaListenerNotifier::EnqueueLocked(ListenerQueue& queue, int32_t systemAbilityId,
+    const std::string& deviceId, int32_t code)
+{
+    // only the newest pending event of the same SA matters for coalescing
+    for (auto iter = queue.events.rbegin(); iter != queue.events.rend(); ++iter) {
+        if (iter->systemAbilityId != systemAbilityId || iter->deviceId != deviceId) {
+            continue;
+        }
+        if (iter->code == code) {
+            queue.metrics.coalescedCount++;
+            return;
+        }
+        if (iter->code == ADD_CODE && code == REMOVE_CODE) {
+            // the listener never saw this add, so neither event needs delivering
+            queue.events.erase(std::next(iter).base());
+            queue.metrics.coalescedCount += 2;
+            return;
+        }
+        break;
+    }
+    queue.events.push_back({systemAbilityId, deviceId, code});
+}
+
+void SaListenerNotifier::Drain(IRemoteObject* key, uint64_t generation)
+{
+    while (true) {
+        sptr<ISystemAbilityStatusChange> listener;
+        std::list<PendingEvent> events;
+        {
+            std::lock_guard<samgr::mutex> autoLock(queueLock_);
+            auto iter = queues_.find(key);
+            // a newer listener at the same address has its own drain task
+            if (iter == queues_.end() || iter->second.generation != generation) {
+                return;
+            }
+            if (iter->second.events.empty()) {
+                iter->second.draining = false;
+                return;
+            }
+            listener = iter->second.listener;
+            events.swap(iter->second.events);
+        }
+        uint64_t totalCostUs = 0;
+        uint64_t maxCostUs = 0;
+        for (const auto& event : events) {
+            auto begin = std::chrono::steady_clock::now();
+            Deliver(event.systemAbilityId, event.deviceId, event.code, listener);
+            uint64_t costUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - begin).count());
+            totalCostUs += costUs;
+            maxCostUs = std::max(maxCostUs, costUs);
+        }
+        std::lock_guard<samgr::mutex> autoLock(queueLock_);
+        auto iter = queues_.find(key);
+        if (iter == queues_.end() || iter->second.generation != generation) {
+            return;
+        }
+        auto& metrics = iter->second.metrics;
+        metrics.notifyCount += events.size();
+        metrics.totalCostUs += totalCostUs;
+        metrics.maxCostUs = std::max(metrics.maxCostUs, maxCostUs);
+    }
+}
+
+void SaListenerNotifier::RemoveListener(const sptr<IRemoteObject>& listener)
+{
+    if (listener == nullptr) {
+        return;
+    }
+    std::lock_guard<samgr::mutex> autoLock(queueLock_);
+    queues_.erase(listener.GetRefPtr());
+}
+
+size_t SaListenerNotifier::GetPendingCount()
+{
+    std::lock_guard<samgr::mutex> autoLock(queueLock_);
+    size_t count = 0;
+    for (const auto& [key, queue] : queues_) {
+        count += queue.events.size();
+    }
+    return count;
+}
+
+void SaListenerNotifier::GetMetrics(std::vector<ListenerNotifyMetrics>& metrics)
+{
+    std::lock_guard<samgr::mutex> autoLock(queueLock_);
+    for (const auto& [key, queue] : queues_) {
+        metrics.emplace_back(queue.metrics);
+    }
+}
+
+void SaListenerNotifier::Dump(std::string& result)
+{
+    std::vector<ListenerNotifyMetrics> metrics;
+    GetMetrics(metrics);
+    result.append("listener notify metrics, count:").append(std::to_string(metrics.size())).append("\n");
+    for (const auto& item : metrics) {
+        uint64_t avgCostUs = (item.notifyCount == 0) ? 0 : item.totalCostUs / item.notifyCount;
+        result.append("  callingPid:").append(std::to_string(item.callingPid))
+            .append(" notified:").append(std::to_string(item.notifyCount))
+            .append(" coalesced:").append(std::to_string(item.coalescedCount))
+            .append(" avgCostUs:").append(std::to_string(avgCostUs))
+            .append(" maxCostUs:").append(std::to_string(item.maxCostUs)).append("\n");
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sa_profile_cache.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sam_log.h"
+
+namespace OHOS {
+namespace {
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+constexpr uint32_t MAX_CACHE_ITEM_NUM = 100000;
+constexpr uint64_t MAX_CACHE_SIZE = 64 * 1024 * 1024;
+
+// converts to any member type, so T{AnyField{}...} compiles exactly up to the number of fields of T
+struct AnyField {
+    template <typename T>
+    operator T() const;
+};
+
+template <typename T, typename Seq, typename = void>
+struct IsBraceInitializable : std::false_type {};
+
+template <typename T, size_t... I>
+struct IsBraceInitializable<T, std::index_sequence<I...>, std::void_t<decltype(T { (void(I), AnyField {})... })>>
+    : std::true_type {};
+
+template <typename T, size_t N = 0>
+constexpr size_t GetFieldCount()
+{
+    if constexpr (IsBraceInitializable<T, std::make_index_sequence<N + 1>>::value) {
+        return GetFieldCount<T, N + 1>();
+    } else {
+        return N;
+    }
+}
+
+// fields of the cached structs per CACHE_VERSION, index is the version. CacheWriter encodes all of them
+// except SaProfile::handle, which is only set at runtime. A changed struct needs its fields encoded, a
+// CACHE_VERSION bump and a new entry here; published entries never change.
+constexpr size_t CACHED_FIELD_NUM[] = { 0, 37 };
+static_assert(std::size(CACHED_FIELD_NUM) == SaProfileCache::CACHE_VERSION + 1,
+    "add the field count of the new CACHE_VERSION to CACHED_FIELD_NUM");
+static_assert(GetFieldCount<OnDemandCondition>() + GetFieldCount<OnDemandEvent>() +
+    GetFieldCount<StartOnDemand>() + GetFieldCount<StopOnDemand>() + GetFieldCount<SaProfile>() ==
+    CACHED_FIELD_NUM[SaProfileCache::CACHE_VERSION],
+    "a cached struct changed: encode it in CacheWriter/CacheReader and bump SaProfileCache::CACHE_VERSION");
+
+bool IsWritableBySelfOnly(const struct stat& fileStat)
+{
+    return fileStat.st_uid == geteuid() && (fileStat.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+class CacheWriter {
+public:
+    template <typename T>
+    void Put(T value)
+    {
+        buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void PutBool(bool value)
+    {
+        Put<uint8_t>(value ? 1 : 0);
+    }
+
+    void PutString(const std::string& value)
+    {
+        Put<uint32_t>(static_cast<uint32_t>(value.size()));
+        buffer_.append(value);
+    }
+
+    void PutU16String(const std::u16string& value)
+    {
+        Put<uint32_t>(static_cast<uint32_t>(value.size()));
+        buffer_.append(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(char16_t));
+    }
+
+    void PutStringMap(const std::map<std::string, std::string>& values)
+    {
+        Put<uint32_t>(static_cast<uint32_t>(values.size()));
+        for (const auto& [key, value] : values) {
+            PutString(key);
+            PutString(value);
+        }
+    }
+
+    void PutEvents(const std::vector<OnDemandEvent>& events)
+    {
+        Put<uint32_t>(static_cast<uint32_t>(events.size()));
+        for (const auto& event : events) {
+            Put<int32_t>(event.eventId);
+            PutString(event.name);
+            PutString(event.value);
+            Put<int64_t>(event.extraDataId);
+            PutBool(event.persistence);
+            Put<uint32_t>(static_cast<uint32_t>(event.conditions.size()));
+            for (const auto& condition : event.conditions) {
+                Put<int32_t>(condition.eventId);
+                PutString(condition.name);
+                PutString(condition.value);
+                PutStringMap(condition.extraMessages);
+            }
+            PutBool(event.enableOnce);
+            Put<uint32_t>(event.loadPriority);
+            PutStringMap(event.extraMessages);
+        }
+    }
+
+    void PutProfile(const SaProfile& saProfile)
+    {
+        PutU16String(saProfile.process);
+        Put<int32_t>(saProfile.saId);
+        PutString(saProfile.libPath);
+        Put<uint32_t>(static_cast<uint32_t>(saProfile.dependSa.size()));
+        for (auto dependSa : saProfile.dependSa) {
+            Put<int32_t>(dependSa);
+        }
+        Put<int32_t>(saProfile.dependTimeout);
+        PutBool(saProfile.runOnCreate);
+        PutBool(saProfile.moduleUpdate);
+        PutBool(saProfile.autoRestart);
+        PutBool(saProfile.distributed);
+        Put<int32_t>(saProfile.dumpLevel);
+        Put<uint32_t>(saProfile.bootPhase);
+        PutBool(saProfile.startOnDemand.allowUpdate);
+        PutEvents(saProfile.startOnDemand.onDemandEvents);
+        PutBool(saProfile.stopOnDemand.allowUpdate);
+        PutBool(saProfile.stopOnDemand.unrefUnload);
+        Put<int32_t>(saProfile.stopOnDemand.delayTime);
+        Put<int32_t>(saProfile.stopOnDemand.unusedTimeout);
+        PutEvents(saProfile.stopOnDemand.onDemandEvents);
+        Put<int32_t>(saProfile.recycleStrategy);
+        Put<uint32_t>(static_cast<uint32_t>(saProfile.extension.size()));
+        for (const auto& extension : saProfile.extension) {
+            PutString(extension);
+        }
+        PutBool(saProfile.cacheCommonEvent);
+    }
+
+    const std::string& GetBuffer() const
+    {
+        return buffer_;
+    }
+
+private:
+    std::string buffer_;
+};
+
+// decodes straight out of the mapped file, every read is bounds checked
+class CacheReader {
+public:
+    CacheReader(const uint8_t* data, size_t size) : cur_(data), end_(data + size) {}
+
+    template <typename T>
+    bool Get(T& value)
+    {
+        if (static_cast<size_t>(end_ - cur_) < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, cur_, sizeof(T));
+        cur_ += sizeof(T);
+        return true;
+    }
+
+    bool GetBool(bool& value)
+    {
+        uint8_t raw = 0;
+        if (!Get(raw)) {
+            return false;
+        }
+        value = (raw != 0);
+        return true;
+    }
+
+    bool GetCount(uint32_t& count)
+    {
+        return Get(count) && count <= MAX_CACHE_ITEM_NUM;
+    }
+
+    bool GetString(std::string& value)
+    {
+        uint32_t size = 0;
+        if (!Get(size) || static_cast<size_t>(end_ - cur_) < size) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(cur_), size);
+        cur_ += size;
+        return true;
+    }
+
+    bool GetU16String(std::u16string& value)
+    {
+        uint32_t size = 0;
+        if (!Get(size) || static_cast<size_t>(end_ - cur_) / sizeof(char16_t) < size) {
+            return false;
+        }
+        value.resize(size);
+        memcpy(value.data(), cur_, size * sizeof(char16_t));
+        cur_ += size * sizeof(char16_t);
+        return true;
+    }
+
+    bool GetStringMap(std::map<std::string, std::string>& values)
+    {
+        uint32_t count = 0;
+        if (!GetCount(count)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            std::string key;
+            std::string value;
+            if (!GetString(key) || !GetString(value)) {
+                return false;
+            }
+            values.emplace(std::move(key), std::move(value));
+        }
+        return true;
+    }
+
+    bool GetCondition(OnDemandCondition& condition)
+    {
+        return Get(condition.eventId) && GetString(condition.name) && GetString(condition.value) &&
+            GetStringMap(condition.extraMessages);
+    }
+
+    bool GetEvent(OnDemandEvent& event)
+    {
+        uint32_t conditionCount = 0;
+        if (!Get(event.eventId) || !GetString(event.name) || !GetString(event.value) ||
+            !Get(event.extraDataId) || !GetBool(event.persistence) || !GetCount(conditionCount)) {
+            return false;
+        }
+        event.conditions.resize(conditionCount);
+        for (auto& condition : event.conditions) {
+            if (!GetCondition(condition)) {
+                return false;
+            }
+        }
+        return GetBool(event.enableOnce) && Get(event.loadPriority) && GetStringMap(event.extraMessages);
+    }
+
+    bool GetEvents(std::vector<OnDemandEvent>& events)
+    {
+        uint32_t count = 0;
+        if (!GetCount(count)) {
+            return false;
+        }
+        events.resize(count);
+        for (auto& event : events) {
+            if (!GetEvent(event)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool GetProfile(SaProfile& saProfile)
+    {
+        uint32_t dependCount = 0;
+        if (!GetU16String(saProfile.process) || !Get(saProfile.saId) || !GetString(saProfile.libPath) ||
+            !GetCount(dependCount)) {
+            return false;
+        }
+        saProfile.dependSa.resize(dependCount);
+        for (auto& dependSa : saProfile.dependSa) {
+            if (!Get(dependSa)) {
+                return false;
+            }
+        }
+        if (!Get(saProfile.dependTimeout) || !GetBool(saProfile.runOnCreate) ||
+            !GetBool(saProfile.moduleUpdate) || !GetBool(saProfile.autoRestart) ||
+            !GetBool(saProfile.distributed) || !Get(saProfile.dumpLevel) || !Get(saProfile.bootPhase)) {
+            return false;
+        }
+        if (!GetBool(saProfile.startOnDemand.allowUpdate) || !GetEvents(saProfile.startOnDemand.onDemandEvents)) {
+            return false;
+        }
+        auto& stopOnDemand = saProfile.stopOnDemand;
+        if (!GetBool(stopOnDemand.allowUpdate) || !GetBool(stopOnDemand.unrefUnload) ||
+            !Get(stopOnDemand.delayTime) || !Get(stopOnDemand.unusedTimeout) ||
+            !GetEvents(stopOnDemand.onDemandEvents)) {
+            return false;
+        }
+        uint32_t extensionCount = 0;
+        if (!Get(saProfile.recycleStrategy) || !GetCount(extensionCount)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < extensionCount; i++) {
+            std::string extension;
+            if (!GetString(extension)) {
+                return false;
+            }
+            saProfile.extension.emplace_back(std::move(extension));
+        }
+        return GetBool(saProfile.cacheCommonEvent);
+    }
+
+    bool IsEnd() const
+    {
+        return cur_ == end_;
+    }
+
+private:
+    const uint8_t* cur_;
+    const uint8_t* end_;
+};
+}
+
+uint64_t SaProfileCache::Hash(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+bool SaProfileCache::IsTrusted(const std::string& cachePath, int32_t fd)
+{
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || !IsWritableBySelfOnly(fileStat)) {
+        return false;
+    }
+    // whoever can write the directory can swap the file, so it must be just as restricted
+    size_t pos = cachePath.rfind('/');
+    std::string dirPath = (pos == std::string::npos) ? "." : cachePath.substr(0, (pos == 0) ? 1 : pos);
+    struct stat dirStat = {};
+    return stat(dirPath.c_str(), &dirStat) == 0 && S_ISDIR(dirStat.st_mode) && IsWritableBySelfOnly(dirStat);
+}
+
+uint64_t SaProfileCache::GetFingerprint(const std::vector<std::string>& files)
+{
+    uint64_t fingerprint = Hash(&CACHE_VERSION, sizeof(CACHE_VERSION), FNV_OFFSET_BASIS);
+    for (const auto& file : files) {
+        struct stat fileStat = {};
+        if (stat(file.c_str(), &fileStat) != 0) {
+            continue;
+        }
+        int64_t attrs[] = { static_cast<int64_t>(fileStat.st_size), static_cast<int64_t>(fileStat.st_ino),
+            static_cast<int64_t>(fileStat.st_mtim.tv_sec), static_cast<int64_t>(fileStat.st_mtim.tv_nsec) };
+        fingerprint = Hash(file.data(), file.size() + 1, fingerprint);
+        fingerprint = Hash(attrs, sizeof(attrs), fingerprint);
+    }
+    return fingerprint;
+}
+
+bool SaProfileCache::Load(const std::string& cachePath, uint64_t fingerprint, std::list<SaProfile>& saProfiles,
+    std::set<int32_t>& multiInstanceSaIds)
+{
+    int32_t fd = open(cachePath.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0) {
+        HILOGI("SaProfileCache no cache, errno:%{public}d", errno);
+        return false;
+    }
+    if (!IsTrusted(cachePath, fd)) {
+        HILOGW("SaProfileCache not owned by samgr or writable by others, ignored");
+        close(fd);
+        return false;
+    }
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(CacheHeader)) ||
+        static_cast<uint64_t>(fileStat.st_size) > MAX_CACHE_SIZE) {
+        HILOGW("SaProfileCache bad cache size");
+        close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        HILOGW("SaProfileCache mmap failed, errno:%{public}d", errno);
+        return false;
+    }
+    const uint8_t* data = static_cast<const uint8_t*>(mapped);
+    CacheHeader header;
+    memcpy(&header, data, sizeof(CacheHeader));
+    bool ret = false;
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION) {
+        HILOGI("SaProfileCache version mismatch:%{public}u", header.version);
+    } else if (header.fingerprint != fingerprint) {
+        HILOGI("SaProfileCache stale, profiles changed");
+    } else if (header.payloadSize != fileSize - sizeof(CacheHeader) ||
+        Hash(data + sizeof(CacheHeader), header.payloadSize, FNV_OFFSET_BASIS) != header.checksum) {
+        HILOGW("SaProfileCache corrupted");
+    } else {
+        ret = Decode(header, data + sizeof(CacheHeader), saProfiles, multiInstanceSaIds);
+    }
+    munmap(mapped, fileSize);
+    return ret;
+}
+
+bool SaProfileCache::Decode(const CacheHeader& header, const uint8_t* payload, std::list<SaProfile>& saProfiles,
+    std::set<int32_t>& multiInstanceSaIds)
+{
+    CacheReader reader(payload, header.payloadSize);
+    std::list<SaProfile> profiles;
+    for (uint32_t i = 0; i < header.profileCount; i++) {
+        SaProfile saProfile;
+        if (!reader.GetProfile(saProfile)) {
+            HILOGW("SaProfileCache decode profile failed");
+            return false;
+        }
+        profiles.emplace_back(std::move(saProfile));
+    }
+    std::set<int32_t> saIds;
+    for (uint32_t i = 0; i < header.multiInstanceCount; i++) {
+        int32_t saId = 0;
+        if (!reader.Get(saId)) {
+            return false;
+        }
+        saIds.insert(saId);
+    }
+    if (!reader.IsEnd()) {
+        HILOGW("SaProfileCache trailing data");
+        return false;
+    }
+    saProfiles.swap(profiles);
+    multiInstanceSaIds.swap(saIds);
+    return true;
+}
+
+bool SaProfileCache::Save(const std::string& cachePath, uint64_t fingerprint, const std::list<SaProfile>& saProfiles,
+    const std::set<int32_t>& multiInstanceSaIds)
+{
+    CacheWriter writer;
+    for (const auto& saProfile : saProfiles) {
+        writer.PutProfile(saProfile);
+    }
+    for (auto saId : multiInstanceSaIds) {
+        writer.Put<int32_t>(saId);
+    }
+    const std::string& payload = writer.GetBuffer();
+    CacheHeader header;
+    header.fingerprint = fingerprint;
+    header.profileCount = static_cast<uint32_t>(saProfiles.size());
+    header.multiInstanceCount = static_cast<uint32_t>(multiInstanceSaIds.size());
+    header.payloadSize = payload.size();
+    header.checksum = Hash(payload.data(), payload.size(), FNV_OFFSET_BASIS);
+
+    // write aside and rename, a reader never sees a half written cache
+    std::string tmpPath = cachePath + ".tmp";
+    int32_t fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        HILOGW("SaProfileCache open failed, errno:%{public}d", errno);
+        return false;
+    }
+    bool ret = write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+        write(fd, payload.data(), payload.size()) == static_cast<ssize_t>(payload.size()) && fsync(fd) == 0;
+    close(fd);
+    if (!ret || rename(tmpPath.c_str(), cachePath.c_str()) != 0) {
+        HILOGW("SaProfileCache write failed, errno:%{public}d", errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    HILOGI("SaProfileCache saved %{public}zu profiles, size:%{public}zu", saProfiles.size(), payload.size());
+    return true;
+}
+} // namespace OHOS
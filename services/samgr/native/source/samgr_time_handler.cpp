@@ -15,7 +15,9 @@
 
 #include "samgr_time_handler.h"
 #include "sam_log.h"
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 using namespace std;
 namespace OHOS {
@@ -23,6 +25,9 @@ namespace {
 constexpr uint32_t INIT_NUM = 4;
 constexpr uint32_t MAX_EVENT = 8;
 constexpr int32_t RETRY_TIMES = 3;
+constexpr int64_t NS_PER_SECOND = 1000 * 1000 * 1000;
+// keeps deadline arithmetic clear of overflow, far beyond any real delay
+constexpr uint64_t MAX_DELAY_SECONDS = 100ULL * 365 * 24 * 3600;
 }
 SamgrTimeHandler* volatile SamgrTimeHandler::singleton = nullptr;
 SamgrTimeHandler::Deletor SamgrTimeHandler::deletor;
@@ -45,60 +50,147 @@ SamgrTimeHandler::SamgrTimeHandler()
     epollfd = epoll_create(INIT_NUM);
     if (epollfd == -1) {
         HILOGE("SamgrTimeHandler epoll_create error");
+        return;
     }
+    timerfd_ = CreateAndRetry();
+    if (timerfd_ == -1) {
+        timerfd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (timerfd_ == -1) {
+            HILOGE("timerfd_create fail : %{public}s", strerror(errno));
+            return;
+        }
+        clockId_ = CLOCK_MONOTONIC;
+    }
+    epoll_event event {};
+    event.events = EPOLLIN | EPOLLWAKEUP;
+    event.data.fd = timerfd_;
+    if (epoll_ctl(epollfd, EPOLL_CTL_ADD, timerfd_, &event) == -1) {
+        HILOGE("epoll_ctl(EPOLL_CTL_ADD) failed : %{public}s", strerror(errno));
+        ::close(timerfd_);
+        timerfd_ = -1;
+    }
+}
+
+bool SamgrTimeHandler::StartThreadLocked()
+{
+    if (loopThread_.joinable()) {
+        return true;
+    }
+    loopThread_ = std::thread([this]() {
+        Loop();
+    });
+    return loopThread_.joinable();
 }
 
-void SamgrTimeHandler::StartThread()
+void SamgrTimeHandler::Loop()
 {
-    std::function<void()> func = [this]() {
-        HILOGI("SamgrTimeHandler thread start");
-        struct epoll_event events[MAX_EVENT];
-        while (!this->timeFunc.IsEmpty()) {
-            int number = epoll_wait(this->epollfd, events, MAX_EVENT, -1);
-            OnTime((*this), number, events);
+    HILOGI("SamgrTimeHandler thread start");
+    struct epoll_event events[MAX_EVENT];
+    while (true) {
+        int number = epoll_wait(epollfd, events, MAX_EVENT, -1);
+        if (number < 0 && errno != EINTR) {
+            HILOGE("SamgrTimeHandler epoll_wait failed : %{public}s", strerror(errno));
+        }
+        std::vector<TaskType> dueTasks;
+        {
+            lock_guard<samgr::mutex> autoLock(taskLock_);
+            if (stopped_) {
+                break;
+            }
+            OnTime(dueTasks);
+            ArmTimerLocked();
         }
-        HILOGI("SamgrTimeHandler thread end");
-    };
-    std::thread t(func);
-    t.detach();
+        if (!dueTasks.empty()) {
+            HILOGI("SamgrTimeHandler OnTime: %{public}zu", dueTasks.size());
+        }
+        // outside the lock, a task may post its successor
+        for (auto& task : dueTasks) {
+            task();
+        }
+    }
+    HILOGI("SamgrTimeHandler thread end");
 }
 
-void SamgrTimeHandler::OnTime(SamgrTimeHandler &handle, int number, struct epoll_event events[])
+void SamgrTimeHandler::OnTime(std::vector<TaskType>& dueTasks)
 {
-    if (number > 0) {
-        HILOGI("SamgrTimeHandler OnTime: %{public}d", number);
-    }
-    for (int i = 0; i < number; i++) {
-        uint32_t timerfd = events[i].data.u32;
-        uint64_t unused = 0;
-        HILOGI("SamgrTimeHandler timerfd: %{public}u", timerfd);
-        int ret = read(timerfd, &unused, sizeof(unused));
-        if (ret == sizeof(uint64_t)) {
-            TaskType funcTime;
-            bool hasFunction = handle.timeFunc.Find(timerfd, funcTime);
-            HILOGI("SamgrTimeHandler hasFunction: %{public}d", hasFunction);
-            funcTime();
-            handle.timeFunc.Erase(timerfd);
-            epoll_ctl(this->epollfd, EPOLL_CTL_DEL, timerfd, nullptr);
-            ::close(timerfd);
+    // non-blocking, the timer may have been re-armed since epoll_wait returned
+    uint64_t unused = 0;
+    if (read(timerfd_, &unused, sizeof(unused)) == sizeof(uint64_t)) {
+        armedTime_ = -1;
+    }
+    int64_t now = GetNowNs();
+    while (!deadlines_.empty() && deadlines_.top().time <= now) {
+        uint64_t taskId = deadlines_.top().taskId;
+        deadlines_.pop();
+        auto iter = tasks_.find(taskId);
+        if (iter == tasks_.end()) {
+            continue;
         }
+        dueTasks.emplace_back(std::move(iter->second));
+        tasks_.erase(iter);
+    }
+}
+
+void SamgrTimeHandler::ArmTimerLocked()
+{
+    while (!deadlines_.empty() && tasks_.count(deadlines_.top().taskId) == 0) {
+        deadlines_.pop();
+    }
+    int64_t nextTime = deadlines_.empty() ? -1 : deadlines_.top().time;
+    if (nextTime == armedTime_) {
+        return;
+    }
+    // an all-zero value disarms the timer, so a deadline of 0 is armed 1ns later
+    struct itimerspec newValue = {};
+    if (nextTime >= 0) {
+        newValue.it_value.tv_sec = nextTime / NS_PER_SECOND;
+        newValue.it_value.tv_nsec = std::max<int64_t>(nextTime % NS_PER_SECOND, (nextTime == 0) ? 1 : 0);
+    }
+    if (timerfd_settime(timerfd_, TFD_TIMER_ABSTIME, &newValue, nullptr) == -1) {
+        HILOGE("timerfd_settime failed : %{public}s", strerror(errno));
+        armedTime_ = -1;
+        return;
     }
+    armedTime_ = nextTime;
+}
+
+int64_t SamgrTimeHandler::GetNowNs() const
+{
+    // CLOCK_BOOTTIME_ALARM counts absolute time on CLOCK_BOOTTIME
+    struct timespec now = {};
+    clock_gettime((clockId_ == CLOCK_MONOTONIC) ? CLOCK_MONOTONIC : CLOCK_BOOTTIME, &now);
+    return static_cast<int64_t>(now.tv_sec) * NS_PER_SECOND + now.tv_nsec;
 }
 
 SamgrTimeHandler::~SamgrTimeHandler()
 {
-    auto closeFunc = [this](uint32_t fd) {
-        epoll_ctl(this->epollfd, EPOLL_CTL_DEL, fd, nullptr);
-        ::close(fd);
-    };
-    timeFunc.Clear(closeFunc);
-    ::close(epollfd);
+    {
+        lock_guard<samgr::mutex> autoLock(taskLock_);
+        stopped_ = true;
+        tasks_.clear();
+        if (timerfd_ != -1) {
+            // fire at once to get the thread out of epoll_wait
+            struct itimerspec newValue = {};
+            newValue.it_value.tv_nsec = 1;
+            timerfd_settime(timerfd_, 0, &newValue, nullptr);
+        }
+    }
+    if (loopThread_.joinable()) {
+        loopThread_.join();
+    }
+    if (timerfd_ != -1) {
+        epoll_ctl(epollfd, EPOLL_CTL_DEL, timerfd_, nullptr);
+        ::close(timerfd_);
+    }
+    if (epollfd != -1) {
+        ::close(epollfd);
+    }
 }
 
 int SamgrTimeHandler::CreateAndRetry()
 {
     for (int32_t i = 0; i < RETRY_TIMES; i++) {
-        int timerfd = timerfd_create(CLOCK_BOOTTIME_ALARM, 0);
+        int timerfd = timerfd_create(CLOCK_BOOTTIME_ALARM, TFD_NONBLOCK | TFD_CLOEXEC);
         if (timerfd != -1) {
             return timerfd;
         }
@@ -109,42 +201,48 @@ int SamgrTimeHandler::CreateAndRetry()
 
 bool SamgrTimeHandler::PostTask(TaskType func, uint64_t delayTime)
 {
+    uint64_t taskId = INVALID_TASK_ID;
+    return PostTask(std::move(func), delayTime, taskId);
+}
+
+bool SamgrTimeHandler::PostTask(TaskType func, uint64_t delayTime, uint64_t& taskId)
+{
+    taskId = INVALID_TASK_ID;
     if (!func) {
         HILOGE("SamgrTimeHandler PostTask failed, func is null");
         return false;
     }
-    HILOGI("SamgrTimeHandler postTask start: %{public}" PRId64 "s", delayTime);
-    int timerfd = CreateAndRetry();
-    if (timerfd == -1) {
-        timerfd = timerfd_create(CLOCK_MONOTONIC, 0);
-        if (timerfd == -1) {
-            HILOGE("timerfd_create fail : %{public}s", strerror(errno));
-            return false;
-        }
+    lock_guard<samgr::mutex> autoLock(taskLock_);
+    if (timerfd_ == -1 || stopped_) {
+        HILOGE("SamgrTimeHandler PostTask failed, timer unavailable");
+        return false;
     }
-    epoll_event event {};
-    event.events = EPOLLIN | EPOLLWAKEUP;
-    event.data.u32 = static_cast<uint32_t>(timerfd);
-    if (epoll_ctl(epollfd, EPOLL_CTL_ADD, timerfd, &event) == -1) {
-        HILOGE("epoll_ctl(EPOLL_CTL_ADD) failed : %{public}s", strerror(errno));
-        ::close(timerfd);
+    if (!StartThreadLocked()) {
+        HILOGE("SamgrTimeHandler PostTask failed, thread not started");
         return false;
     }
-    struct itimerspec newValue = {};
-    newValue.it_value.tv_sec = static_cast<int64_t>(delayTime);
-    newValue.it_value.tv_nsec = 0;
-    newValue.it_interval.tv_sec = 0;
-    newValue.it_interval.tv_nsec = 0;
+    int64_t deadline = GetNowNs() + static_cast<int64_t>(std::min(delayTime, MAX_DELAY_SECONDS)) * NS_PER_SECOND;
+    taskId = nextTaskId_++;
+    tasks_.emplace(taskId, std::move(func));
+    deadlines_.push({ deadline, taskId });
+    if (armedTime_ < 0 || deadline < armedTime_) {
+        ArmTimerLocked();
+    }
+    HILOGI("SamgrTimeHandler postTask: %{public}" PRIu64 "s, task:%{public}" PRIu64 ", pending:%{public}zu",
+        delayTime, taskId, tasks_.size());
+    return true;
+}
 
-    if (timerfd_settime(timerfd, 0, &newValue, NULL) == -1) {
-        HILOGE("timerfd_settime failed : %{public}s", strerror(errno));
-        ::close(timerfd);
+bool SamgrTimeHandler::CancelTask(uint64_t taskId)
+{
+    lock_guard<samgr::mutex> autoLock(taskLock_);
+    if (tasks_.erase(taskId) == 0) {
         return false;
     }
-    auto isFirst = timeFunc.FirstInsert(timerfd, func);
-    if (isFirst) {
-        StartThread();
+    // only re-arm when the earliest task went away, the rest is dropped lazily from the heap
+    if (!deadlines_.empty() && deadlines_.top().taskId == taskId) {
+        ArmTimerLocked();
     }
     return true;
 }
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
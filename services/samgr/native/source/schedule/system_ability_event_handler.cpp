@@ -66,7 +66,7 @@ int32_t SystemAbilityEventHandler::HandleProcessEventLocked(const std::shared_pt
         return ERR_INVALID_VALUE;
     }
     HILOGD("Scheduler proc:%{public}s handle proc event %{public}d start",
-        Str16ToStr8(context->processName).c_str(), event);
+        context->GetProcessNameStr8().c_str(), event);
     auto iter = processEventHandlerMap_.find(event);
     if (iter != processEventHandlerMap_.end()) {
         auto func = iter->second;
@@ -75,7 +75,7 @@ int32_t SystemAbilityEventHandler::HandleProcessEventLocked(const std::shared_pt
         }
     }
     HILOGE("Scheduler proc:%{public}s invalid proc event %{public}d",
-        Str16ToStr8(context->processName).c_str(), event);
+        context->GetProcessNameStr8().c_str(), event);
     return ERR_INVALID_VALUE;
 }
 
@@ -150,7 +150,7 @@ int32_t SystemAbilityEventHandler::HandleAbilityUnLoadSuccessEventLocked(
 int32_t SystemAbilityEventHandler::HandleProcessStartedEventLocked(
     const std::shared_ptr<SystemProcessContext>& context, const ProcessInfo& processInfo)
 {
-    HILOGI("Scheduler proc:%{public}s handle started event", Str16ToStr8(context->processName).c_str());
+    HILOGI("Scheduler proc:%{public}s handle started event", context->GetProcessNameStr8().c_str());
     context->pid = processInfo.pid;
     context->uid = processInfo.uid;
     int32_t result = ERR_OK;
@@ -161,7 +161,7 @@ int32_t SystemAbilityEventHandler::HandleProcessStartedEventLocked(
         default:
             result = ERR_INVALID_VALUE;
             HILOGE("Scheduler proc:%{public}s in state %{public}d,not need handle started event",
-                Str16ToStr8(context->processName).c_str(), context->state);
+                context->GetProcessNameStr8().c_str(), context->state);
             break;
     }
     return result;
@@ -170,7 +170,7 @@ int32_t SystemAbilityEventHandler::HandleProcessStartedEventLocked(
 int32_t SystemAbilityEventHandler::HandleProcessStoppedEventLocked(
     const std::shared_ptr<SystemProcessContext>& context, const ProcessInfo& processInfo)
 {
-    HILOGI("Scheduler proc:%{public}s handle stopped event", Str16ToStr8(context->processName).c_str());
+    HILOGI("Scheduler proc:%{public}s handle stopped event", context->GetProcessNameStr8().c_str());
     int32_t result = ERR_OK;
     switch (context->state) {
         case SystemProcessState::STARTED:
@@ -180,7 +180,7 @@ int32_t SystemAbilityEventHandler::HandleProcessStoppedEventLocked(
         default:
             result = ERR_INVALID_VALUE;
             HILOGE("Scheduler proc:%{public}s in state %{public}d,not need handle stopped event",
-                Str16ToStr8(context->processName).c_str(), context->state);
+                context->GetProcessNameStr8().c_str(), context->state);
             break;
     }
     return result;
@@ -86,12 +86,12 @@ bool SystemAbilityStateMachine::UpdateStateCount(const std::shared_ptr<SystemPro
     std::lock_guard<samgr::mutex> autoLock(context->stateCountLock);
     if (!context->abilityStateCountMap.count(fromState) || !context->abilityStateCountMap.count(toState)) {
         HILOGE("Scheduler proc:%{public}s invalid state",
-            Str16ToStr8(context->processName).c_str());
+            context->GetProcessNameStr8().c_str());
         return false;
     }
     if (context->abilityStateCountMap[fromState] <= 0) {
         HILOGE("Scheduler proc:%{public}s invalid current state count",
-            Str16ToStr8(context->processName).c_str());
+            context->GetProcessNameStr8().c_str());
         return false;
     }
     context->abilityStateCountMap[fromState]--;
@@ -118,17 +118,17 @@ int32_t SystemAbilityStateMachine::ProcessStateTransitionLocked(const std::share
     SystemProcessState currentState = context->state;
     if (currentState == nextState) {
         HILOGI("Scheduler proc:%{public}s state current %{public}d is same as next %{public}d",
-            Str16ToStr8(context->processName).c_str(), currentState, nextState);
+            context->GetProcessNameStr8().c_str(), currentState, nextState);
         return ERR_OK;
     }
     if (!handler->CanEnter(currentState)) {
         HILOGI("Scheduler proc:%{public}s can't state %{public}d to %{public}d",
-            Str16ToStr8(context->processName).c_str(), currentState, nextState);
+            context->GetProcessNameStr8().c_str(), currentState, nextState);
         return TRANSIT_PROC_STATE_FAIL;
     }
     context->state = nextState;
     HILOGD("Scheduler proc:%{public}s state %{public}d to %{public}d",
-        Str16ToStr8(context->processName).c_str(), currentState, nextState);
+        context->GetProcessNameStr8().c_str(), currentState, nextState);
     handler->OnEnter(context);
     return ERR_OK;
 }
@@ -104,6 +104,8 @@ void SystemAbilityStateScheduler::CleanResource()
 {
     std::unique_lock<samgr::shared_mutex> abiltyWriteLock(abiltyMapLock_);
     HILOGI("Scheduler CleanResource");
+    // readers may still hold the published table, so it is only retired here
+    contextTable_.store(nullptr, std::memory_order_release);
     abilityContextMap_.clear();
 }
 
@@ -117,6 +119,7 @@ void SystemAbilityStateScheduler::InitStateContext(const std::list<SaProfile>& s
         if (processContextMap_.count(saProfile.process) == 0) {
             auto processContext = std::make_shared<SystemProcessContext>();
             processContext->processName = saProfile.process;
+            processContext->processNameId = ProcessNameTable::GetInstance().Intern(saProfile.process);
             processContext->abilityStateCountMap[SystemAbilityState::NOT_LOADED] = 0;
             processContext->abilityStateCountMap[SystemAbilityState::LOADING] = 0;
             processContext->abilityStateCountMap[SystemAbilityState::LOADED] = 0;
@@ -162,6 +165,7 @@ void SystemAbilityStateScheduler::InitSamgrProcessContext()
 {
     auto processContext = std::make_shared<SystemProcessContext>();
     processContext->processName = SAMGR_PROCESS_NAME;
+    processContext->processNameId = ProcessNameTable::GetInstance().Intern(SAMGR_PROCESS_NAME);
     processContext->abilityStateCountMap[SystemAbilityState::NOT_LOADED] = 0;
     processContext->abilityStateCountMap[SystemAbilityState::LOADING] = 0;
     processContext->abilityStateCountMap[SystemAbilityState::LOADED] = 1;
@@ -174,7 +178,7 @@ void SystemAbilityStateScheduler::InitSamgrProcessContext()
     processContext->state = SystemProcessState::STARTED;
     {
         std::unique_lock<samgr::shared_mutex> autoLock(runningProcessListLock_);
-        SystemProcessInfo systemProcessInfo = {Str16ToStr8(processContext->processName), processContext->pid,
+        SystemProcessInfo systemProcessInfo = {processContext->GetProcessNameStr8(), processContext->pid,
             processContext->uid};
         runningProcessList_.emplace_back(std::move(systemProcessInfo));
     }
@@ -184,8 +188,23 @@ void SystemAbilityStateScheduler::InitSamgrProcessContext()
     abilityContext->isAutoRestart = false;
     abilityContext->delayUnloadTime = MAX_DELAY_TIME;
     abilityContext->ownProcessContext = processContextMap_[SAMGR_PROCESS_NAME];
+    {
+        std::unique_lock<samgr::shared_mutex> abiltyWriteLock(abiltyMapLock_);
+        abilityContextMap_[0] = abilityContext;
+    }
+    // samgr is the last context added, the contexts do not change from here on
+    SealContextTable();
+}
+
+void SystemAbilityStateScheduler::SealContextTable()
+{
+    std::shared_lock<samgr::shared_mutex> processReadLock(processMapLock_);
     std::unique_lock<samgr::shared_mutex> abiltyWriteLock(abiltyMapLock_);
-    abilityContextMap_[0] = abilityContext;
+    auto table = std::make_unique<const SystemAbilityContextTable>(abilityContextMap_, processContextMap_);
+    HILOGI("Scheduler seal context table, SA:%{public}zu, proc:%{public}zu",
+        table->GetAbilityCount(), table->GetProcessCount());
+    contextTable_.store(table.get(), std::memory_order_release);
+    contextTables_.emplace_back(std::move(table));
 }
 
 int32_t SystemAbilityStateScheduler::LimitDelayUnloadTime(int32_t delayUnloadTime)
@@ -202,12 +221,23 @@ int32_t SystemAbilityStateScheduler::LimitDelayUnloadTime(int32_t delayUnloadTim
 bool SystemAbilityStateScheduler::GetSystemAbilityContext(int32_t systemAbilityId,
     std::shared_ptr<SystemAbilityContext>& abilityContext)
 {
-    std::shared_lock<samgr::shared_mutex> readLock(abiltyMapLock_);
-    if (abilityContextMap_.count(systemAbilityId) == 0) {
-        HILOGD("Scheduler SA:%{public}d not in SA profiles", systemAbilityId);
-        return false;
+    const SystemAbilityContextTable* table = contextTable_.load(std::memory_order_acquire);
+    if (table != nullptr) {
+        auto slot = table->FindAbility(systemAbilityId);
+        if (slot == nullptr) {
+            HILOGD("Scheduler SA:%{public}d not in SA profiles", systemAbilityId);
+            return false;
+        }
+        abilityContext = *slot;
+    } else {
+        std::shared_lock<samgr::shared_mutex> readLock(abiltyMapLock_);
+        auto iter = abilityContextMap_.find(systemAbilityId);
+        if (iter == abilityContextMap_.end()) {
+            HILOGD("Scheduler SA:%{public}d not in SA profiles", systemAbilityId);
+            return false;
+        }
+        abilityContext = iter->second;
     }
-    abilityContext = abilityContextMap_[systemAbilityId];
     if (abilityContext == nullptr) {
         HILOGE("Scheduler SA:%{public}d context is null", systemAbilityId);
         return false;
@@ -263,12 +293,23 @@ void SystemAbilityStateScheduler::UpdateLimitDelayUnloadTimeTask(int32_t systemA
 bool SystemAbilityStateScheduler::GetSystemProcessContext(const std::u16string& processName,
     std::shared_ptr<SystemProcessContext>& processContext)
 {
-    std::shared_lock<samgr::shared_mutex> readLock(processMapLock_);
-    if (processContextMap_.count(processName) == 0) {
-        HILOGE("Scheduler proc:%{public}s invalid", Str16ToStr8(processName).c_str());
-        return false;
+    const SystemAbilityContextTable* table = contextTable_.load(std::memory_order_acquire);
+    if (table != nullptr) {
+        auto slot = table->FindProcess(processName);
+        if (slot == nullptr) {
+            HILOGE("Scheduler proc:%{public}s invalid", Str16ToStr8(processName).c_str());
+            return false;
+        }
+        processContext = *slot;
+    } else {
+        std::shared_lock<samgr::shared_mutex> readLock(processMapLock_);
+        auto iter = processContextMap_.find(processName);
+        if (iter == processContextMap_.end()) {
+            HILOGE("Scheduler proc:%{public}s invalid", Str16ToStr8(processName).c_str());
+            return false;
+        }
+        processContext = iter->second;
     }
-    processContext = processContextMap_[processName];
     if (processContext == nullptr) {
         HILOGE("Scheduler proc:%{public}s context is null", Str16ToStr8(processName).c_str());
         return false;
@@ -590,7 +631,7 @@ int32_t SystemAbilityStateScheduler::HandlePendingLoadOverflow(const std::shared
             std::lock_guard<samgr::mutex> autoLock(processContext->processLock);
             if (processContext->state != SystemProcessState::STOPPING) {
                 HILOGW("Scheduler proc:%{public}s state %{public}d",
-                    Str16ToStr8(processContext->processName).c_str(), processContext->state);
+                    processContext->GetProcessNameStr8().c_str(), processContext->state);
                 return;
             }
             abilityContext->pendingLoadEventList.clear();
@@ -598,20 +639,20 @@ int32_t SystemAbilityStateScheduler::HandlePendingLoadOverflow(const std::shared
             HILOGI("HandlePendingLoadOverflow:clear SA:%{public}d pendingLoadEvent", abilityContext->systemAbilityId);
         }
         if (SamgrUtil::CheckSystemProcessStarted(processContext->processName)) {
-            auto result = ServiceControlWithExtra(Str16ToStr8(processContext->processName).c_str(),
+            auto result = ServiceControlWithExtra(processContext->GetProcessNameStr8().c_str(),
                 ServiceAction::STOP, nullptr, 0);
             KHILOGI("HandlePendingLoadOverflow:%{public}s kill pid:%{public}d_%{public}d",
-                Str16ToStr8(processContext->processName).c_str(), processContext->pid, result);
+                processContext->GetProcessNameStr8().c_str(), processContext->pid, result);
         } else {
             auto obj = strongManager->GetSystemProcess(processContext->processName);
             if (obj == nullptr) {
                 KHILOGW("HandlePendingLoadOverflow:%{public}s is removed",
-                    Str16ToStr8(processContext->processName).c_str());
+                    processContext->GetProcessNameStr8().c_str());
                 return;
             }
             strongManager->RemoveSystemProcess(obj);
             KHILOGI("HandlePendingLoadOverflow:rmProc %{public}s",
-                Str16ToStr8(processContext->processName).c_str());
+                processContext->GetProcessNameStr8().c_str());
         }
     };
     bool ret = recoverHandler_->PostTask(task);
@@ -737,7 +778,7 @@ bool SystemAbilityStateScheduler::CanUnloadAllSystemAbilityLocked(
         }
     }
     HILOGI("Scheduler proc:%{public}s SA num:%{public}zu,notloaded:%{public}d,unloadable:%{public}d",
-        Str16ToStr8(processContext->processName).c_str(), processContext->saList.size(), notLoadAbilityCount,
+        processContext->GetProcessNameStr8().c_str(), processContext->saList.size(), notLoadAbilityCount,
         unloadableAbilityCount);
     return false;
 }
@@ -805,12 +846,12 @@ int32_t SystemAbilityStateScheduler::PostTryUnloadAllAbilityTask(
         int32_t ret = strong->TryUnloadAllSystemAbility(processContext);
         if (ret != ERR_OK) {
             HILOGE("Scheduler proc:%{public}s unload all SA fail",
-                Str16ToStr8(processContext->processName).c_str());
+                processContext->GetProcessNameStr8().c_str());
         }
     });
     if (!result) {
         HILOGW("Scheduler proc:%{public}s post task fail",
-            Str16ToStr8(processContext->processName).c_str());
+            processContext->GetProcessNameStr8().c_str());
         return ERR_INVALID_VALUE;
     }
     return ERR_OK;
@@ -825,7 +866,7 @@ int32_t SystemAbilityStateScheduler::PostUnloadTimeoutTask(const std::shared_ptr
             HILOGW("SystemAbilityStateScheduler is null");
             return;
         }
-        std::string name = KEY_UNLOAD_TIMEOUT + Str16ToStr8(processContext->processName);
+        std::string name = KEY_UNLOAD_TIMEOUT + processContext->GetProcessNameStr8();
         if (strong->processHandler_ != nullptr) {
             HILOGD("TimeoutTask deltask proc:%{public}s", name.c_str());
             strong->processHandler_->DelTask(name);
@@ -835,17 +876,16 @@ int32_t SystemAbilityStateScheduler::PostUnloadTimeoutTask(const std::shared_ptr
         std::lock_guard<samgr::mutex> autoLock(processContext->processLock);
         if (processContext->state == SystemProcessState::STOPPING) {
             HILOGW("Scheduler proc:%{public}s unload SA timeout",
-                Str16ToStr8(processContext->processName).c_str());
-            int32_t result = strong->KillSystemProcessLocked(processContext);
-            HILOGI("Scheduler proc:%{public}s kill proc timeout ret:%{public}d",
-                Str16ToStr8(processContext->processName).c_str(), result);
+                processContext->GetProcessNameStr8().c_str());
+            // the kill runs on the process executor, its result is logged there
+            (void)strong->KillSystemProcessLocked(processContext);
         }
     };
-    bool ret = processHandler_->PostTask(timeoutTask, KEY_UNLOAD_TIMEOUT + Str16ToStr8(processContext->processName),
+    bool ret = processHandler_->PostTask(timeoutTask, KEY_UNLOAD_TIMEOUT + processContext->GetProcessNameStr8(),
         UNLOAD_TIMEOUT_TIME);
     if (!ret) {
         HILOGW("Scheduler proc:%{public}s post timeout task fail",
-            Str16ToStr8(processContext->processName).c_str());
+            processContext->GetProcessNameStr8().c_str());
         return ERR_INVALID_VALUE;
     }
     return ERR_OK;
@@ -853,7 +893,7 @@ int32_t SystemAbilityStateScheduler::PostUnloadTimeoutTask(const std::shared_ptr
 
 void SystemAbilityStateScheduler::RemoveUnloadTimeoutTask(const std::shared_ptr<SystemProcessContext>& processContext)
 {
-    processHandler_->RemoveTask(KEY_UNLOAD_TIMEOUT + Str16ToStr8(processContext->processName));
+    processHandler_->RemoveTask(KEY_UNLOAD_TIMEOUT + processContext->GetProcessNameStr8());
 }
 
 int32_t SystemAbilityStateScheduler::PostTryKillProcessTask(
@@ -869,12 +909,12 @@ int32_t SystemAbilityStateScheduler::PostTryKillProcessTask(
         int32_t ret = strong->TryKillSystemProcess(processContext);
         if (ret != ERR_OK) {
             HILOGE("Scheduler proc:%{public}s kill proc fail",
-                Str16ToStr8(processContext->processName).c_str());
+                processContext->GetProcessNameStr8().c_str());
         }
     });
     if (!result) {
         HILOGW("Scheduler proc:%{public}s post task fail",
-            Str16ToStr8(processContext->processName).c_str());
+            processContext->GetProcessNameStr8().c_str());
         return ERR_INVALID_VALUE;
     }
     return ERR_OK;
@@ -883,7 +923,7 @@ int32_t SystemAbilityStateScheduler::PostTryKillProcessTask(
 int32_t SystemAbilityStateScheduler::UnloadAllSystemAbilityLocked(
     const std::shared_ptr<SystemProcessContext>& processContext)
 {
-    HILOGI("Scheduler proc:%{public}s unload all SA", Str16ToStr8(processContext->processName).c_str());
+    HILOGI("Scheduler proc:%{public}s unload all SA", processContext->GetProcessNameStr8().c_str());
     for (auto& saId : processContext->saList) {
         std::shared_ptr<SystemAbilityContext> abilityContext;
         if (!GetSystemAbilityContext(saId, abilityContext)) {
@@ -944,7 +984,7 @@ int32_t SystemAbilityStateScheduler::UnloadProcess(const std::vector<std::u16str
             if (ret != ERR_OK) {
                 result = ret;
                 HILOGI("Scheduler proc:%{public}s unload fail",
-                    Str16ToStr8(processContext->processName).c_str());
+                    processContext->GetProcessNameStr8().c_str());
             }
         }
     }
@@ -970,7 +1010,7 @@ int32_t SystemAbilityStateScheduler::UnloadAllIdleSystemAbility()
         if (ret != ERR_OK) {
             result = ret;
             HILOGI("Scheduler proc:%{public}s unload all SA fail",
-                Str16ToStr8(processContext->processName).c_str());
+                processContext->GetProcessNameStr8().c_str());
         }
     }
     return result;
@@ -1002,7 +1042,7 @@ bool SystemAbilityStateScheduler::CanKillSystemProcessLocked(
 {
     uint32_t notLoadAbilityCount = processContext->abilityStateCountMap[SystemAbilityState::NOT_LOADED];
     HILOGI("Scheduler proc:%{public}s,SA num:%{public}zu,notloaded num:%{public}d",
-        Str16ToStr8(processContext->processName).c_str(), processContext->saList.size(), notLoadAbilityCount);
+        processContext->GetProcessNameStr8().c_str(), processContext->saList.size(), notLoadAbilityCount);
     if (notLoadAbilityCount == processContext->saList.size()) {
         return true;
     }
@@ -1012,26 +1052,49 @@ bool SystemAbilityStateScheduler::CanKillSystemProcessLocked(
 int32_t SystemAbilityStateScheduler::KillSystemProcessLocked(
     const std::shared_ptr<SystemProcessContext>& processContext)
 {
-    int64_t begin = GetTickCount();
-    int32_t result = ERR_OK;
-    {
-        SamgrXCollie samgrXCollie("samgr--killProccess_" + Str16ToStr8(processContext->processName));
-        result = ServiceControlWithExtra(Str16ToStr8(processContext->processName).c_str(),
-            ServiceAction::STOP, nullptr, 0);
+    std::u16string processName = processContext->processName;
+    int32_t pid = processContext->pid;
+    int32_t uid = processContext->uid;
+    std::shared_ptr<SystemProcessExecutor> processExecutor;
+    auto strongManager = manager_.lock();
+    if (strongManager != nullptr) {
+        processExecutor = strongManager->GetSystemProcessExecutor();
     }
+    if (processExecutor == nullptr) {
+        int64_t begin = GetTickCount();
+        int32_t result = StopSystemProcess(processName);
+        OnSystemProcessStopped(processName, pid, uid, result, GetTickCount() - begin);
+        return result;
+    }
+    // the process leaves through its death notification, so nothing waits for init here
+    auto killRequest = [processName]() {
+        return StopSystemProcess(processName);
+    };
+    auto killCompletion = [processName, pid, uid](int32_t result, int64_t duration) {
+        OnSystemProcessStopped(processName, pid, uid, result, duration);
+    };
+    processExecutor->Submit(processName, killRequest, killCompletion);
+    return ERR_OK;
+}
+
+int32_t SystemAbilityStateScheduler::StopSystemProcess(const std::u16string& processName)
+{
+    const std::string& procName = ProcessNameTable::GetInstance().GetStr8(processName);
+    SamgrXCollie samgrXCollie("samgr--killProccess_" + procName);
+    return ServiceControlWithExtra(procName.c_str(), ServiceAction::STOP, nullptr, 0);
+}
 
-    int64_t duration = GetTickCount() - begin;
+void SystemAbilityStateScheduler::OnSystemProcessStopped(const std::u16string& processName, int32_t pid,
+    int32_t uid, int32_t result, int64_t duration)
+{
+    const std::string& procName = ProcessNameTable::GetInstance().GetStr8(processName);
     if (result != 0) {
-        ReportProcessStopFail(Str16ToStr8(processContext->processName), processContext->pid, processContext->uid,
-            "err:" + ToString(result));
+        ReportProcessStopFail(procName, pid, uid, "err:" + ToString(result));
     } else {
-        ReportProcessStopDuration(Str16ToStr8(processContext->processName), processContext->pid,
-            processContext->uid, duration);
+        ReportProcessStopDuration(procName, pid, uid, duration);
     }
     KHILOGI("Scheduler proc:%{public}s kill pid:%{public}d,%{public}d_%{public}d_"
-        "%{public}" PRId64 "ms", Str16ToStr8(processContext->processName).c_str(), processContext->pid,
-        processContext->uid, result, duration);
-    return result;
+        "%{public}" PRId64 "ms", procName.c_str(), pid, uid, result, duration);
 }
 
 bool SystemAbilityStateScheduler::CanRestartProcessLocked(const std::shared_ptr<SystemProcessContext>& processContext)
@@ -1053,7 +1116,7 @@ bool SystemAbilityStateScheduler::CanRestartProcessLocked(const std::shared_ptr<
         return true;
     } else {
         HILOGE("Scheduler proc:%{public}s unkown err",
-            Str16ToStr8(processContext->processName).c_str());
+            processContext->GetProcessNameStr8().c_str());
     }
     return false;
 }
@@ -1102,7 +1165,7 @@ int32_t SystemAbilityStateScheduler::HandleAbnormallyDiedAbilityLocked(
     }
     if (!CanRestartProcessLocked(processContext)) {
         HILOGW("Scheduler proc:%{public}s can't restart:More than 4 restarts in 20s",
-            Str16ToStr8(processContext->processName).c_str());
+            processContext->GetProcessNameStr8().c_str());
         return ERR_OK;
     }
     OnDemandEvent onDemandEvent = {INTERFACE_CALL, "restart"};
@@ -1125,7 +1188,7 @@ void SystemAbilityStateScheduler::NotifyProcessStarted(const std::shared_ptr<Sys
     std::shared_lock<samgr::shared_mutex> readLock(listenerSetLock_);
     for (auto& listener : processListeners_) {
         if (listener->AsObject() != nullptr) {
-            SystemProcessInfo systemProcessInfo = {Str16ToStr8(processContext->processName), processContext->pid,
+            SystemProcessInfo systemProcessInfo = {processContext->GetProcessNameStr8(), processContext->pid,
                 processContext->uid};
             listener->OnSystemProcessStarted(systemProcessInfo);
         }
@@ -1137,7 +1200,7 @@ void SystemAbilityStateScheduler::NotifyProcessStopped(const std::shared_ptr<Sys
     std::shared_lock<samgr::shared_mutex> readLock(listenerSetLock_);
     for (auto& listener : processListeners_) {
         if (listener->AsObject() != nullptr) {
-            SystemProcessInfo systemProcessInfo = {Str16ToStr8(processContext->processName), processContext->pid,
+            SystemProcessInfo systemProcessInfo = {processContext->GetProcessNameStr8(), processContext->pid,
                 processContext->uid};
             listener->OnSystemProcessStopped(systemProcessInfo);
         }
@@ -1149,13 +1212,13 @@ void SystemAbilityStateScheduler::NotifyProcessActivated(const std::shared_ptr<S
     std::lock_guard<samgr::mutex> autoLock(procListenerMapLock_);
     for (auto& listener : procListenerMap_[processContext->processName]) {
         if (listener->AsObject() != nullptr) {
-            SystemProcessInfo systemProcessInfo = {Str16ToStr8(processContext->processName), processContext->pid,
+            SystemProcessInfo systemProcessInfo = {processContext->GetProcessNameStr8(), processContext->pid,
                 processContext->uid};
-            HILOGD("Scheduler proc:%{public}s Activated", Str16ToStr8(processContext->processName).c_str());
+            HILOGD("Scheduler proc:%{public}s Activated", processContext->GetProcessNameStr8().c_str());
             listener->OnSystemProcessActivated(systemProcessInfo);
         }
     }
-    HILOGD("process %{public}s is active", Str16ToStr8(processContext->processName).c_str());
+    HILOGD("process %{public}s is active", processContext->GetProcessNameStr8().c_str());
 }
 
 void SystemAbilityStateScheduler::NotifyProcessIdled(const std::shared_ptr<SystemProcessContext>& processContext)
@@ -1163,18 +1226,18 @@ void SystemAbilityStateScheduler::NotifyProcessIdled(const std::shared_ptr<Syste
     std::lock_guard<samgr::mutex> autoLock(procListenerMapLock_);
     for (auto& listener : procListenerMap_[processContext->processName]) {
         if (listener->AsObject() != nullptr) {
-            SystemProcessInfo systemProcessInfo = {Str16ToStr8(processContext->processName), processContext->pid,
+            SystemProcessInfo systemProcessInfo = {processContext->GetProcessNameStr8(), processContext->pid,
                 processContext->uid};
-            HILOGD("Scheduler proc:%{public}s Idled", Str16ToStr8(processContext->processName).c_str());
+            HILOGD("Scheduler proc:%{public}s Idled", processContext->GetProcessNameStr8().c_str());
             listener->OnSystemProcessIdled(systemProcessInfo);
         }
     }
-    HILOGD("process %{public}s is idle", Str16ToStr8(processContext->processName).c_str());
+    HILOGD("process %{public}s is idle", processContext->GetProcessNameStr8().c_str());
 }
 
 void SystemAbilityStateScheduler::OnProcessStartedLocked(const std::u16string& processName)
 {
-    HILOGI("Scheduler proc:%{public}s started", Str16ToStr8(processName).c_str());
+    HILOGI("Scheduler proc:%{public}s started", ProcessNameTable::GetInstance().GetStr8(processName).c_str());
     std::shared_ptr<SystemProcessContext> processContext;
     if (!GetSystemProcessContext(processName, processContext)) {
         return;
@@ -1184,7 +1247,7 @@ void SystemAbilityStateScheduler::OnProcessStartedLocked(const std::u16string& p
 
 void SystemAbilityStateScheduler::OnProcessNotStartedLocked(const std::u16string& processName)
 {
-    HILOGI("Scheduler proc:%{public}s stopped", Str16ToStr8(processName).c_str());
+    HILOGI("Scheduler proc:%{public}s stopped", ProcessNameTable::GetInstance().GetStr8(processName).c_str());
     std::shared_ptr<SystemProcessContext> processContext;
     if (!GetSystemProcessContext(processName, processContext)) {
         return;
@@ -1260,7 +1323,7 @@ void SystemAbilityStateScheduler::OnAbilityLoadedLocked(int32_t systemAbilityId)
     }
     if (abilityContext->ownProcessContext && IsProcessActivatedLocked(abilityContext->ownProcessContext)) {
         HILOGI(
-            "Scheduler proc:%{public}s activated", Str16ToStr8(abilityContext->ownProcessContext->processName).c_str());
+            "Scheduler proc:%{public}s activated", abilityContext->ownProcessContext->GetProcessNameStr8().c_str());
         NotifyProcessActivated(abilityContext->ownProcessContext);
     }
 }
@@ -1274,7 +1337,7 @@ void SystemAbilityStateScheduler::OnAbilityUnloadableLocked(int32_t systemAbilit
     }
     // the transition can only be: LOADED -> UNLOADABLE
     if (abilityContext->ownProcessContext && IsProcessIdledLocked(abilityContext->ownProcessContext)) {
-        HILOGI("Scheduler proc:%{public}s idled", Str16ToStr8(abilityContext->ownProcessContext->processName).c_str());
+        HILOGI("Scheduler proc:%{public}s idled", abilityContext->ownProcessContext->GetProcessNameStr8().c_str());
         NotifyProcessIdled(abilityContext->ownProcessContext);
     }
     PostTryUnloadAllAbilityTask(abilityContext->ownProcessContext);
@@ -1291,7 +1354,7 @@ int32_t SystemAbilityStateScheduler::GetSystemProcessInfo(int32_t systemAbilityI
     }
     std::shared_ptr<SystemProcessContext> processContext = abilityContext->ownProcessContext;
     std::lock_guard<samgr::mutex> autoLock(processContext->processLock);
-    systemProcessInfo = {Str16ToStr8(processContext->processName), processContext->pid,
+    systemProcessInfo = {processContext->GetProcessNameStr8(), processContext->pid,
                 processContext->uid};
     return ERR_OK;
 }
@@ -1338,36 +1401,68 @@ int32_t SystemAbilityStateScheduler::GetProcessNameByProcessId(int32_t pid, std:
 }
 
 void SystemAbilityStateScheduler::GetAllSystemAbilityInfo(std::string& result)
+{
+    std::vector<SystemAbilityDumpInfo> dumpInfos;
+    GetAllSystemAbilityDumpInfo(dumpInfos);
+    for (const auto& dumpInfo : dumpInfos) {
+        FormatSystemAbilityDumpInfo(dumpInfo, result);
+    }
+}
+
+void SystemAbilityStateScheduler::GetAllSystemAbilityDumpInfo(std::vector<SystemAbilityDumpInfo>& dumpInfos)
 {
     std::shared_lock<samgr::shared_mutex> readLock(abiltyMapLock_);
-    for (auto it : abilityContextMap_) {
-        if (it.second == nullptr) {
+    dumpInfos.reserve(dumpInfos.size() + abilityContextMap_.size());
+    for (const auto& [saId, abilityContext] : abilityContextMap_) {
+        if (abilityContext == nullptr) {
             continue;
         }
-        result += "said:                           ";
-        result += std::to_string(it.second->systemAbilityId);
-        result += "\n";
-        result += "sa_state:                       ";
-        result += SA_STATE_ENUM_STR[static_cast<int32_t>(it.second->state)];
-        result += "\n";
-        result += "sa_pending_event:               ";
-        result += PENDINGEVENT_ENUM_STR[static_cast<int32_t>(it.second->pendingEvent)];
-        if (it.second->ownProcessContext != nullptr) {
-            std::lock_guard<samgr::mutex> autoLock(it.second->ownProcessContext->stateCountLock);
-            result += '\n';
-            result += "process_name:                   ";
-            result += Str16ToStr8(it.second->ownProcessContext->processName);
-            result += '\n';
-            result += "pid:                            ";
-            result += std::to_string(it.second->ownProcessContext->pid);
-            result += '\n';
-            result += "uid:                            ";
-            result += std::to_string(it.second->ownProcessContext->uid);
+        SystemAbilityDumpInfo dumpInfo;
+        dumpInfo.systemAbilityId = abilityContext->systemAbilityId;
+        dumpInfo.state = abilityContext->state;
+        dumpInfo.pendingEvent = abilityContext->pendingEvent;
+        const auto& processContext = abilityContext->ownProcessContext;
+        if (processContext != nullptr) {
+            std::lock_guard<samgr::mutex> autoLock(processContext->stateCountLock);
+            dumpInfo.processName = &processContext->GetProcessNameStr8();
+            dumpInfo.pid = processContext->pid;
+            dumpInfo.uid = processContext->uid;
         }
-        result += "\n---------------------------------------------------\n";
+        dumpInfos.emplace_back(dumpInfo);
     }
 }
 
+bool SystemAbilityStateScheduler::IsSystemAbilityInState(const SystemAbilityDumpInfo& dumpInfo,
+    const std::string& state)
+{
+    return state == SA_STATE_ENUM_STR[static_cast<int32_t>(dumpInfo.state)];
+}
+
+void SystemAbilityStateScheduler::FormatSystemAbilityDumpInfo(const SystemAbilityDumpInfo& dumpInfo,
+    std::string& result)
+{
+    result += "said:                           ";
+    result += std::to_string(dumpInfo.systemAbilityId);
+    result += "\n";
+    result += "sa_state:                       ";
+    result += SA_STATE_ENUM_STR[static_cast<int32_t>(dumpInfo.state)];
+    result += "\n";
+    result += "sa_pending_event:               ";
+    result += PENDINGEVENT_ENUM_STR[static_cast<int32_t>(dumpInfo.pendingEvent)];
+    if (dumpInfo.processName != nullptr) {
+        result += '\n';
+        result += "process_name:                   ";
+        result += *dumpInfo.processName;
+        result += '\n';
+        result += "pid:                            ";
+        result += std::to_string(dumpInfo.pid);
+        result += '\n';
+        result += "uid:                            ";
+        result += std::to_string(dumpInfo.uid);
+    }
+    result += "\n---------------------------------------------------\n";
+}
+
 void SystemAbilityStateScheduler::GetSystemAbilityInfo(int32_t said, std::string& result)
 {
     std::shared_ptr<SystemAbilityContext> abilityContext;
@@ -1386,7 +1481,7 @@ void SystemAbilityStateScheduler::GetSystemAbilityInfo(int32_t said, std::string
     result += PENDINGEVENT_ENUM_STR[static_cast<int32_t>(abilityContext->pendingEvent)];
     result += "\n";
     result += "process_name:                   ";
-    result += Str16ToStr8(abilityContext->ownProcessContext->processName);
+    result += abilityContext->ownProcessContext->GetProcessNameStr8();
     result += "\n";
     result += "process_state:                  ";
     result += PROCESS_STATE_ENUM_STR[static_cast<int32_t>(abilityContext->ownProcessContext->state)];
@@ -1405,7 +1500,7 @@ void SystemAbilityStateScheduler::GetProcessInfo(const std::string& processName,
     }
     std::lock_guard<samgr::mutex> autoLock(processContext->processLock);
     result += "process_name:                   ";
-    result += Str16ToStr8(processContext->processName);
+    result += processContext->GetProcessNameStr8();
     result += "\n";
     result += "process_state:                  ";
     result += PROCESS_STATE_ENUM_STR[static_cast<int32_t>(processContext->state)];
@@ -1433,32 +1528,12 @@ void SystemAbilityStateScheduler::GetProcessInfo(const std::string& processName,
 
 void SystemAbilityStateScheduler::GetAllSystemAbilityInfoByState(const std::string& state, std::string& result)
 {
-    std::shared_lock<samgr::shared_mutex> readLock(abiltyMapLock_);
-    for (auto it : abilityContextMap_) {
-        if (it.second == nullptr || SA_STATE_ENUM_STR[static_cast<int32_t>(it.second->state)] != state) {
-            continue;
-        }
-        result += "said:                           ";
-        result += std::to_string(it.second->systemAbilityId);
-        result += '\n';
-        result += "sa_state:                       ";
-        result += SA_STATE_ENUM_STR[static_cast<int32_t>(it.second->state)];
-        result += '\n';
-        result += "sa_pending_event:               ";
-        result += PENDINGEVENT_ENUM_STR[static_cast<int32_t>(it.second->pendingEvent)];
-        if (it.second->ownProcessContext != nullptr) {
-            std::lock_guard<samgr::mutex> autoLock(it.second->ownProcessContext->stateCountLock);
-            result += '\n';
-            result += "process_name:                   ";
-            result += Str16ToStr8(it.second->ownProcessContext->processName);
-            result += '\n';
-            result += "pid:                            ";
-            result += std::to_string(it.second->ownProcessContext->pid);
-            result += '\n';
-            result += "uid:                            ";
-            result += std::to_string(it.second->ownProcessContext->uid);
+    std::vector<SystemAbilityDumpInfo> dumpInfos;
+    GetAllSystemAbilityDumpInfo(dumpInfos);
+    for (const auto& dumpInfo : dumpInfos) {
+        if (IsSystemAbilityInState(dumpInfo, state)) {
+            FormatSystemAbilityDumpInfo(dumpInfo, result);
         }
-        result += "\n---------------------------------------------------\n";
     }
 }
 
@@ -1810,11 +1885,11 @@ void SystemAbilityStateScheduler::RemoveRunningProcessLocked(
     std::unique_lock<samgr::shared_mutex> autoLock(runningProcessListLock_);
     auto it = std::find_if(runningProcessList_.begin(), runningProcessList_.end(),
         [&](const SystemProcessInfo& systemProcessInfo) {
-            return systemProcessInfo.processName == Str16ToStr8(processContext->processName);
+            return systemProcessInfo.processName == processContext->GetProcessNameStr8();
         });
     if (it != runningProcessList_.end()) {
         runningProcessList_.erase(it);
-        HILOGD("runningProcessList_ remove process:%{public}s", Str16ToStr8(processContext->processName).c_str());
+        HILOGD("runningProcessList_ remove process:%{public}s", processContext->GetProcessNameStr8().c_str());
     }
 }
 
@@ -1824,17 +1899,17 @@ void SystemAbilityStateScheduler::AddRunningProcessLocked(
     std::unique_lock<samgr::shared_mutex> autoLock(runningProcessListLock_);
     auto it = std::find_if(runningProcessList_.begin(), runningProcessList_.end(),
         [&](const SystemProcessInfo& systemProcessInfo) {
-            return systemProcessInfo.processName == Str16ToStr8(processContext->processName);
+            return systemProcessInfo.processName == processContext->GetProcessNameStr8();
         });
     if (it == runningProcessList_.end()) {
-        SystemProcessInfo systemProcessInfo = {Str16ToStr8(processContext->processName), processContext->pid,
+        SystemProcessInfo systemProcessInfo = {processContext->GetProcessNameStr8(), processContext->pid,
             processContext->uid};
         runningProcessList_.emplace_back(std::move(systemProcessInfo));
     } else {
         it->pid = processContext->pid;
         it->uid = processContext->uid;
     }
-    HILOGD("runningProcessList_ add process:%{public}s", Str16ToStr8(processContext->processName).c_str());
+    HILOGD("runningProcessList_ add process:%{public}s", processContext->GetProcessNameStr8().c_str());
 }
 
 void SystemAbilityStateScheduler::UnloadEventHandler::ProcessEvent(uint32_t eventId)
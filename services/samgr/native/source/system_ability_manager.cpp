@@ -228,15 +228,17 @@ int32_t SystemAbilityManager::Dump(int32_t fd, const std::vector<std::u16string>
         return SystemAbilityManagerDumper::FfrtDumpProc(abilityStateScheduler_, fd, argsWithStr8);
     }
     if ((argsWithStr8.size() > 0) && (argsWithStr8[FIRST_DUMP_INDEX] == ARGS_LISTENER_PARAM)) {
-        std::map<int32_t, std::list<SAListener>> dumpListeners;
+        std::vector<SAListenerDumpInfo> dumpInfos;
         {
-            lock_guard<samgr::mutex> autoLock(listenerMapLock_);
-            dumpListeners = listenerMap_;
+            lock_guard<ListenerMapLock> autoLock(listenerMapLock_);
+            SystemAbilityManagerDumper::GetListenerDumpInfo(listenerMap_, dumpInfos);
         }
-        return SystemAbilityManagerDumper::ListenerDumpProc(dumpListeners, fd, argsWithStr8);
+        return SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, argsWithStr8, listenerNotifier_);
     }
     if ((argsWithStr8.size() > 0) && (argsWithStr8[IPC_STAT_PREFIX_INDEX] == IPC_STAT_DUMP_PREFIX)) {
         return IpcDumpProc(fd, argsWithStr8);
+    } else if (SystemAbilityManagerDumper::IsStreamDump(argsWithStr8)) {
+        return SystemAbilityManagerDumper::StreamDumpProc(abilityStateScheduler_, fd, argsWithStr8);
     } else {
         std::string result;
         SystemAbilityManagerDumper::Dump(abilityStateScheduler_, argsWithStr8, result);
@@ -250,12 +252,13 @@ int32_t SystemAbilityManager::Dump(int32_t fd, const std::vector<std::u16string>
 
 void SystemAbilityManager::AddSamgrToAbilityMap()
 {
-    unique_lock<samgr::shared_mutex> writeLock(abilityMapLock_);
+    unique_lock<AbilityMapLock> writeLock(abilityMapLock_);
     int32_t systemAbilityId = 0;
     SAInfo saInfo;
     saInfo.remoteObj = this;
     saInfo.isDistributed = false;
     abilityMap_[systemAbilityId] = std::move(saInfo);
+    PublishAbilityLocked(systemAbilityId);
     if (abilityStateScheduler_ != nullptr) {
         abilityStateScheduler_->InitSamgrProcessContext();
     }
@@ -276,7 +279,7 @@ std::list<int32_t> SystemAbilityManager::GetAllOndemandSa()
     {
         lock_guard<samgr::mutex> autoLock(saProfileMapLock_);
         for (const auto& [said, value] : saProfileMap_) {
-            shared_lock<samgr::shared_mutex> readLock(abilityMapLock_);
+            shared_lock<AbilityMapLock> readLock(abilityMapLock_);
             auto iter = abilityMap_.find(said);
             if (iter == abilityMap_.end()) {
                 ondemandSaids.emplace_back(said);
@@ -341,18 +344,17 @@ sptr<IRemoteObject> SystemAbilityManager::GetSystemAbilityFromRemote(int32_t sys
         return nullptr;
     }
 
-    shared_lock<samgr::shared_mutex> readLock(abilityMapLock_);
-    auto iter = abilityMap_.find(systemAbilityId);
-    if (iter == abilityMap_.end()) {
+    SAInfo saInfo;
+    if (!FindAbility(systemAbilityId, saInfo)) {
         HILOGI("GetSystemAbilityFromRemote not found SA %{public}d.", systemAbilityId);
         return nullptr;
     }
-    if (!(iter->second.isDistributed)) {
+    if (!(saInfo.isDistributed)) {
         HILOGW("GetSystemAbilityFromRemote SA:%{public}d not distributed", systemAbilityId);
         return nullptr;
     }
     HILOGI("GetSystemAbilityFromRemote found SA:%{public}d.", systemAbilityId);
-    return iter->second.remoteObj;
+    return saInfo.remoteObj;
 }
 
 sptr<IRemoteObject> SystemAbilityManager::CheckSystemAbility(int32_t systemAbilityId)
@@ -360,6 +362,12 @@ sptr<IRemoteObject> SystemAbilityManager::CheckSystemAbility(int32_t systemAbili
     return BaseSystemAbilityManager::CheckSystemAbility(systemAbilityId);
 }
 
+int32_t SystemAbilityManager::GetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+    std::vector<sptr<IRemoteObject>>& saList, std::vector<int32_t>& errCodes)
+{
+    return BaseSystemAbilityManager::GetSystemAbilities(systemAbilityIds, saList, errCodes);
+}
+
 sptr<IRemoteObject> SystemAbilityManager::CheckSystemAbility(int32_t systemAbilityId,
     const std::string& deviceId)
 {
@@ -547,7 +555,7 @@ int32_t SystemAbilityManager::DoLoadSystemAbilityFromRpc(const std::string& srcD
         return ERR_OK;
     }
     {
-        lock_guard<samgr::mutex> autoLock(onDemandLock_);
+        lock_guard<OnDemandLock> autoLock(GetOnDemandLock(systemAbilityId));
         auto& abilityItem = startingAbilityMap_[systemAbilityId];
         abilityItem.callbackMap[srcDeviceId].emplace_back(callback, 0);
         StartingSystemProcessLocked(procName, systemAbilityId, event);
@@ -683,6 +691,7 @@ void SystemAbilityManager::ReportGetSAPeriodically()
 {
     HILOGI("ReportGetSAPeriodically start!");
     lock_guard<samgr::mutex> autoLock(saFrequencyLock_);
+    MergeSaFreMapLocked();
     for (const auto& [key, count] : saFrequencyMap_) {
         uint32_t saId = static_cast<uint32_t>(key);
         uint32_t uid = key >> SHFIT_BIT;
@@ -15,6 +15,9 @@
 
 #include "system_ability_manager_dumper.h"
 
+#include <cerrno>
+#include <unistd.h>
+
 #include "accesstoken_kit.h"
 #include "ffrt_inner.h"
 #include "file_ex.h"
@@ -23,6 +26,7 @@
 #include "if_local_ability_manager.h"
 #include "ipc_payload_statistics.h"
 #include "samgr_err_code.h"
+#include "samgr_latency_stats.h"
 
 using namespace std;
 namespace OHOS {
@@ -33,6 +37,9 @@ constexpr const char* ARGS_QUERY_PROCESS = "-p";
 constexpr const char* ARGS_QUERY_SA_IN_CURRENT_STATE = "-sm";
 constexpr const char* ARGS_HELP = "-h";
 constexpr const char* ARGS_QUERY_ALL = "-l";
+constexpr const char* ARGS_QUERY_NOTIFY = "-notify";
+constexpr const char* ARGS_LATENCY = "--latency";
+constexpr const char* ARGS_LATENCY_RESET = "--reset";
 constexpr const char* ARGS_FFRT_SEPARATOR = "|";
 constexpr size_t MIN_ARGS_SIZE = 1;
 constexpr size_t MAX_ARGS_SIZE = 2;
@@ -56,7 +63,54 @@ constexpr const char* IPC_STAT_STR_ALL = "all";
 constexpr const char* IPC_STAT_STR_SAMGR = "samgr";
 constexpr const char* IPC_DUMP_SUCCESS = " success\n";
 constexpr const char* IPC_DUMP_FAIL = " fail\n";
+constexpr size_t STREAM_DUMP_BUFFER_SIZE = 16 * 1024;
+constexpr uint32_t LATENCY_P50 = 50;
+constexpr uint32_t LATENCY_P90 = 90;
+constexpr uint32_t LATENCY_P99 = 99;
+
+void AppendLatency(const LatencySnapshot& snapshot, const char* prefix, std::string& result)
+{
+    result.append(" ").append(prefix).append("Avg:").append(std::to_string(snapshot.GetAvgUs()))
+        .append(" ").append(prefix).append("P50:").append(std::to_string(snapshot.GetPercentileUs(LATENCY_P50)))
+        .append(" ").append(prefix).append("P90:").append(std::to_string(snapshot.GetPercentileUs(LATENCY_P90)))
+        .append(" ").append(prefix).append("P99:").append(std::to_string(snapshot.GetPercentileUs(LATENCY_P99)))
+        .append(" ").append(prefix).append("Max:").append(std::to_string(snapshot.maxUs));
+}
+}
 
+DumpFdWriter::DumpFdWriter(int32_t fd) : fd_(fd)
+{
+    buffer_.reserve(STREAM_DUMP_BUFFER_SIZE);
+}
+
+void DumpFdWriter::Append(const std::string& content)
+{
+    buffer_ += content;
+    if (buffer_.size() >= STREAM_DUMP_BUFFER_SIZE) {
+        Flush();
+    }
+}
+
+bool DumpFdWriter::Flush()
+{
+    if (fd_ <= 0) {
+        isOk_ = false;
+    }
+    size_t written = 0;
+    while (isOk_ && written < buffer_.size()) {
+        ssize_t ret = write(fd_, buffer_.data() + written, buffer_.size() - written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            HILOGE("stream dump write fd failed, errno:%{public}d", errno);
+            isOk_ = false;
+            break;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    buffer_.clear();
+    return isOk_;
 }
 
 std::shared_ptr<FFRTHandler> SystemAbilityManagerDumper::handler_ = nullptr;
@@ -71,28 +125,57 @@ void SystemAbilityManagerDumper::ShowListenerHelp(string& result)
         .append("cmd maybe one of:\n")
         .append("  -sa [said]: query sa listener infos.\n")
         .append("  -p [pid]: query process listener infos.\n")
-        .append("  -l [-sa | -p]: query all sa listener infos by [sa | process].\n");
+        .append("  -l [-sa | -p]: query all sa listener infos by [sa | process].\n")
+        .append("  -notify: query listener notification count and latency.\n");
+}
+
+void SystemAbilityManagerDumper::GetListenerDumpInfo(const map<int32_t, list<SAListener>>& listeners,
+    vector<SAListenerDumpInfo>& dumpInfos)
+{
+    for (const auto& [said, saListeners] : listeners) {
+        for (const auto& saListener : saListeners) {
+            SAListenerDumpInfo dumpInfo;
+            dumpInfo.systemAbilityId = said;
+            dumpInfo.callingPid = saListener.callingPid;
+            if (saListener.listener != nullptr) {
+                dumpInfo.listenerKey = reinterpret_cast<uintptr_t>(saListener.listener->AsObject().GetRefPtr());
+            }
+            dumpInfos.emplace_back(dumpInfo);
+        }
+    }
 }
 
-int32_t SystemAbilityManagerDumper::ListenerDumpProc(map<int32_t, list<SAListener>>& listeners,
-    int32_t fd, const vector<string>& args)
+int32_t SystemAbilityManagerDumper::ListenerDumpProc(const vector<SAListenerDumpInfo>& dumpInfos,
+    int32_t fd, const vector<string>& args, const std::shared_ptr<SaListenerNotifier>& listenerNotifier)
 {
     if (!CanDump()) {
         HILOGE("Dump failed, not allowed");
         return ERR_PERMISSION_DENIED;
     }
-    string result;
-    GetListenerDumpProc(listeners, args, result);
-    return SaveDumpResultToFd(fd, result);
+    DumpFdWriter writer(fd);
+    GetListenerDumpProc(dumpInfos, args, writer, listenerNotifier);
+    if (!writer.Flush()) {
+        HILOGE("save to fd failed");
+        return SAVE_FD_FAIL;
+    }
+    return ERR_OK;
 }
 
-void SystemAbilityManagerDumper::GetListenerDumpProc(map<int32_t, list<SAListener>>& listeners,
-    const vector<string>& args, string& result)
+void SystemAbilityManagerDumper::GetListenerDumpProc(const vector<SAListenerDumpInfo>& dumpInfos,
+    const vector<string>& args, DumpFdWriter& writer, const std::shared_ptr<SaListenerNotifier>& listenerNotifier)
 {
+    string result;
     if (args.size() == MIN_ARGS_SIZE + 1) {
         // -h
         if (args[LISTENER_BASE_INDEX] == ARGS_HELP) {
             ShowListenerHelp(result);
+            writer.Append(result);
+            return;
+        }
+        // -notify
+        if (args[LISTENER_BASE_INDEX] == ARGS_QUERY_NOTIFY && listenerNotifier != nullptr) {
+            listenerNotifier->Dump(result);
+            writer.Append(result);
             return;
         }
     } else if (args.size() == MAX_ARGS_SIZE + 1) {
@@ -100,165 +183,170 @@ void SystemAbilityManagerDumper::GetListenerDumpProc(map<int32_t, list<SAListene
         if (args[LISTENER_BASE_INDEX] == ARGS_QUERY_ALL) {
             // -sa
             if (args[LISTENER_BASE_INDEX + 1] == ARGS_QUERY_SA) {
-                ShowAllBySA(listeners, result);
+                ShowAllBySA(dumpInfos, writer);
                 return;
             }
             // -p
             if (args[LISTENER_BASE_INDEX + 1] == ARGS_QUERY_PROCESS) {
-                ShowAllByCallingPid(listeners, result);
+                ShowAllByCallingPid(dumpInfos, writer);
                 return;
             }
         }
         // -sa said
         if (args[LISTENER_BASE_INDEX] == ARGS_QUERY_SA) {
             int said = atoi(args[LISTENER_BASE_INDEX + 1].c_str());
-            ShowCallingPidBySA(listeners, said, result);
+            ShowCallingPidBySA(dumpInfos, said, writer);
             return;
         }
         // -p pid
         if (args[LISTENER_BASE_INDEX] == ARGS_QUERY_PROCESS) {
             int callingPid = atoi(args[LISTENER_BASE_INDEX + 1].c_str());
-            ShowSAByCallingPid(listeners, callingPid, result);
+            ShowSAByCallingPid(dumpInfos, callingPid, writer);
             return;
         }
     }
     IllegalInput(result);
+    writer.Append(result);
 }
 
-void SystemAbilityManagerDumper::ShowAllBySA(map<int32_t, list<SAListener>>& listeners,
-    string& result)
+void SystemAbilityManagerDumper::ShowAllBySA(const vector<SAListenerDumpInfo>& dumpInfos, DumpFdWriter& writer)
 {
-    result += "********************************ShowAllBySA********************************";
-    set<sptr<IRemoteObject>> listenerSet;
-    for (auto iter : listeners) {
-        if (iter.second.size() == 0) {
-            continue;
+    writer.Append("********************************ShowAllBySA********************************");
+    map<int32_t, map<int32_t, int32_t>> saPidCnt;
+    set<uintptr_t> listenerSet;
+    for (const auto& dumpInfo : dumpInfos) {
+        saPidCnt[dumpInfo.systemAbilityId][dumpInfo.callingPid]++;
+        listenerSet.insert(dumpInfo.listenerKey);
+    }
+    string result;
+    for (const auto& [said, pidCnt] : saPidCnt) {
+        int32_t subCnt = 0;
+        for (const auto& [callingPid, cnt] : pidCnt) {
+            subCnt += cnt;
         }
+        result.clear();
         result += "\n\n--------------------------------SA:";
-        result += to_string(iter.first);
+        result += to_string(said);
         result += ", SubCnt:";
-        result += to_string(iter.second.size());
+        result += to_string(subCnt);
         result += "--------------------------------";
-        map<int32_t, int32_t> pidCnt;
-        for (auto saListener : iter.second) {
-            pidCnt[saListener.callingPid]++;
-            listenerSet.insert(saListener.listener->AsObject());
-        }
-        for (auto iter : pidCnt) {
+        for (const auto& [callingPid, cnt] : pidCnt) {
             result += "\ncallingPid:";
-            result += to_string(iter.first);
+            result += to_string(callingPid);
             result += ", cnt:";
-            result += to_string(iter.second);
+            result += to_string(cnt);
         }
+        writer.Append(result);
     }
+    result.clear();
     result += "\n--------------------------------TotalListenerCnt:";
     result += to_string(listenerSet.size());
     result += "--------------------------------";
     result += "\n***************************************************************************\n";
+    writer.Append(result);
 }
 
-void SystemAbilityManagerDumper::ShowAllByCallingPid(map<int32_t, list<SAListener>>& listeners,
-    string& result)
+void SystemAbilityManagerDumper::ShowAllByCallingPid(const vector<SAListenerDumpInfo>& dumpInfos,
+    DumpFdWriter& writer)
 {
-    result += "********************************ShowAllByCallingPid********************************";
-    map<int32_t, list<pair<int32_t, sptr<ISystemAbilityStatusChange>>>> subscribeMap;
-    map<int32_t, set<sptr<IRemoteObject>>> pidListenerMap;
-    size_t totalSum = 0;
-    for (auto iter : listeners) {
-        int32_t said = iter.first;
-        for (auto saListener : iter.second) {
-            subscribeMap[saListener.callingPid].push_back({said, saListener.listener});
-            pidListenerMap[saListener.callingPid].insert(saListener.listener->AsObject());
-        }
+    writer.Append("********************************ShowAllByCallingPid********************************");
+    map<int32_t, map<int32_t, int32_t>> pidSaCnt;
+    map<int32_t, set<uintptr_t>> pidListenerMap;
+    for (const auto& dumpInfo : dumpInfos) {
+        pidSaCnt[dumpInfo.callingPid][dumpInfo.systemAbilityId]++;
+        pidListenerMap[dumpInfo.callingPid].insert(dumpInfo.listenerKey);
     }
-    vector<pair<int32_t, set<sptr<IRemoteObject>>>> vec(pidListenerMap.begin(), pidListenerMap.end());
-    auto cmp = [](const pair<int32_t, set<sptr<IRemoteObject>>>& p1,
-        const pair<int32_t, set<sptr<IRemoteObject>>>& p2) {
-        return p1.second.size() > p2.second.size();
+    vector<pair<int32_t, size_t>> vec;
+    for (const auto& [callingPid, listenerSet] : pidListenerMap) {
+        vec.emplace_back(callingPid, listenerSet.size());
+    }
+    auto cmp = [](const pair<int32_t, size_t>& p1, const pair<int32_t, size_t>& p2) {
+        return p1.second > p2.second;
     };
     sort(vec.begin(), vec.end(), cmp);
-    for (auto iter : vec) {
+    size_t totalSum = 0;
+    string result;
+    for (const auto& [callingPid, listenerCnt] : vec) {
+        result.clear();
         result += "\n\n--------------------------------CallingPid:";
-        result += to_string(iter.first);
+        result += to_string(callingPid);
         result += ", ListenerCnt:";
-        result += to_string(iter.second.size());
+        result += to_string(listenerCnt);
         result += "--------------------------------";
-        totalSum += iter.second.size();
-        map<int32_t, int32_t> saCnt;
-        for (auto p : subscribeMap[iter.first]) {
-            saCnt[p.first]++;
-        }
-        for (auto iter : saCnt) {
+        totalSum += listenerCnt;
+        for (const auto& [said, cnt] : pidSaCnt[callingPid]) {
             result += "\nSA:";
-            result += to_string(iter.first);
+            result += to_string(said);
             result += ", cnt:";
-            result += to_string(iter.second);
+            result += to_string(cnt);
         }
+        writer.Append(result);
     }
+    result.clear();
     result += "\n--------------------------------TotalListenerCnt:";
     result += to_string(totalSum);
     result += "--------------------------------";
     result += "\n***********************************************************************************\n";
+    writer.Append(result);
 }
 
-void SystemAbilityManagerDumper::ShowCallingPidBySA(map<int32_t, list<SAListener>>& listeners,
-    int32_t said, string& result)
+void SystemAbilityManagerDumper::ShowCallingPidBySA(const vector<SAListenerDumpInfo>& dumpInfos,
+    int32_t said, DumpFdWriter& writer)
 {
+    string result;
     result += "********************************ShowCallingPidBySA********************************";
     result += "\n--------------------------------SA:";
     result += to_string(said);
     result += "--------------------------------";
     map<int32_t, int32_t> pidCnt;
-    for (auto iter : listeners) {
-        if (iter.first == said) {
-            for (auto saListener : iter.second) {
-                pidCnt[saListener.callingPid]++;
-            }
-            break;
+    for (const auto& dumpInfo : dumpInfos) {
+        if (dumpInfo.systemAbilityId == said) {
+            pidCnt[dumpInfo.callingPid]++;
         }
     }
     int32_t totalSum = 0;
-    for (auto iter : pidCnt) {
+    for (const auto& [callingPid, cnt] : pidCnt) {
         result += "\ncallingPid:";
-        result += to_string(iter.first);
+        result += to_string(callingPid);
         result += ", cnt:";
-        result += to_string(iter.second);
-        totalSum += iter.second;
+        result += to_string(cnt);
+        totalSum += cnt;
     }
     result += "\n--------------------------------TotalSubCnt:";
     result += to_string(totalSum);
     result += "--------------------------------";
     result += "\n**********************************************************************************\n";
+    writer.Append(result);
 }
 
-void SystemAbilityManagerDumper::ShowSAByCallingPid(map<int32_t, list<SAListener>>& listeners,
-    int32_t callingPid, string& result)
+void SystemAbilityManagerDumper::ShowSAByCallingPid(const vector<SAListenerDumpInfo>& dumpInfos,
+    int32_t callingPid, DumpFdWriter& writer)
 {
+    string result;
     result += "********************************ShowSAByCallingPid********************************";
     result += "\n--------------------------------CallingPid:";
     result += to_string(callingPid);
     result += "--------------------------------";
     map<int32_t, int32_t> saCnt;
-    set<sptr<IRemoteObject>> listenerSet;
-    for (auto iter : listeners) {
-        int32_t said = iter.first;
-        for (auto saListener : iter.second) {
-            if (saListener.callingPid == callingPid) {
-                saCnt[said]++;
-                listenerSet.insert(saListener.listener->AsObject());
-            }
+    set<uintptr_t> listenerSet;
+    for (const auto& dumpInfo : dumpInfos) {
+        if (dumpInfo.callingPid == callingPid) {
+            saCnt[dumpInfo.systemAbilityId]++;
+            listenerSet.insert(dumpInfo.listenerKey);
         }
     }
-    for (auto iter : saCnt) {
+    for (const auto& [said, cnt] : saCnt) {
         result += "\nSA:";
-        result += to_string(iter.first);
+        result += to_string(said);
         result += ", cnt:";
-        result += to_string(iter.second);
+        result += to_string(cnt);
     }
     result += "\n--------------------------------ListenerCnt:";
     result += to_string(listenerSet.size());
     result += "--------------------------------";
     result += "\n**********************************************************************************\n";
+    result += "\n**********************************************************************************\n";
+    writer.Append(result);
 }
 
 int32_t SystemAbilityManagerDumper::FfrtDumpProc(std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler,
@@ -709,6 +797,11 @@ bool SystemAbilityManagerDumper::Dump(std::shared_ptr<SystemAbilityStateSchedule
             ShowHelp(result);
             return true;
         }
+        // --latency
+        if (args[0] == ARGS_LATENCY) {
+            ShowLatencyStats(result);
+            return true;
+        }
     }
     if (args.size() == MAX_ARGS_SIZE) {
         // -sa said
@@ -727,11 +820,63 @@ bool SystemAbilityManagerDumper::Dump(std::shared_ptr<SystemAbilityStateSchedule
             ShowAllSystemAbilityInfoInState(args[1], abilityStateScheduler, result);
             return true;
         }
+        // --latency --reset
+        if (args[0] == ARGS_LATENCY && args[1] == ARGS_LATENCY_RESET) {
+            SamgrLatencyStats::GetInstance().Reset();
+            result.append("latency stats reset\n");
+            return true;
+        }
     }
     IllegalInput(result);
     return false;
 }
 
+bool SystemAbilityManagerDumper::IsStreamDump(const std::vector<std::string>& args)
+{
+    // -l
+    if (args.size() == MIN_ARGS_SIZE) {
+        return args[0] == ARGS_QUERY_ALL;
+    }
+    // -sm state
+    if (args.size() == MAX_ARGS_SIZE) {
+        return args[0] == ARGS_QUERY_SA_IN_CURRENT_STATE;
+    }
+    return false;
+}
+
+int32_t SystemAbilityManagerDumper::StreamDumpProc(std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler,
+    int32_t fd, const std::vector<std::string>& args)
+{
+    if (!CanDump()) {
+        // the buffered -l/-sm dump wrote nothing and returned ERR_OK here, callers rely on that
+        HILOGE("Dump failed, not allowed");
+        return ERR_OK;
+    }
+    if (abilityStateScheduler == nullptr) {
+        HILOGE("abilityStateScheduler is nullptr");
+        return ERR_OK;
+    }
+    // the scheduler locks are held only while the snapshot is copied, formatting and writing happen after
+    std::vector<SystemAbilityDumpInfo> dumpInfos;
+    abilityStateScheduler->GetAllSystemAbilityDumpInfo(dumpInfos);
+    bool filterByState = (args.size() == MAX_ARGS_SIZE);
+    DumpFdWriter writer(fd);
+    std::string entry;
+    for (const auto& dumpInfo : dumpInfos) {
+        if (filterByState && !SystemAbilityStateScheduler::IsSystemAbilityInState(dumpInfo, args[1])) {
+            continue;
+        }
+        entry.clear();
+        SystemAbilityStateScheduler::FormatSystemAbilityDumpInfo(dumpInfo, entry);
+        writer.Append(entry);
+    }
+    if (!writer.Flush()) {
+        HILOGE("save to fd failed");
+        return ERR_INVALID_VALUE;
+    }
+    return ERR_OK;
+}
+
 bool SystemAbilityManagerDumper::CanDump()
 {
     uint32_t accessToken = IPCSkeleton::GetCallingTokenID();
@@ -757,12 +902,43 @@ void SystemAbilityManagerDumper::ShowHelp(std::string& result)
         .append(" the FFRT load statistics of a process.\n")
         .append("  --ffrt [pid1|pid2]: query the FFRT dump infos of a process.\n")
         .append("  --ipc procname/all --start-stat/--stop-stat/--stat: start/stop/get")
-        .append(" the IPC load statistics of a process.\n");
+        .append(" the IPC load statistics of a process.\n")
+        .append("  --latency [--reset]: query/reset the samgr per transaction code and lock wait latency.\n");
 #ifdef SUPPORT_MULTI_INSTANCE
     result.append("  --multi-instance: query all multi-instance SA IDs.\n");
 #endif
 }
 
+void SystemAbilityManagerDumper::ShowLatencyStats(std::string& result)
+{
+    const SamgrLatencyStats& stats = SamgrLatencyStats::GetInstance();
+    result.append("samgr request latency(us), lockWait is the time the request waited on samgr locks:\n");
+    for (uint32_t code = 0; code <= SamgrLatencyStats::TRACKED_CODE_NUM; ++code) {
+        const SamgrLatencyStats::CodeStats& codeStats = stats.GetCodeStats(code);
+        LatencySnapshot service = codeStats.service.GetSnapshot();
+        if (service.count == 0) {
+            continue;
+        }
+        result.append("  code:").append((code == SamgrLatencyStats::TRACKED_CODE_NUM) ? "other" : to_string(code))
+            .append(" count:").append(to_string(service.count));
+        AppendLatency(service, "service", result);
+        AppendLatency(codeStats.lockWait.GetSnapshot(), "lockWait", result);
+        result.append("\n");
+    }
+    const std::pair<SamgrLockId, const char*> locks[] = {
+        { SamgrLockId::ABILITY_MAP, "abilityMapLock" },
+        { SamgrLockId::LISTENER_MAP, "listenerMapLock" },
+        { SamgrLockId::ON_DEMAND, "onDemandLock" },
+    };
+    result.append("samgr lock wait(us), only the acquisitions that blocked are counted:\n");
+    for (const auto& [lockId, lockName] : locks) {
+        LatencySnapshot wait = stats.GetLockStats(lockId).GetSnapshot();
+        result.append("  ").append(lockName).append(" blocked:").append(to_string(wait.count));
+        AppendLatency(wait, "wait", result);
+        result.append("\n");
+    }
+}
+
 void SystemAbilityManagerDumper::ShowAllSystemAbilityInfo(
     std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler, std::string& result)
 {
@@ -17,6 +17,7 @@
 
 #include <unistd.h>
 #include <cinttypes>
+#include <string_view>
 
 #include "accesstoken_kit.h"
 #include "datetime_ex.h"
@@ -31,6 +32,7 @@
 #include "system_ability_manager_util.h"
 #include "system_ability_on_demand_event.h"
 #include "tools.h"
+#include "samgr_latency_stats.h"
 #include "samgr_xcollie.h"
 #include "qos.h"
 
@@ -138,98 +140,110 @@ void SystemAbilityManagerStub::SetSupportPrior(bool isSupport)
     HILOGI("SAMStub: SetSupportPrior isSupportSetPrior_ = %{public}d", isSupport);
 }
 
-void SystemAbilityManagerStub::SetAbilityFuncMap()
+constexpr void SystemAbilityManagerStub::SetAbilityFuncTable(FuncTable& table)
 {
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalGetSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::CHECK_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::CHECK_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalCheckSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalAddSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalRemoveSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::LIST_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::LIST_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalListSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::SUBSCRIBE_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::SUBSCRIBE_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalSubsSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::CHECK_REMOTE_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::CHECK_REMOTE_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalCheckRemtSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::ADD_ONDEMAND_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::ADD_ONDEMAND_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalAddOndemandSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::CHECK_SYSTEM_ABILITY_IMMEDIATELY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::CHECK_SYSTEM_ABILITY_IMMEDIATELY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalCheckSystemAbilityImme;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::UNSUBSCRIBE_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_SYSTEM_ABILITIES_TRANSACTION)] =
+        SystemAbilityManagerStub::LocalGetSystemAbilities;
+    table[static_cast<uint32_t>(SamgrInterfaceCode::UNSUBSCRIBE_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalUnSubsSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::LOAD_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::LOAD_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalLoadSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::LOAD_REMOTE_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::LOAD_REMOTE_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalLoadRemoteSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::UNLOAD_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::UNLOAD_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalUnloadSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::CANCEL_UNLOAD_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::CANCEL_UNLOAD_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalCancelUnloadSystemAbility;
 }
 
-void SystemAbilityManagerStub::SetProcessFuncMap()
+constexpr void SystemAbilityManagerStub::SetProcessFuncTable(FuncTable& table)
 {
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::ADD_SYSTEM_PROCESS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::ADD_SYSTEM_PROCESS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalAddSystemProcess;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_SYSTEM_PROCESS_INFO_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_SYSTEM_PROCESS_INFO_TRANSACTION)] =
         SystemAbilityManagerStub::LocalGetSystemProcessInfo;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_RUNNING_SYSTEM_PROCESS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_RUNNING_SYSTEM_PROCESS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalGetRunningSystemProcess;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::SUBSCRIBE_SYSTEM_PROCESS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::SUBSCRIBE_SYSTEM_PROCESS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalSubscribeSystemProcess;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::UNSUBSCRIBE_SYSTEM_PROCESS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::UNSUBSCRIBE_SYSTEM_PROCESS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalUnSubscribeSystemProcess;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::SUBSCRIBE_LOWMEM_SYSTEM_PROCESS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::SUBSCRIBE_LOWMEM_SYSTEM_PROCESS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalSubscribeLowMemSystemProcess;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::UNSUBSCRIBE_LOWMEM_SYSTEM_PROCESS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::UNSUBSCRIBE_LOWMEM_SYSTEM_PROCESS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalUnSubscribeLowMemSystemProcess;
 }
 
-SystemAbilityManagerStub::SystemAbilityManagerStub()
+constexpr SystemAbilityManagerStub::FuncTable SystemAbilityManagerStub::BuildFuncTable()
 {
-#ifdef SUPPORT_PENGLAI_MODE
-    SetPengLai(SamgrUtil::CheckPengLai());
-#endif
-    SetSupportPrior(SamgrUtil::CheckSupportSetPrior());
-    SetAbilityFuncMap();
-    SetProcessFuncMap();
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_ONDEMAND_REASON_EXTRA_DATA_TRANSACTION)] =
+    FuncTable table {};
+    SetAbilityFuncTable(table);
+    SetProcessFuncTable(table);
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_ONDEMAND_REASON_EXTRA_DATA_TRANSACTION)] =
         SystemAbilityManagerStub::LocalGetOnDemandReasonExtraData;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_ONDEAMND_POLICY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_ONDEAMND_POLICY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalGetOnDemandPolicy;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::UPDATE_ONDEAMND_POLICY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::UPDATE_ONDEAMND_POLICY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalUpdateOnDemandPolicy;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_ONDEMAND_SYSTEM_ABILITY_IDS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_ONDEMAND_SYSTEM_ABILITY_IDS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalGetOnDemandSystemAbilityIds;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::SEND_STRATEGY_TRANASACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::SEND_STRATEGY_TRANASACTION)] =
         SystemAbilityManagerStub::LocalSendStrategy;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::UNLOAD_ALL_IDLE_SYSTEM_ABILITY_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::UNLOAD_ALL_IDLE_SYSTEM_ABILITY_TRANSACTION)] =
         SystemAbilityManagerStub::LocalUnloadAllIdleSystemAbility;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_EXTENSION_SA_IDS_TRANSCATION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_EXTENSION_SA_IDS_TRANSCATION)] =
         SystemAbilityManagerStub::LocalGetExtensionSaIds;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_EXTERNSION_SA_LIST_TRANSCATION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_EXTERNSION_SA_LIST_TRANSCATION)] =
         SystemAbilityManagerStub::LocalGetExtensionRunningSaList;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_SA_EXTENSION_INFO_TRANSCATION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_SA_EXTENSION_INFO_TRANSCATION)] =
         SystemAbilityManagerStub::LocalGetRunningSaExtensionInfoList;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_COMMON_EVENT_EXTRA_ID_LIST_TRANSCATION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_COMMON_EVENT_EXTRA_ID_LIST_TRANSCATION)] =
         SystemAbilityManagerStub::LocalGetCommonEventExtraDataIdlist;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_LOCAL_ABILITY_MANAGER_PROXY_TRANSCATION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_LOCAL_ABILITY_MANAGER_PROXY_TRANSCATION)] =
         SystemAbilityManagerStub::LocalGetLocalAbilityManagerProxy;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::UNLOAD_IDLE_PROCESS_BYLIST)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::UNLOAD_IDLE_PROCESS_BYLIST)] =
         SystemAbilityManagerStub::LocalUnloadProcess;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::GET_LRU_IDLE_SYSTEM_ABILITY_PROCESS_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::GET_LRU_IDLE_SYSTEM_ABILITY_PROCESS_TRANSACTION)] =
         SystemAbilityManagerStub::LocalGetLruIdleSystemAbilityProc;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::SET_SAMGR_IPC_PRIOR_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::SET_SAMGR_IPC_PRIOR_TRANSACTION)] =
         SystemAbilityManagerStub::LocalSetSamgrIpcPrior;
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::ONSTART_SYSTEM_ABILITY_FAIL_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::ONSTART_SYSTEM_ABILITY_FAIL_TRANSACTION)] =
         SystemAbilityManagerStub::LocalOnStartSystemAbilityFail;
 #ifdef SUPPORT_MULTI_INSTANCE
-    memberFuncMap_[static_cast<uint32_t>(SamgrInterfaceCode::ON_USER_STATE_CHANGED_TRANSACTION)] =
+    table[static_cast<uint32_t>(SamgrInterfaceCode::ON_USER_STATE_CHANGED_TRANSACTION)] =
         SystemAbilityManagerStub::LocalOnUserStateChanged;
 #endif
+    return table;
+}
+
+// built at compile time, a code past the end of the table fails the build instead of being dropped
+constexpr SystemAbilityManagerStub::FuncTable SystemAbilityManagerStub::memberFuncTable_ =
+    SystemAbilityManagerStub::BuildFuncTable();
+
+SystemAbilityManagerStub::SystemAbilityManagerStub()
+{
+#ifdef SUPPORT_PENGLAI_MODE
+    SetPengLai(SamgrUtil::CheckPengLai());
+#endif
+    SetSupportPrior(SamgrUtil::CheckSupportSetPrior());
 }
 
 void SystemAbilityManagerStub::SetIpcPrior()
@@ -266,6 +280,8 @@ void SystemAbilityManagerStub::ResetIpcPrior()
 int32_t SystemAbilityManagerStub::OnRemoteRequest(uint32_t code,
     MessageParcel& data, MessageParcel& reply, MessageOption &option)
 {
+    static_assert(FUNC_TABLE_SIZE <= SamgrLatencyStats::TRACKED_CODE_NUM, "every samgr code needs its own slot");
+    SamgrRequestTimer requestTimer(code);
     HILOGD("SAMStub::OnReceived, code = %{public}u, callerPid = %{public}d",
         code, IPCSkeleton::GetCallingPid());
     if (!EnforceInterceToken(data)) {
@@ -273,9 +289,8 @@ int32_t SystemAbilityManagerStub::OnRemoteRequest(uint32_t code,
         return ERR_PERMISSION_DENIED;
     }
     SetIpcPrior();
-    auto itFunc = memberFuncMap_.find(code);
-    if (itFunc != memberFuncMap_.end()) {
-        return itFunc->second(this, data, reply);
+    if (code < memberFuncTable_.size() && memberFuncTable_[code] != nullptr) {
+        return memberFuncTable_[code](this, data, reply);
     }
     HILOGW("SAMStub: default case, need check.");
     return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -283,6 +298,20 @@ int32_t SystemAbilityManagerStub::OnRemoteRequest(uint32_t code,
 
 bool SystemAbilityManagerStub::EnforceInterceToken(MessageParcel& data)
 {
+    // compare the token in place instead of copying it out of the parcel on every transaction
+    size_t tokenPosition = data.GetReadPosition();
+    int32_t strictModePolicy = 0;
+    int32_t workSource = 0;
+    if (data.ReadInt32(strictModePolicy) && data.ReadInt32(workSource)) {
+        int32_t tokenLength = 0;
+        const char16_t* token = data.ReadString16WithLength(tokenLength);
+        if (token != nullptr && tokenLength >= 0 &&
+            std::u16string_view(token, static_cast<size_t>(tokenLength)) == SAMANAGER_INTERFACE_TOKEN) {
+            return true;
+        }
+    }
+    // anything else takes the MessageParcel path, so a rejected token is judged exactly as before
+    data.RewindRead(tokenPosition);
     std::u16string interfaceToken = data.ReadInterfaceToken();
     return interfaceToken == SAMANAGER_INTERFACE_TOKEN;
 }
@@ -684,6 +713,91 @@ int32_t SystemAbilityManagerStub::CheckSystemAbilityInner(MessageParcel& data, M
     return ERR_NONE;
 }
 
+int32_t SystemAbilityManagerStub::CheckGetSystemAbilities(const std::vector<int32_t>& systemAbilityIds,
+    std::vector<int32_t>& errCodes)
+{
+    int32_t permittedNum = 0;
+    errCodes.assign(systemAbilityIds.size(), ERR_OK);
+    for (size_t i = 0; i < systemAbilityIds.size(); ++i) {
+        int32_t systemAbilityId = systemAbilityIds[i];
+        if (!CheckInputSysAbilityId(systemAbilityId)) {
+            HILOGW("GetSystemAbilitiesInner SA:%{public}d invalid!", systemAbilityId);
+            errCodes[i] = ERR_INVALID_VALUE;
+            continue;
+        }
+#ifdef SUPPORT_PENGLAI_MODE
+        if (isPengLai_ && !SamgrUtil::CheckPengLaiPermission(systemAbilityId)) {
+            HILOGW("GetSAs CheckPengLaiPermission denied! SA:%{public}d,callUid:%{public}d",
+                systemAbilityId, OHOS::IPCSkeleton::GetCallingUid());
+            errCodes[i] = ERR_PERMISSION_DENIED;
+            continue;
+        }
+#endif
+        if (!CheckGetSAPermission(systemAbilityId)) {
+            HILOGD("GetSystemAbilitiesInner selinux permission denied! SA:%{public}d,callSid:%{public}s",
+                systemAbilityId, OHOS::IPCSkeleton::GetCallingSid().c_str());
+            errCodes[i] = ERR_PERMISSION_DENIED;
+            continue;
+        }
+        permittedNum++;
+    }
+    return permittedNum;
+}
+
+int32_t SystemAbilityManagerStub::GetSystemAbilitiesInner(MessageParcel& data, MessageParcel& reply)
+{
+    std::vector<int32_t> systemAbilityIds;
+    if (!data.ReadInt32Vector(&systemAbilityIds)) {
+        HILOGW("GetSystemAbilitiesInner read SAIds failed!");
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (systemAbilityIds.empty() || systemAbilityIds.size() > static_cast<size_t>(MAX_BATCH_SA_NUM)) {
+        HILOGW("GetSystemAbilitiesInner invalid size:%{public}zu", systemAbilityIds.size());
+        return ERR_INVALID_VALUE;
+    }
+    std::vector<int32_t> errCodes;
+    int32_t permittedNum = CheckGetSystemAbilities(systemAbilityIds, errCodes);
+    std::vector<int32_t> permittedIds;
+    permittedIds.reserve(permittedNum);
+    for (size_t i = 0; i < systemAbilityIds.size(); ++i) {
+        if (errCodes[i] == ERR_OK) {
+            permittedIds.emplace_back(systemAbilityIds[i]);
+        }
+    }
+    std::vector<sptr<IRemoteObject>> saList;
+    std::vector<int32_t> lookupCodes;
+    if (!permittedIds.empty()) {
+        SamgrXCollie samgrXCollie("samgr--GetSAs_" + std::to_string(permittedIds.size()));
+        int32_t result = GetSystemAbilities(permittedIds, saList, lookupCodes);
+        if (result != ERR_OK || saList.size() != permittedIds.size() || lookupCodes.size() != permittedIds.size()) {
+            HILOGW("GetSystemAbilitiesInner lookup failed, ret:%{public}d", result);
+            return (result != ERR_OK) ? result : ERR_INVALID_VALUE;
+        }
+    }
+    if (!reply.WriteInt32(ERR_OK)) {
+        HILOGW("GetSystemAbilitiesInner write reply failed.");
+        return ERR_FLATTEN_OBJECT;
+    }
+    size_t lookupIndex = 0;
+    for (size_t i = 0; i < systemAbilityIds.size(); ++i) {
+        sptr<IRemoteObject> remoteObject = nullptr;
+        if (errCodes[i] == ERR_OK) {
+            remoteObject = saList[lookupIndex];
+            errCodes[i] = lookupCodes[lookupIndex];
+            lookupIndex++;
+        }
+        if (!reply.WriteInt32(errCodes[i])) {
+            HILOGW("GetSystemAbilitiesInner write errCode failed, SA:%{public}d", systemAbilityIds[i]);
+            return ERR_FLATTEN_OBJECT;
+        }
+        if (errCodes[i] == ERR_OK && !reply.WriteRemoteObject(remoteObject)) {
+            HILOGE("GetSystemAbilitiesInner SA:%{public}d write reply failed.", systemAbilityIds[i]);
+            return ERR_FLATTEN_OBJECT;
+        }
+    }
+    return ERR_NONE;
+}
+
 int32_t SystemAbilityManagerStub::RemoveSystemAbilityInner(MessageParcel& data, MessageParcel& reply)
 {
     if (!CanRequest()) {
@@ -18,11 +18,13 @@
 #include <fstream>
 #include <string>
 #include "datetime_ex.h"
+#include "dynamic_cache.h"
 #include "nlohmann/json.hpp"
 #include "system_ability_manager.h"
 #include "system_ability_manager_util.h"
 #include "parameter.h"
 #include "parameters.h"
+#include "process_name_cache.h"
 #include "accesstoken_kit.h"
 #include "ipc_skeleton.h"
 #include "service_control.h"
@@ -53,6 +55,8 @@ constexpr int32_t MIN_WAIT_NUM = 60;
 constexpr int32_t INIT_PID = 1;
 constexpr int32_t MAX_STRLIST_SIZE = 7;
 constexpr int32_t CONCURRENT_TASK_SERVICE_ID = 1912;
+// starttime is field 22 of /proc/<pid>/stat, index 19 counted from the field after the comm
+constexpr int32_t STAT_START_TIME_INDEX = 19;
 
 constexpr const char* EVENT_TYPE = "eventId";
 constexpr const char* EVENT_NAME = "name";
@@ -64,7 +68,6 @@ constexpr const char* PENG_LAI = "penglai";
 constexpr const char* PENGLAI_PATH = "profile/penglai";
 constexpr const char* LOGGER_TRANSPROC_PATH = "/proc/transaction_proc";
 constexpr const char* SET_PRIOR_PARAM = "const.samgr.setprior.support";
-constexpr const char* SAMGR_CACHE_KEY = "samgr.cache.sa";
 #ifdef SUPPORT_DEVICE_MANAGER
 constexpr const char* PKG_NAME = "Samgr_Networking";
 #endif
@@ -262,10 +265,18 @@ void SamgrUtil::SendUpdateSaState(int32_t systemAbilityId, const std::string& up
 
 void SamgrUtil::InvalidateSACache()
 {
-    auto invalidateCacheTask = [] () {
-        HILOGD("DynamicCache InvalidateCache Begin");
+    for (uint32_t bucket = 0; bucket < DynamicCache::CACHE_BUCKET_NUM; bucket++) {
+        InvalidateSACache(static_cast<int32_t>(bucket));
+    }
+}
+
+void SamgrUtil::InvalidateSACache(int32_t systemAbilityId)
+{
+    std::string cacheKey = DynamicCache::GetCacheKey(systemAbilityId);
+    auto invalidateCacheTask = [cacheKey] () {
+        HILOGD("DynamicCache InvalidateCache Begin %{public}s", cacheKey.c_str());
         string tickCount = to_string(GetTickCount());
-        int32_t ret = SetParameter(SAMGR_CACHE_KEY, tickCount.c_str());
+        int32_t ret = SetParameter(cacheKey.c_str(), tickCount.c_str());
         if (ret != 0) {
             HILOGE("DynamicCache InvalidateCache SetParameter error:%{public}d!", ret);
             return;
@@ -437,6 +448,45 @@ std::string SamgrUtil::GetProcessNameFromCmdline(int32_t pid)
     return name;
 }
 
+uint64_t SamgrUtil::GetProcessStartTime(int32_t pid)
+{
+    std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+    if (!file.is_open()) {
+        return 0;
+    }
+    std::string stat;
+    std::getline(file, stat);
+    // comm may hold spaces and brackets, fields are counted from the last ')'
+    size_t commEnd = stat.rfind(')');
+    if (commEnd == std::string::npos) {
+        return 0;
+    }
+    std::istringstream fields(stat.substr(commEnd + 1));
+    std::string field;
+    for (int32_t i = 0; i <= STAT_START_TIME_INDEX; ++i) {
+        if (!(fields >> field)) {
+            return 0;
+        }
+    }
+    return std::strtoull(field.c_str(), nullptr, 10);
+}
+
+static ProcessNameCache& GetProcessNameCache()
+{
+    static ProcessNameCache processNameCache(SamgrUtil::GetProcessNameFromCmdline, SamgrUtil::GetProcessStartTime);
+    return processNameCache;
+}
+
+std::string SamgrUtil::GetCachedProcessName(int32_t pid)
+{
+    return GetProcessNameCache().Get(pid);
+}
+
+void SamgrUtil::RemoveCachedProcessName(int32_t pid)
+{
+    GetProcessNameCache().Remove(pid);
+}
+
 int SamgrUtil::ParsePeerBinderPid(std::ifstream& fin, int32_t pid, int32_t tid)
 {
     std::string line;
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "system_process_executor.h"
+
+#include "datetime_ex.h"
+#include "sam_log.h"
+#include "string_ex.h"
+
+namespace OHOS {
+SystemProcessExecutor::SystemProcessExecutor()
+{
+    for (size_t index = 0; index < HANDLER_NUM; ++index) {
+        handlers_[index] = std::make_shared<FFRTHandler>("processExecutor" + std::to_string(index));
+    }
+}
+
+std::shared_ptr<FFRTHandler>& SystemProcessExecutor::GetHandler(const std::u16string& processName)
+{
+    return handlers_[std::hash<std::u16string>()(processName) % HANDLER_NUM];
+}
+
+void SystemProcessExecutor::Submit(const std::u16string& processName, ProcessRequest request,
+    ProcessCompletion completion)
+{
+    if (request == nullptr) {
+        HILOGE("SubmitProc:%{public}s request null", Str16ToStr8(processName).c_str());
+        return;
+    }
+    {
+        std::lock_guard<samgr::mutex> autoLock(queueLock_);
+        auto& queue = queues_[processName];
+        queue.requests.push_back({std::move(request), std::move(completion)});
+        if (queue.running) {
+            HILOGI("SubmitProc:%{public}s queued,pending:%{public}zu", Str16ToStr8(processName).c_str(),
+                queue.requests.size());
+            return;
+        }
+        queue.running = true;
+    }
+    auto drainTask = [processName, weakThis = weak_from_this()]() {
+        auto self = weakThis.lock();
+        if (self == nullptr) {
+            return;
+        }
+        self->Drain(processName);
+    };
+    if (!GetHandler(processName)->PostTask(drainTask)) {
+        HILOGE("SubmitProc:%{public}s post failed,drain inline", Str16ToStr8(processName).c_str());
+        Drain(processName);
+    }
+}
+
+void SystemProcessExecutor::Drain(const std::u16string& processName)
+{
+    while (true) {
+        PendingRequest pending;
+        {
+            std::lock_guard<samgr::mutex> autoLock(queueLock_);
+            auto iter = queues_.find(processName);
+            if (iter == queues_.end()) {
+                return;
+            }
+            if (iter->second.requests.empty()) {
+                queues_.erase(iter);
+                return;
+            }
+            pending = std::move(iter->second.requests.front());
+            iter->second.requests.pop_front();
+        }
+        int64_t begin = GetTickCount();
+        int32_t result = pending.request();
+        int64_t duration = GetTickCount() - begin;
+        if (pending.completion != nullptr) {
+            pending.completion(result, duration);
+        }
+    }
+}
+
+size_t SystemProcessExecutor::GetPendingCount()
+{
+    std::lock_guard<samgr::mutex> autoLock(queueLock_);
+    size_t count = 0;
+    for (const auto& [processName, queue] : queues_) {
+        count += queue.requests.size();
+    }
+    return count;
+}
+} // namespace OHOS
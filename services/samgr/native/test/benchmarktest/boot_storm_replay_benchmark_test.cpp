@@ -0,0 +1,842 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ability_death_recipient.h"
+#include "if_local_ability_manager.h"
+#include "if_system_ability_manager.h"
+#include "iremote_stub.h"
+#include "itest_transaction_service.h"
+#include "sa_profiles.h"
+#include "sam_mock_permission.h"
+#include "service_control.h"
+#include "string_ex.h"
+#include "system_ability_load_callback_stub.h"
+#define private public
+#define protected public
+#include "device_param_collect.h"
+#include "device_status_collect_manager.h"
+#include "samgr_latency_stats.h"
+#include "system_ability_manager.h"
+
+using namespace OHOS;
+
+namespace {
+constexpr const char* LOCAL_DEVICE = "local";
+constexpr const char* TRACE_FLAG = "--trace=";
+constexpr int64_t US_PER_MS = 1000;
+// the replay thread samples the queues at least this often while it waits for the next record
+constexpr int64_t SAMPLE_PERIOD_MS = 10;
+// loads still unanswered this long after the last record are counted as lost
+constexpr int64_t DRAIN_TIMEOUT_MS = 10000;
+
+// synthetic boot storm, fixed seed so every run replays the same trace
+constexpr uint32_t TRACE_SEED = 20260401;
+constexpr int32_t REPLAY_SA_ID_BEGIN = 5000;
+constexpr int32_t PROCESS_NUM = 40;
+constexpr uint32_t MAX_SA_PER_PROCESS = 4;
+// processes init starts on its own during boot, the rest start on demand
+constexpr int32_t BOOT_PROCESS_NUM = 8;
+constexpr uint32_t BOOT_START_WINDOW_MS = 500;
+constexpr uint32_t BOOT_WINDOW_MS = 3000;
+constexpr uint32_t MAX_CALLERS_PER_SA = 3;
+constexpr int32_t CALLER_PID_BEGIN = 1000;
+constexpr uint32_t CALLER_NUM = 64;
+// one SA in ON_DEMAND_SA_STEP is also started by its own param event
+constexpr int32_t ON_DEMAND_SA_STEP = 4;
+constexpr int32_t CRASH_NUM = 4;
+constexpr uint32_t RELOAD_AFTER_CRASH_MS = 50;
+constexpr uint32_t USER_SWITCH_MS = 4000;
+constexpr uint32_t USER_SWITCH_WINDOW_MS = 500;
+constexpr uint32_t RELOAD_WINDOW_MS = 1000;
+// one SA in USER_SWITCH_SA_STEP is unloaded on user switch, every other one of those comes back
+constexpr uint32_t USER_SWITCH_SA_STEP = 3;
+constexpr int32_t REPLAY_UNLOAD_DELAY_MS = 200;
+const std::string REPLAY_PARAM_PREFIX = "persist.samgr.replay.";
+
+// fake init and process latencies, derived from the names so they are the same on every run
+constexpr uint64_t MIN_START_LATENCY_MS = 20;
+constexpr uint64_t START_LATENCY_SPREAD_MS = 60;
+constexpr uint64_t MIN_PUBLISH_LATENCY_MS = 5;
+constexpr uint64_t PUBLISH_LATENCY_SPREAD_MS = 10;
+constexpr uint64_t STOP_LATENCY_MS = 10;
+
+int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+enum class TraceOp {
+    LOAD,
+    UNLOAD,
+    PROCESS_START,
+    PROCESS_STOP,
+    EVENT,
+};
+
+struct TraceRecord {
+    int64_t timeMs = 0;
+    TraceOp op = TraceOp::LOAD;
+    int32_t saId = -1;
+    int32_t callerPid = -1;
+    std::string process;
+    std::string name;
+    std::string value;
+};
+
+struct ReplayTrace {
+    std::list<SaProfile> saProfiles;
+    std::vector<TraceRecord> records;
+};
+
+void AddSaProfile(ReplayTrace& trace, int32_t saId, const std::string& process, const std::string& paramName,
+    const std::string& paramValue)
+{
+    SaProfile saProfile;
+    saProfile.process = Str8ToStr16(process);
+    saProfile.saId = saId;
+    saProfile.stopOnDemand.delayTime = REPLAY_UNLOAD_DELAY_MS;
+    if (!paramName.empty()) {
+        OnDemandEvent event = { PARAM, paramName, paramValue };
+        saProfile.startOnDemand.onDemandEvents.emplace_back(event);
+    }
+    trace.saProfiles.emplace_back(std::move(saProfile));
+}
+
+void SortRecords(ReplayTrace& trace)
+{
+    std::stable_sort(trace.records.begin(), trace.records.end(),
+        [](const TraceRecord& record1, const TraceRecord& record2) { return record1.timeMs < record2.timeMs; });
+}
+
+int64_t NextTimeMs(std::mt19937& rng, int64_t beginMs, uint32_t windowMs)
+{
+    return beginMs + static_cast<int64_t>(rng() % windowMs);
+}
+
+int32_t NextCallerPid(std::mt19937& rng)
+{
+    return CALLER_PID_BEGIN + static_cast<int32_t>(rng() % CALLER_NUM);
+}
+
+// Boot: a few processes are started by init, every SA is loaded by one or more callers and some by
+// param events, a few processes crash midway and are loaded again. User switch: a third of the SAs
+// are unloaded and half of those reloaded while their unload is still in flight.
+// Only mt19937 itself is used, its output is fixed by the standard, the distributions are not.
+void GenerateBootStormTrace(ReplayTrace& trace)
+{
+    std::mt19937 rng(TRACE_SEED);
+    std::vector<std::string> processes;
+    std::map<std::string, std::vector<int32_t>> processSas;
+    int32_t saId = REPLAY_SA_ID_BEGIN;
+    for (int32_t i = 0; i < PROCESS_NUM; ++i) {
+        std::string process = "replay_process_" + std::to_string(i);
+        processes.push_back(process);
+        uint32_t saNum = 1 + rng() % MAX_SA_PER_PROCESS;
+        for (uint32_t j = 0; j < saNum; ++j, ++saId) {
+            bool onDemand = (saId % ON_DEMAND_SA_STEP == 0);
+            AddSaProfile(trace, saId, process, onDemand ? REPLAY_PARAM_PREFIX + std::to_string(saId) : "", "true");
+            processSas[process].push_back(saId);
+        }
+    }
+    for (int32_t i = 0; i < BOOT_PROCESS_NUM; ++i) {
+        trace.records.push_back({ NextTimeMs(rng, 0, BOOT_START_WINDOW_MS), TraceOp::PROCESS_START, -1, -1,
+            processes[i] });
+    }
+    for (const auto& saProfile : trace.saProfiles) {
+        uint32_t callerNum = 1 + rng() % MAX_CALLERS_PER_SA;
+        for (uint32_t i = 0; i < callerNum; ++i) {
+            int32_t callerPid = NextCallerPid(rng);
+            trace.records.push_back({ NextTimeMs(rng, 0, BOOT_WINDOW_MS), TraceOp::LOAD, saProfile.saId, callerPid });
+        }
+        for (const auto& event : saProfile.startOnDemand.onDemandEvents) {
+            trace.records.push_back({ NextTimeMs(rng, 0, BOOT_WINDOW_MS), TraceOp::EVENT, -1, -1, "", event.name,
+                event.value });
+        }
+    }
+    for (int32_t i = 0; i < CRASH_NUM; ++i) {
+        const std::string& process = processes[rng() % processes.size()];
+        int64_t crashTime = NextTimeMs(rng, BOOT_WINDOW_MS / 2, BOOT_WINDOW_MS / 2);
+        trace.records.push_back({ crashTime, TraceOp::PROCESS_STOP, -1, -1, process });
+        int32_t callerPid = NextCallerPid(rng);
+        trace.records.push_back({ crashTime + RELOAD_AFTER_CRASH_MS, TraceOp::LOAD, processSas[process].front(),
+            callerPid });
+    }
+    uint32_t unloadCount = 0;
+    for (const auto& saProfile : trace.saProfiles) {
+        if (rng() % USER_SWITCH_SA_STEP != 0) {
+            continue;
+        }
+        int32_t callerPid = NextCallerPid(rng);
+        trace.records.push_back({ NextTimeMs(rng, USER_SWITCH_MS, USER_SWITCH_WINDOW_MS), TraceOp::UNLOAD,
+            saProfile.saId, callerPid });
+        if (unloadCount++ % 2 == 0) {
+            trace.records.push_back({ NextTimeMs(rng, USER_SWITCH_MS + USER_SWITCH_WINDOW_MS, RELOAD_WINDOW_MS),
+                TraceOp::LOAD, saProfile.saId, callerPid });
+        }
+    }
+    SortRecords(trace);
+}
+
+// One declaration or record per line, '#' starts a comment:
+//   sa <saId> <process> [<paramName> <paramValue>]
+//   <timeMs> load <saId> <callerPid>
+//   <timeMs> unload <saId> <callerPid>
+//   <timeMs> start <process>
+//   <timeMs> stop <process>
+//   <timeMs> event <paramName> <paramValue>
+bool ParseTraceLine(const std::string& line, ReplayTrace& trace)
+{
+    std::istringstream stream(line);
+    std::string first;
+    if (!(stream >> first) || first[0] == '#') {
+        return true;
+    }
+    if (first == "sa") {
+        int32_t saId = -1;
+        std::string process;
+        std::string paramName;
+        std::string paramValue;
+        if (!(stream >> saId >> process)) {
+            return false;
+        }
+        stream >> paramName >> paramValue;
+        AddSaProfile(trace, saId, process, paramName, paramValue);
+        return true;
+    }
+    TraceRecord record;
+    std::string op;
+    std::istringstream timeStream(first);
+    if (!(timeStream >> record.timeMs) || !(stream >> op)) {
+        return false;
+    }
+    if (op == "load" || op == "unload") {
+        record.op = (op == "load") ? TraceOp::LOAD : TraceOp::UNLOAD;
+        if (!(stream >> record.saId >> record.callerPid)) {
+            return false;
+        }
+    } else if (op == "start" || op == "stop") {
+        record.op = (op == "start") ? TraceOp::PROCESS_START : TraceOp::PROCESS_STOP;
+        if (!(stream >> record.process)) {
+            return false;
+        }
+    } else if (op == "event") {
+        record.op = TraceOp::EVENT;
+        if (!(stream >> record.name >> record.value)) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    trace.records.emplace_back(std::move(record));
+    return true;
+}
+
+bool LoadTraceFile(const std::string& path, ReplayTrace& trace)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "open trace " << path << " failed" << std::endl;
+        return false;
+    }
+    std::string line;
+    for (int32_t lineNum = 1; std::getline(file, line); ++lineNum) {
+        if (!ParseTraceLine(line, trace)) {
+            std::cerr << path << ":" << lineNum << " bad record: " << line << std::endl;
+            return false;
+        }
+    }
+    SortRecords(trace);
+    return true;
+}
+
+int64_t Percentile(std::vector<int64_t>& samples, uint32_t percent)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = std::min(samples.size() - 1, samples.size() * percent / 100);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+class ReplayStats {
+public:
+    void RecordIssued()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        issued_++;
+    }
+
+    void RecordLoaded(int32_t saId, int64_t costUs)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        timeToLoaded_[saId].push_back(costUs);
+        allTimeToLoaded_.push_back(costUs);
+    }
+
+    void RecordFailed()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        failed_++;
+    }
+
+    void RecordLockWait(int64_t waitUs, int64_t callUs)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        lockWaits_.push_back(waitUs);
+        callCosts_.push_back(callUs);
+    }
+
+    void RecordDepth(size_t pendingLoads, size_t startingSas, size_t initRequests)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        samples_++;
+        pendingLoadSum_ += pendingLoads;
+        pendingLoadMax_ = std::max(pendingLoadMax_, pendingLoads);
+        startingSaMax_ = std::max(startingSaMax_, startingSas);
+        initRequestMax_ = std::max(initRequestMax_, initRequests);
+    }
+
+    bool IsDrained()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return allTimeToLoaded_.size() + failed_ >= issued_;
+    }
+
+    void Report(benchmark::State& state)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        state.counters["loads"] = static_cast<double>(issued_);
+        state.counters["loaded"] = static_cast<double>(allTimeToLoaded_.size());
+        state.counters["failed"] = static_cast<double>(failed_);
+        state.counters["ttl_p50_ms"] = ToMs(Percentile(allTimeToLoaded_, 50));
+        state.counters["ttl_p90_ms"] = ToMs(Percentile(allTimeToLoaded_, 90));
+        state.counters["ttl_p99_ms"] = ToMs(Percentile(allTimeToLoaded_, 99));
+        state.counters["ttl_max_ms"] = ToMs(Percentile(allTimeToLoaded_, 100));
+        state.counters["pending_load_avg"] = (samples_ == 0) ? 0 : static_cast<double>(pendingLoadSum_) / samples_;
+        state.counters["pending_load_max"] = static_cast<double>(pendingLoadMax_);
+        state.counters["starting_sa_max"] = static_cast<double>(startingSaMax_);
+        state.counters["init_queue_max"] = static_cast<double>(initRequestMax_);
+        // the replay thread only sees the wait on the process lock of the SA it loads or unloads
+        state.counters["proc_lock_wait_p50_us"] = static_cast<double>(Percentile(lockWaits_, 50));
+        state.counters["proc_lock_wait_p99_us"] = static_cast<double>(Percentile(lockWaits_, 99));
+        state.counters["proc_lock_wait_max_us"] = static_cast<double>(Percentile(lockWaits_, 100));
+        state.counters["call_p99_us"] = static_cast<double>(Percentile(callCosts_, 99));
+        // the samgr locks every thread contends on, as recorded by samgr itself
+        ReportSamgrLock(state, "ability_map_lock", SamgrLockId::ABILITY_MAP);
+        ReportSamgrLock(state, "listener_map_lock", SamgrLockId::LISTENER_MAP);
+        ReportSamgrLock(state, "on_demand_lock", SamgrLockId::ON_DEMAND);
+    }
+
+    void PrintPerSa(std::ostream& out)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        out << "SA\tloaded\tp50_ms\tp90_ms\tp99_ms\tmax_ms" << std::endl;
+        for (auto& [saId, samples] : timeToLoaded_) {
+            out << saId << "\t" << samples.size() << "\t" << ToMs(Percentile(samples, 50)) << "\t" <<
+                ToMs(Percentile(samples, 90)) << "\t" << ToMs(Percentile(samples, 99)) << "\t" <<
+                ToMs(Percentile(samples, 100)) << std::endl;
+        }
+    }
+
+private:
+    static double ToMs(int64_t us)
+    {
+        return static_cast<double>(us) / US_PER_MS;
+    }
+
+    // only acquisitions that blocked are recorded, so the count is how often the lock was contended
+    static void ReportSamgrLock(benchmark::State& state, const std::string& name, SamgrLockId lockId)
+    {
+        LatencySnapshot snapshot = SamgrLatencyStats::GetInstance().GetLockStats(lockId).GetSnapshot();
+        state.counters[name + "_blocked"] = static_cast<double>(snapshot.count);
+        state.counters[name + "_p50_us"] = static_cast<double>(snapshot.GetPercentileUs(50));
+        state.counters[name + "_p99_us"] = static_cast<double>(snapshot.GetPercentileUs(99));
+        state.counters[name + "_max_us"] = static_cast<double>(snapshot.maxUs);
+    }
+
+    std::mutex lock_;
+    size_t issued_ = 0;
+    size_t failed_ = 0;
+    std::map<int32_t, std::vector<int64_t>> timeToLoaded_;
+    std::vector<int64_t> allTimeToLoaded_;
+    std::vector<int64_t> lockWaits_;
+    std::vector<int64_t> callCosts_;
+    size_t samples_ = 0;
+    size_t pendingLoadSum_ = 0;
+    size_t pendingLoadMax_ = 0;
+    size_t startingSaMax_ = 0;
+    size_t initRequestMax_ = 0;
+};
+
+ReplayStats g_lastStats;
+std::string g_tracePath;
+
+class ReplayLoadCallback : public SystemAbilityLoadCallbackStub {
+public:
+    ReplayLoadCallback(ReplayStats& stats, int64_t issuedUs) : stats_(stats), issuedUs_(issuedUs) {}
+
+    void OnLoadSystemAbilitySuccess(int32_t systemAbilityId, const sptr<IRemoteObject>& remoteObject) override
+    {
+        stats_.RecordLoaded(systemAbilityId, NowUs() - issuedUs_);
+    }
+
+    void OnLoadSystemAbilityFail(int32_t systemAbilityId) override
+    {
+        stats_.RecordFailed();
+    }
+
+private:
+    ReplayStats& stats_;
+    int64_t issuedUs_;
+};
+
+// Stands in for init and the SA processes: a started process registers itself and publishes the SA it
+// was started for, samgr's start/stop ability requests publish and remove SAs, a stopped process drops
+// everything it published. All of it runs on the backend's own queue, after fixed per-name latencies.
+class FakeInitBackend {
+public:
+    static FakeInitBackend& GetInstance()
+    {
+        static FakeInitBackend instance;
+        return instance;
+    }
+
+    void Attach(const sptr<SystemAbilityManager>& saMgr, const std::list<SaProfile>& saProfiles)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        saMgr_ = saMgr;
+        processes_.clear();
+        for (const auto& saProfile : saProfiles) {
+            processes_[Str16ToStr8(saProfile.process)].saList.push_back(saProfile.saId);
+        }
+        if (handler_ == nullptr) {
+            handler_ = std::make_shared<FFRTHandler>("FakeInitBackend");
+        }
+    }
+
+    int32_t Start(const std::string& process, int32_t saId)
+    {
+        handler_->PostTask([this, process, saId]() { StartProcess(process, { saId }); },
+            MIN_START_LATENCY_MS + std::hash<std::string>()(process) % START_LATENCY_SPREAD_MS);
+        return 0;
+    }
+
+    // init starts the process by itself and it publishes all of its SAs
+    void Boot(const std::string& process)
+    {
+        std::vector<int32_t> saList;
+        {
+            std::lock_guard<std::mutex> autoLock(lock_);
+            auto iter = processes_.find(process);
+            if (iter == processes_.end()) {
+                return;
+            }
+            saList = iter->second.saList;
+        }
+        handler_->PostTask([this, process, saList]() { StartProcess(process, saList); });
+    }
+
+    int32_t Stop(const std::string& process)
+    {
+        handler_->PostTask([this, process]() { ExitProcess(process); }, STOP_LATENCY_MS);
+        return 0;
+    }
+
+    // the trace's process stop is a crash, nothing is unloaded first
+    void Kill(const std::string& process)
+    {
+        handler_->PostTask([this, process]() { ExitProcess(process); });
+    }
+
+    bool IsStopped(const std::string& process)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = processes_.find(process);
+        return iter == processes_.end() || !iter->second.running;
+    }
+
+    void PostPublish(const std::string& process, int32_t saId)
+    {
+        handler_->PostTask([this, process, saId]() { Publish(process, saId); },
+            MIN_PUBLISH_LATENCY_MS + static_cast<uint64_t>(saId) % PUBLISH_LATENCY_SPREAD_MS);
+    }
+
+    void PostUnpublish(const std::string& process, int32_t saId)
+    {
+        handler_->PostTask([this, process, saId]() { Unpublish(process, saId); });
+    }
+
+private:
+    struct FakeProcess {
+        std::vector<int32_t> saList;
+        bool running = false;
+        sptr<IRemoteObject> localAbilityManager;
+        std::map<int32_t, sptr<IRemoteObject>> abilities;
+    };
+
+    void StartProcess(const std::string& process, const std::vector<int32_t>& saList);
+    void ExitProcess(const std::string& process);
+
+    void Publish(const std::string& process, int32_t saId)
+    {
+        sptr<IRemoteObject> ability;
+        sptr<SystemAbilityManager> saMgr;
+        {
+            std::lock_guard<std::mutex> autoLock(lock_);
+            auto iter = processes_.find(process);
+            if (iter == processes_.end() || !iter->second.running || iter->second.abilities.count(saId) != 0) {
+                return;
+            }
+            ability = new TestTransactionService();
+            iter->second.abilities[saId] = ability;
+            saMgr = saMgr_;
+        }
+        saMgr->AddSystemAbility(saId, ability,
+            ISystemAbilityManager::SAExtraProp(false, ISystemAbilityManager::DUMP_FLAG_PRIORITY_DEFAULT, u"", u""));
+    }
+
+    void Unpublish(const std::string& process, int32_t saId)
+    {
+        sptr<SystemAbilityManager> saMgr;
+        {
+            std::lock_guard<std::mutex> autoLock(lock_);
+            auto iter = processes_.find(process);
+            if (iter == processes_.end() || iter->second.abilities.erase(saId) == 0) {
+                return;
+            }
+            saMgr = saMgr_;
+        }
+        saMgr->RemoveSystemAbility(saId);
+    }
+
+    std::mutex lock_;
+    sptr<SystemAbilityManager> saMgr_;
+    std::map<std::string, FakeProcess> processes_;
+    std::shared_ptr<FFRTHandler> handler_;
+};
+
+class FakeLocalAbilityManager : public IRemoteStub<ILocalAbilityManager> {
+public:
+    explicit FakeLocalAbilityManager(const std::string& process) : process_(process) {}
+
+    bool StartAbility(int32_t systemAbilityId, const std::string& eventStr) override
+    {
+        FakeInitBackend::GetInstance().PostPublish(process_, systemAbilityId);
+        return true;
+    }
+
+    bool StopAbility(int32_t systemAbilityId, const std::string& eventStr) override
+    {
+        FakeInitBackend::GetInstance().PostUnpublish(process_, systemAbilityId);
+        return true;
+    }
+
+    bool ActiveAbility(int32_t systemAbilityId, const nlohmann::json& activeReason) override { return true; }
+    bool IdleAbility(int32_t systemAbilityId, const nlohmann::json& idleReason, int32_t& delayTime) override
+    {
+        delayTime = 0;
+        return true;
+    }
+    bool SendStrategyToSA(int32_t type, int32_t systemAbilityId, int32_t level, std::string& action) override
+    { return true; }
+    bool IpcStatCmdProc(int32_t fd, int32_t cmd) override { return true; }
+    bool FfrtStatCmdProc(int32_t fd, int32_t cmd) override { return true; }
+    bool FfrtDumperProc(std::string& result) override { return true; }
+    int32_t SystemAbilityExtProc(const std::string& extension, int32_t said,
+        SystemAbilityExtensionPara* callback, bool isAsync) override { return ERR_OK; }
+    int32_t ServiceControlCmd(int32_t fd, int32_t systemAbilityId,
+        const std::vector<std::u16string>& args) override { return ERR_OK; }
+
+private:
+    std::string process_;
+};
+
+void FakeInitBackend::StartProcess(const std::string& process, const std::vector<int32_t>& saList)
+{
+    sptr<IRemoteObject> localAbilityManager;
+    sptr<SystemAbilityManager> saMgr;
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = processes_.find(process);
+        if (iter == processes_.end()) {
+            return;
+        }
+        if (!iter->second.running) {
+            iter->second.running = true;
+            iter->second.localAbilityManager = new FakeLocalAbilityManager(process);
+            localAbilityManager = iter->second.localAbilityManager;
+        }
+        saMgr = saMgr_;
+    }
+    if (localAbilityManager != nullptr) {
+        saMgr->AddSystemProcess(Str8ToStr16(process), localAbilityManager);
+    }
+    for (auto saId : saList) {
+        PostPublish(process, saId);
+    }
+}
+
+void FakeInitBackend::ExitProcess(const std::string& process)
+{
+    FakeProcess exited;
+    sptr<SystemAbilityManager> saMgr;
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = processes_.find(process);
+        if (iter == processes_.end() || !iter->second.running) {
+            return;
+        }
+        exited.localAbilityManager = std::move(iter->second.localAbilityManager);
+        exited.abilities.swap(iter->second.abilities);
+        iter->second.running = false;
+        saMgr = saMgr_;
+    }
+    // what the death recipients of the abilities and of the process would report
+    for (auto& [saId, ability] : exited.abilities) {
+        saMgr->RemoveSystemAbility(ability);
+    }
+    saMgr->RemoveSystemProcess(exited.localAbilityManager);
+}
+
+class BootStormReplayer {
+public:
+    explicit BootStormReplayer(const ReplayTrace& trace) : trace_(trace) {}
+
+    void Run(ReplayStats& stats)
+    {
+        InitSaMgr();
+        FakeInitBackend::GetInstance().Attach(saMgr_, trace_.saProfiles);
+        int64_t beginUs = NowUs();
+        for (const auto& record : trace_.records) {
+            WaitUntil(stats, beginUs + record.timeMs * US_PER_MS);
+            Dispatch(record, stats);
+        }
+        int64_t drainDeadlineUs = NowUs() + DRAIN_TIMEOUT_MS * US_PER_MS;
+        while (!stats.IsDrained() && NowUs() < drainDeadlineUs) {
+            WaitUntil(stats, NowUs() + SAMPLE_PERIOD_MS * US_PER_MS);
+        }
+        saMgr_->CleanFfrt();
+    }
+
+private:
+    // wired up the way Init does it, with the trace's profiles instead of the ones on disk
+    void InitSaMgr()
+    {
+        SamMockPermission::MockPermission();
+        saMgr_ = new SystemAbilityManager;
+        saMgr_->selfPtr_ = std::shared_ptr<BaseSystemAbilityManager>(saMgr_.GetRefPtr(),
+            [](BaseSystemAbilityManager*) {});
+        std::weak_ptr<BaseSystemAbilityManager> weakMgr = saMgr_->weak_from_this();
+        saMgr_->abilityDeath_ = sptr<IRemoteObject::DeathRecipient>(new AbilityDeathRecipient(weakMgr));
+        saMgr_->systemProcessDeath_ = sptr<IRemoteObject::DeathRecipient>(
+            new SystemProcessDeathRecipient(weakMgr));
+        saMgr_->abilityStatusDeath_ = sptr<IRemoteObject::DeathRecipient>(
+            new AbilityStatusDeathRecipient(weakMgr));
+        saMgr_->abilityCallbackDeath_ = sptr<IRemoteObject::DeathRecipient>(
+            new AbilityCallbackDeathRecipient(weakMgr));
+        saMgr_->remoteCallbackDeath_ = sptr<IRemoteObject::DeathRecipient>(
+            new RemoteCallbackDeathRecipient(weakMgr));
+        saMgr_->workHandler_ = std::make_shared<FFRTHandler>("workHandler");
+        saMgr_->collectManager_ = sptr<DeviceStatusCollectManager>(new DeviceStatusCollectManager(weakMgr));
+        saMgr_->collectManager_->collectPluginMap_[PARAM] = new DeviceParamCollect(saMgr_->collectManager_, weakMgr);
+        saMgr_->collectManager_->FilterOnDemandSaProfiles(trace_.saProfiles);
+        saMgr_->abilityStateScheduler_ = std::make_shared<SystemAbilityStateScheduler>(weakMgr);
+        for (const auto& saProfile : trace_.saProfiles) {
+            CommonSaProfile commonProfile;
+            commonProfile.process = saProfile.process;
+            commonProfile.saId = saProfile.saId;
+            saMgr_->saProfileMap_[saProfile.saId] = commonProfile;
+        }
+        saMgr_->abilityStateScheduler_->Init(trace_.saProfiles);
+        saMgr_->abilityStateScheduler_->InitSamgrProcessContext();
+    }
+
+    void WaitUntil(ReplayStats& stats, int64_t deadlineUs)
+    {
+        for (int64_t nowUs = NowUs(); nowUs < deadlineUs; nowUs = NowUs()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(
+                std::min(deadlineUs - nowUs, SAMPLE_PERIOD_MS * US_PER_MS)));
+            SampleDepth(stats);
+        }
+    }
+
+    void SampleDepth(ReplayStats& stats)
+    {
+        size_t pendingLoads = 0;
+        for (const auto& saProfile : trace_.saProfiles) {
+            std::shared_ptr<SystemAbilityContext> abilityContext;
+            if (!saMgr_->abilityStateScheduler_->GetSystemAbilityContext(saProfile.saId, abilityContext)) {
+                continue;
+            }
+            std::lock_guard<samgr::mutex> autoLock(abilityContext->ownProcessContext->processLock);
+            pendingLoads += abilityContext->pendingLoadEventList.size();
+        }
+        stats.RecordDepth(pendingLoads, saMgr_->startingAbilityMap_.size(),
+            saMgr_->processExecutor_->GetPendingCount());
+    }
+
+    // how long the SA's process lock keeps a request waiting right now, probed just before the request
+    int64_t ProbeProcessLockWait(int32_t saId)
+    {
+        std::shared_ptr<SystemAbilityContext> abilityContext;
+        if (!saMgr_->abilityStateScheduler_->GetSystemAbilityContext(saId, abilityContext)) {
+            return 0;
+        }
+        int64_t beginUs = NowUs();
+        std::lock_guard<samgr::mutex> autoLock(abilityContext->ownProcessContext->processLock);
+        return NowUs() - beginUs;
+    }
+
+    void Dispatch(const TraceRecord& record, ReplayStats& stats)
+    {
+        auto& scheduler = saMgr_->abilityStateScheduler_;
+        switch (record.op) {
+            case TraceOp::LOAD: {
+                int64_t waitUs = ProbeProcessLockWait(record.saId);
+                int64_t beginUs = NowUs();
+                LoadRequestInfo loadRequestInfo = { LOCAL_DEVICE, new ReplayLoadCallback(stats, beginUs),
+                    record.saId, record.callerPid, { INTERFACE_CALL, "load" } };
+                stats.RecordIssued();
+                if (scheduler->HandleLoadAbilityEvent(loadRequestInfo) != ERR_OK) {
+                    stats.RecordFailed();
+                }
+                stats.RecordLockWait(waitUs, NowUs() - beginUs);
+                break;
+            }
+            case TraceOp::UNLOAD: {
+                int64_t waitUs = ProbeProcessLockWait(record.saId);
+                int64_t beginUs = NowUs();
+                OnDemandEvent unloadEvent = { INTERFACE_CALL, "unload" };
+                scheduler->HandleUnloadAbilityEvent(
+                    std::make_shared<UnloadRequestInfo>(unloadEvent, record.saId, record.callerPid));
+                stats.RecordLockWait(waitUs, NowUs() - beginUs);
+                break;
+            }
+            case TraceOp::PROCESS_START:
+                FakeInitBackend::GetInstance().Boot(record.process);
+                break;
+            case TraceOp::PROCESS_STOP:
+                FakeInitBackend::GetInstance().Kill(record.process);
+                break;
+            case TraceOp::EVENT: {
+                OnDemandEvent event = { PARAM, record.name, record.value };
+                std::list<SaControlInfo> saControlList;
+                saMgr_->collectManager_->GetSaControlListByEvent(event, saControlList);
+                saMgr_->ProcessOnDemandEvent(event, saControlList);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    const ReplayTrace& trace_;
+    sptr<SystemAbilityManager> saMgr_;
+};
+
+void BootStormReplay(benchmark::State& state)
+{
+    ReplayTrace trace;
+    if (g_tracePath.empty()) {
+        GenerateBootStormTrace(trace);
+    } else if (!LoadTraceFile(g_tracePath, trace)) {
+        state.SkipWithError("bad trace");
+        return;
+    }
+    SamgrLatencyStats::GetInstance().Reset();
+    for (auto _ : state) {
+        BootStormReplayer replayer(trace);
+        replayer.Run(g_lastStats);
+    }
+    state.counters["records"] = static_cast<double>(trace.records.size());
+    state.counters["sa"] = static_cast<double>(trace.saProfiles.size());
+    g_lastStats.Report(state);
+}
+} // namespace
+
+// the fake init, every start and stop samgr asks for lands here instead of the real init
+int ServiceControlWithExtra(const char* serviceName, int action, const char* extArgv[], int extArgc)
+{
+    if (serviceName == nullptr) {
+        return -1;
+    }
+    if (action == ServiceAction::START) {
+        // samgr passes "<saId>#<eventId>#..." as the only extra argument
+        int32_t saId = (extArgc > 0 && extArgv != nullptr && extArgv[0] != nullptr) ? std::atoi(extArgv[0]) : -1;
+        return FakeInitBackend::GetInstance().Start(serviceName, saId);
+    }
+    if (action == ServiceAction::STOP) {
+        return FakeInitBackend::GetInstance().Stop(serviceName);
+    }
+    return 0;
+}
+
+int ServiceWaitForStatus(const char* serviceName, ServiceStatus status, int waitTimeout)
+{
+    if (serviceName == nullptr || status != ServiceStatus::SERVICE_STOPPED) {
+        return 0;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(waitTimeout);
+    while (!FakeInitBackend::GetInstance().IsStopped(serviceName)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return 0;
+}
+
+BENCHMARK(BootStormReplay)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// --trace=<file> replays a recorded trace instead of the synthetic boot storm, the per-SA
+// time-to-loaded table of the last replay is printed after the summary
+int main(int argc, char** argv)
+{
+    int32_t keptArgc = 0;
+    for (int32_t i = 0; i < argc; ++i) {
+        if (std::strncmp(argv[i], TRACE_FLAG, std::strlen(TRACE_FLAG)) == 0) {
+            g_tracePath = argv[i] + std::strlen(TRACE_FLAG);
+            continue;
+        }
+        argv[keptArgc++] = argv[i];
+    }
+    argc = keptArgc;
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    g_lastStats.PrintPerSa(std::cout);
+    return 0;
+}
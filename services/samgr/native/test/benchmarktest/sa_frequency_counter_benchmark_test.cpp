@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <mutex>
+
+#include "benchmark/benchmark.h"
+#include "sa_frequency_counter.h"
+
+using namespace OHOS;
+
+namespace {
+constexpr int32_t MAX_SA_FREQUENCY_COUNT = INT32_MAX - 1000000;
+constexpr int32_t SA_NUM = 64;
+constexpr int32_t MAX_THREAD_NUM = 16;
+constexpr int32_t SHFIT_BIT = 32;
+
+uint64_t GenerateKey(int32_t uid, int32_t saId)
+{
+    return (static_cast<uint64_t>(uid) << SHFIT_BIT) | static_cast<uint32_t>(saId);
+}
+
+// the single-mutex map that UpdateSaFreMap used before the counters were sharded
+samgr::mutex g_globalLock;
+std::map<uint64_t, int32_t> g_globalMap;
+
+void GlobalLockFrequencyMap(benchmark::State& state)
+{
+    int32_t saId = 0;
+    for (auto _ : state) {
+        uint64_t key = GenerateKey(state.thread_index(), saId++ % SA_NUM);
+        std::lock_guard<samgr::mutex> autoLock(g_globalLock);
+        auto& count = g_globalMap[key];
+        if (count < MAX_SA_FREQUENCY_COUNT) {
+            count++;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+SaFrequencyCounter g_counter;
+
+void ShardedFrequencyCounter(benchmark::State& state)
+{
+    int32_t saId = 0;
+    for (auto _ : state) {
+        uint64_t key = GenerateKey(state.thread_index(), saId++ % SA_NUM);
+        g_counter.Increase(key, MAX_SA_FREQUENCY_COUNT);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void ShardedFrequencyCounterDrain(benchmark::State& state)
+{
+    std::map<uint64_t, int32_t> merged;
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int32_t saId = 0; saId < SA_NUM; ++saId) {
+            g_counter.Increase(GenerateKey(0, saId), MAX_SA_FREQUENCY_COUNT);
+        }
+        state.ResumeTiming();
+        g_counter.Drain(merged, MAX_SA_FREQUENCY_COUNT);
+    }
+}
+} // namespace
+
+BENCHMARK(GlobalLockFrequencyMap)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(ShardedFrequencyCounter)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(ShardedFrequencyCounterDrain);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "itest_transaction_service.h"
+#include "sa_status_change_mock.h"
+#include "samgr_benchmark_fixture.h"
+#include "string_ex.h"
+
+using namespace OHOS;
+
+namespace {
+// far from the real SA ids, so nothing on the device reacts to them
+constexpr int32_t BENCH_SA_ID_BEGIN = 6000;
+constexpr int32_t MAX_THREAD_NUM = 16;
+// distinct SAs each thread loads in turn
+constexpr int32_t SA_PER_THREAD = 16;
+// clients waiting on one load, each with its own callback
+constexpr int32_t CALLBACK_NUM = 4;
+constexpr int32_t STRIPE_NUM = static_cast<int32_t>(SaStripedMap<SystemAbilityManager::AbilityItem>::STRIPE_NUM);
+// past the spread ids and in the same stripe as BENCH_SA_ID_BEGIN
+constexpr int32_t COLLIDING_SA_ID_BEGIN = BENCH_SA_ID_BEGIN + MAX_THREAD_NUM * SA_PER_THREAD * STRIPE_NUM;
+const std::string BENCH_PROCESS_PREFIX = "samgr_benchmark_process_";
+
+// adjacent ids land in different stripes
+int32_t GetSpreadSaId(int32_t threadIndex, int32_t index)
+{
+    return BENCH_SA_ID_BEGIN + threadIndex * SA_PER_THREAD + index;
+}
+
+// every id lands in one stripe, as all of them did under the single onDemandLock_
+int32_t GetCollidingSaId(int32_t threadIndex, int32_t index)
+{
+    return COLLIDING_SA_ID_BEGIN + (threadIndex * SA_PER_THREAD + index) * STRIPE_NUM;
+}
+
+std::u16string GetProcessName(int32_t threadIndex)
+{
+    return Str8ToStr16(BENCH_PROCESS_PREFIX + std::to_string(threadIndex));
+}
+
+// Every thread owns one process and the SAs it loads, so the process locks of the scheduler never
+// collide and the stripes of startingAbilityMap_ are the only lock shared between threads. The
+// processes are marked as being started by init, so a load registers its callbacks and returns.
+class LoadFixture {
+public:
+    static LoadFixture& GetInstance()
+    {
+        static LoadFixture instance;
+        return instance;
+    }
+
+    sptr<SystemAbilityManager> saMgr_;
+    sptr<IRemoteObject> ability_;
+    std::array<std::array<sptr<ISystemAbilityLoadCallback>, CALLBACK_NUM>, MAX_THREAD_NUM> callbacks_;
+
+private:
+    LoadFixture()
+    {
+        std::list<SaProfile> saProfiles;
+        for (int32_t threadIndex = 0; threadIndex < MAX_THREAD_NUM; ++threadIndex) {
+            for (int32_t index = 0; index < SA_PER_THREAD; ++index) {
+                AddProfile(saProfiles, threadIndex, GetSpreadSaId(threadIndex, index));
+                AddProfile(saProfiles, threadIndex, GetCollidingSaId(threadIndex, index));
+            }
+            for (auto& callback : callbacks_[threadIndex]) {
+                callback = new SystemAbilityLoadCallbackMock();
+            }
+        }
+        saMgr_ = CreateBenchmarkSaMgr(saProfiles);
+        ability_ = new TestTransactionService();
+        for (int32_t threadIndex = 0; threadIndex < MAX_THREAD_NUM; ++threadIndex) {
+            std::u16string procName = GetProcessName(threadIndex);
+            SystemAbilityManager::StartingProcessInfo startingProcessInfo = {procName, -1, -1, "", -1, 0};
+            saMgr_->startingProcessMap_.emplace(procName, std::move(startingProcessInfo));
+        }
+    }
+
+    static void AddProfile(std::list<SaProfile>& saProfiles, int32_t threadIndex, int32_t saId)
+    {
+        SaProfile saProfile;
+        saProfile.process = GetProcessName(threadIndex);
+        saProfile.saId = saId;
+        saProfiles.emplace_back(saProfile);
+    }
+};
+
+// LoadSystemAbility from every client, then the loaded half of AddSystemAbility: drop the load
+// timeout, notify the callbacks and erase the starting entry. The SA goes back to NOT_LOADED instead
+// of being registered, so the next round loads it again and abilityMapLock_ stays out of the loop.
+void LoadAndNotify(LoadFixture& fixture, int32_t threadIndex, int32_t saId)
+{
+    auto& saMgr = fixture.saMgr_;
+    for (const auto& callback : fixture.callbacks_[threadIndex]) {
+        benchmark::DoNotOptimize(saMgr->LoadSystemAbility(saId, callback));
+    }
+    saMgr->RemoveCheckLoadedMsg(saId);
+    saMgr->NotifySystemAbilityLoaded(saId, fixture.ability_);
+    std::shared_ptr<SystemAbilityContext> abilityContext;
+    if (saMgr->abilityStateScheduler_->GetSystemAbilityContext(saId, abilityContext)) {
+        std::lock_guard<samgr::mutex> autoLock(abilityContext->ownProcessContext->processLock);
+        abilityContext->state = SystemAbilityState::NOT_LOADED;
+    }
+}
+
+template <int32_t (*GetSaId)(int32_t, int32_t)>
+void ParallelLoad(benchmark::State& state)
+{
+    auto& fixture = LoadFixture::GetInstance();
+    int32_t threadIndex = state.thread_index() % MAX_THREAD_NUM;
+    for (auto _ : state) {
+        for (int32_t index = 0; index < SA_PER_THREAD; ++index) {
+            LoadAndNotify(fixture, threadIndex, GetSaId(threadIndex, index));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * SA_PER_THREAD);
+}
+
+void CollidingStripeParallelLoad(benchmark::State& state)
+{
+    ParallelLoad<GetCollidingSaId>(state);
+}
+
+void SpreadStripeParallelLoad(benchmark::State& state)
+{
+    ParallelLoad<GetSpreadSaId>(state);
+}
+} // namespace
+
+BENCHMARK(CollidingStripeParallelLoad)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(SpreadStripeParallelLoad)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMGR_SERVICES_SAMGR_NATIVE_TEST_BENCHMARKTEST_SAMGR_BENCHMARK_FIXTURE_H
+#define SAMGR_SERVICES_SAMGR_NATIVE_TEST_BENCHMARKTEST_SAMGR_BENCHMARK_FIXTURE_H
+
+#include <list>
+#include <memory>
+
+#include "ability_death_recipient.h"
+#include "sa_profiles.h"
+#include "sam_mock_permission.h"
+#define private public
+#define protected public
+#include "device_param_collect.h"
+#include "device_status_collect_manager.h"
+#include "system_ability_manager.h"
+
+namespace OHOS {
+// A SystemAbilityManager wired up the way Init does it, with saProfiles instead of the profiles on disk.
+inline sptr<SystemAbilityManager> CreateBenchmarkSaMgr(const std::list<SaProfile>& saProfiles)
+{
+    SamMockPermission::MockPermission();
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    saMgr->selfPtr_ = std::shared_ptr<BaseSystemAbilityManager>(saMgr.GetRefPtr(),
+        [](BaseSystemAbilityManager*) {});
+    std::weak_ptr<BaseSystemAbilityManager> weakMgr = saMgr->weak_from_this();
+    saMgr->abilityDeath_ = sptr<IRemoteObject::DeathRecipient>(new AbilityDeathRecipient(weakMgr));
+    saMgr->systemProcessDeath_ = sptr<IRemoteObject::DeathRecipient>(new SystemProcessDeathRecipient(weakMgr));
+    saMgr->abilityStatusDeath_ = sptr<IRemoteObject::DeathRecipient>(new AbilityStatusDeathRecipient(weakMgr));
+    saMgr->abilityCallbackDeath_ = sptr<IRemoteObject::DeathRecipient>(
+        new AbilityCallbackDeathRecipient(weakMgr));
+    saMgr->remoteCallbackDeath_ = sptr<IRemoteObject::DeathRecipient>(new RemoteCallbackDeathRecipient(weakMgr));
+    saMgr->workHandler_ = std::make_shared<FFRTHandler>("workHandler");
+    saMgr->collectManager_ = sptr<DeviceStatusCollectManager>(new DeviceStatusCollectManager(weakMgr));
+    saMgr->abilityStateScheduler_ = std::make_shared<SystemAbilityStateScheduler>(weakMgr);
+    for (const auto& saProfile : saProfiles) {
+        CommonSaProfile commonProfile;
+        commonProfile.process = saProfile.process;
+        commonProfile.saId = saProfile.saId;
+        saMgr->saProfileMap_[saProfile.saId] = commonProfile;
+    }
+    saMgr->abilityStateScheduler_->Init(saProfiles);
+    saMgr->abilityStateScheduler_->InitSamgrProcessContext();
+    return saMgr;
+}
+} // namespace OHOS
+#endif // SAMGR_SERVICES_SAMGR_NATIVE_TEST_BENCHMARKTEST_SAMGR_BENCHMARK_FIXTURE_H
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "if_system_ability_manager.h"
+#include "itest_transaction_service.h"
+#include "sa_status_change_mock.h"
+#include "samgr_benchmark_fixture.h"
+#include "samgr_ipc_interface_code.h"
+#include "string_ex.h"
+
+using namespace OHOS;
+
+namespace {
+// far from the real SA ids, so nothing on the device reacts to them
+constexpr int32_t BENCH_SA_ID_BEGIN = 5000;
+constexpr int32_t REGISTERED_SA_NUM = 64;
+// each benchmark thread owns one SA id above the registered range for the mutating calls
+constexpr int32_t THREAD_SA_ID_BEGIN = BENCH_SA_ID_BEGIN + REGISTERED_SA_NUM;
+constexpr int32_t MAX_THREAD_NUM = 8;
+const std::u16string BENCH_PROCESS_NAME = u"samgr_benchmark_process";
+const std::string BENCH_PARAM_PREFIX = "persist.samgr.benchmark.";
+
+SaProfile MakeProfile(int32_t saId)
+{
+    SaProfile saProfile;
+    saProfile.process = BENCH_PROCESS_NAME;
+    saProfile.saId = saId;
+    OnDemandEvent event = { PARAM, BENCH_PARAM_PREFIX + std::to_string(saId % REGISTERED_SA_NUM), "true" };
+    saProfile.startOnDemand.onDemandEvents.emplace_back(event);
+    return saProfile;
+}
+
+// The registered SAs belong to one started process and are already loaded, so every call stays in samgr.
+class RegistryFixture {
+public:
+    static RegistryFixture& GetInstance()
+    {
+        static RegistryFixture instance;
+        return instance;
+    }
+
+    sptr<SystemAbilityManager> saMgr_;
+    std::vector<sptr<IRemoteObject>> abilities_;
+
+private:
+    RegistryFixture()
+    {
+        std::list<SaProfile> saProfiles;
+        for (int32_t saId = BENCH_SA_ID_BEGIN; saId < THREAD_SA_ID_BEGIN + MAX_THREAD_NUM; ++saId) {
+            saProfiles.emplace_back(MakeProfile(saId));
+        }
+        saMgr_ = CreateBenchmarkSaMgr(saProfiles);
+
+        for (int32_t saId = BENCH_SA_ID_BEGIN; saId < THREAD_SA_ID_BEGIN; ++saId) {
+            sptr<IRemoteObject> ability(new TestTransactionService());
+            saMgr_->AddSystemAbility(saId, ability,
+                ISystemAbilityManager::SAExtraProp(false, ISystemAbilityManager::DUMP_FLAG_PRIORITY_DEFAULT,
+                u"", u""));
+            abilities_.emplace_back(ability);
+            std::shared_ptr<SystemAbilityContext> abilityContext;
+            if (saMgr_->abilityStateScheduler_->GetSystemAbilityContext(saId, abilityContext)) {
+                abilityContext->state = SystemAbilityState::LOADED;
+                abilityContext->ownProcessContext->state = SystemProcessState::STARTED;
+            }
+        }
+    }
+};
+
+int32_t GetThreadSaId(const benchmark::State& state)
+{
+    return THREAD_SA_ID_BEGIN + state.thread_index() % MAX_THREAD_NUM;
+}
+
+int32_t GetRegisteredSaId(int64_t index)
+{
+    return BENCH_SA_ID_BEGIN + static_cast<int32_t>(index % REGISTERED_SA_NUM);
+}
+
+void CheckSystemAbility(benchmark::State& state)
+{
+    auto& saMgr = RegistryFixture::GetInstance().saMgr_;
+    int64_t index = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(saMgr->CheckSystemAbility(GetRegisteredSaId(index++)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// each iteration registers the thread's SA and removes it again, so the map keeps its warm size
+void AddSystemAbility(benchmark::State& state)
+{
+    auto& saMgr = RegistryFixture::GetInstance().saMgr_;
+    int32_t saId = GetThreadSaId(state);
+    sptr<IRemoteObject> ability(new TestTransactionService());
+    ISystemAbilityManager::SAExtraProp extraProp(false, ISystemAbilityManager::DUMP_FLAG_PRIORITY_DEFAULT,
+        u"", u"");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(saMgr->AddSystemAbility(saId, ability, extraProp));
+        saMgr->RemoveSystemAbility(saId);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void SubscribeSystemAbility(benchmark::State& state)
+{
+    auto& saMgr = RegistryFixture::GetInstance().saMgr_;
+    int32_t saId = GetThreadSaId(state);
+    sptr<ISystemAbilityStatusChange> listener(new SaStatusChangeMock());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(saMgr->SubscribeSystemAbility(saId, listener));
+        saMgr->UnSubscribeSystemAbility(saId, listener);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// the SA is loaded, so the request is answered from samgr without starting a process
+void LoadSystemAbility(benchmark::State& state)
+{
+    auto& saMgr = RegistryFixture::GetInstance().saMgr_;
+    sptr<ISystemAbilityLoadCallback> callback(new SystemAbilityLoadCallbackMock());
+    int64_t index = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(saMgr->LoadSystemAbility(GetRegisteredSaId(index++), callback));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void OnRemoteRequest(benchmark::State& state)
+{
+    auto& saMgr = RegistryFixture::GetInstance().saMgr_;
+    MessageParcel data;
+    data.WriteInterfaceToken(SAMANAGER_INTERFACE_TOKEN);
+    data.WriteInt32(GetRegisteredSaId(state.thread_index()));
+    MessageOption option;
+    for (auto _ : state) {
+        data.RewindRead(0);
+        MessageParcel reply;
+        benchmark::DoNotOptimize(saMgr->OnRemoteRequest(
+            static_cast<uint32_t>(SamgrInterfaceCode::CHECK_SYSTEM_ABILITY_TRANSACTION), data, reply, option));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// range(0) SA profiles spread over REGISTERED_SA_NUM param events, one of them is reported
+void GetSaControlListByEvent(benchmark::State& state)
+{
+    std::weak_ptr<BaseSystemAbilityManager> weakMgr = RegistryFixture::GetInstance().saMgr_->weak_from_this();
+    sptr<DeviceStatusCollectManager> collectMgr(new DeviceStatusCollectManager(weakMgr));
+    collectMgr->collectPluginMap_[PARAM] = new DeviceParamCollect(collectMgr, weakMgr);
+    std::list<SaProfile> saProfiles;
+    for (int32_t saId = BENCH_SA_ID_BEGIN; saId < BENCH_SA_ID_BEGIN + state.range(0); ++saId) {
+        saProfiles.emplace_back(MakeProfile(saId));
+    }
+    collectMgr->FilterOnDemandSaProfiles(saProfiles);
+    OnDemandEvent event = { PARAM, BENCH_PARAM_PREFIX + "0", "true" };
+    int64_t matched = 0;
+    for (auto _ : state) {
+        std::list<SaControlInfo> saControlList;
+        collectMgr->GetSaControlListByEvent(event, saControlList);
+        matched += static_cast<int64_t>(saControlList.size());
+    }
+    state.counters["matched"] = benchmark::Counter(matched, benchmark::Counter::kAvgIterations);
+}
+} // namespace
+
+BENCHMARK(CheckSystemAbility)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(AddSystemAbility)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(SubscribeSystemAbility)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(LoadSystemAbility)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(OnRemoteRequest)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(GetSaControlListByEvent)->RangeMultiplier(4)->Range(16, 1024);
+
+BENCHMARK_MAIN();
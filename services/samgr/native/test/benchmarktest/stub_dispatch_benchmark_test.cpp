@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "samgr_ipc_interface_code.h"
+
+using namespace OHOS;
+
+namespace {
+const std::u16string SAMANAGER_INTERFACE_TOKEN = u"ohos.samgr.accessToken";
+constexpr uint32_t FUNC_TABLE_SIZE = 64;
+constexpr uint32_t MAX_CODE = static_cast<uint32_t>(SamgrInterfaceCode::GET_SYSTEM_ABILITIES_TRANSACTION);
+
+using StubFunc = int32_t (*)(int32_t);
+
+int32_t HandleTransaction(int32_t code)
+{
+    return code;
+}
+
+// the codes the samgr stub serves
+const std::vector<uint32_t>& GetRegisteredCodes()
+{
+    static const std::vector<uint32_t> codes = {
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 18, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29,
+        30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45,
+    };
+    return codes;
+}
+
+// the token as it sits in the parcel buffer
+struct ParcelToken {
+    const char16_t* data = nullptr;
+    int32_t length = 0;
+};
+
+ParcelToken GetParcelToken()
+{
+    static const std::u16string buffer = SAMANAGER_INTERFACE_TOKEN;
+    return { buffer.data(), static_cast<int32_t>(buffer.size()) };
+}
+
+// memberFuncMap_ lookup plus the u16string ReadInterfaceToken hands back
+void MapDispatch(benchmark::State& state)
+{
+    std::map<uint32_t, StubFunc> funcMap;
+    for (auto code : GetRegisteredCodes()) {
+        funcMap[code] = HandleTransaction;
+    }
+    uint32_t code = static_cast<uint32_t>(state.range(0));
+    ParcelToken parcelToken = GetParcelToken();
+    for (auto _ : state) {
+        std::u16string interfaceToken(parcelToken.data, parcelToken.length);
+        bool tokenOk = (interfaceToken == SAMANAGER_INTERFACE_TOKEN);
+        benchmark::DoNotOptimize(tokenOk);
+        auto iter = funcMap.find(code);
+        int32_t result = (iter != funcMap.end()) ? iter->second(static_cast<int32_t>(code)) : -1;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// dense table indexed by code plus the in-place token compare
+void DenseTableDispatch(benchmark::State& state)
+{
+    std::array<StubFunc, FUNC_TABLE_SIZE> funcTable {};
+    for (auto code : GetRegisteredCodes()) {
+        funcTable[code] = HandleTransaction;
+    }
+    uint32_t code = static_cast<uint32_t>(state.range(0));
+    ParcelToken parcelToken = GetParcelToken();
+    for (auto _ : state) {
+        bool tokenOk = (std::u16string_view(parcelToken.data, parcelToken.length) == SAMANAGER_INTERFACE_TOKEN);
+        benchmark::DoNotOptimize(tokenOk);
+        int32_t result = (code < funcTable.size() && funcTable[code] != nullptr) ?
+            funcTable[code](static_cast<int32_t>(code)) : -1;
+        benchmark::DoNotOptimize(result);
+    }
+}
+} // namespace
+
+BENCHMARK(MapDispatch)->DenseRange(1, MAX_CODE);
+BENCHMARK(DenseTableDispatch)->DenseRange(1, MAX_CODE);
+
+BENCHMARK_MAIN();
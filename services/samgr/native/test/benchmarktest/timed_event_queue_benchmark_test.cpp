@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "samgr_ffrt_api.h"
+#include "timed_event_queue.h"
+
+using namespace OHOS;
+
+namespace {
+constexpr int64_t MS_PER_SECOND = 1000;
+constexpr int64_t COALESCE_WINDOW_MS = 1000;
+// one simulated day of loop events
+constexpr int64_t HORIZON_MS = 24 * 3600 * MS_PER_SECOND;
+constexpr int32_t MIN_INTERVAL = 30;
+constexpr int32_t MAX_INTERVAL = 3600;
+
+// the collect keeps one entry per distinct interval, however many SAs configure it
+std::vector<int32_t> GenerateIntervals(int64_t count)
+{
+    std::set<int32_t> intervals;
+    for (int64_t i = 0; i < count; ++i) {
+        // spread over the valid range, most configurations use whole minutes
+        int32_t interval = MIN_INTERVAL + static_cast<int32_t>((i * 97) % (MAX_INTERVAL - MIN_INTERVAL));
+        intervals.insert((i % 2 == 0) ? interval - interval % 60 + 60 : interval);
+    }
+    return std::vector<int32_t>(intervals.begin(), intervals.end());
+}
+
+// samgr::mutex that counts its acquisitions
+class CountingMutex {
+public:
+    explicit CountingMutex(int64_t& lockCount) : lockCount_(lockCount) {}
+
+    void lock()
+    {
+        mutex_.lock();
+        lockCount_++;
+    }
+
+    void unlock()
+    {
+        mutex_.unlock();
+    }
+
+private:
+    samgr::mutex mutex_;
+    int64_t& lockCount_;
+};
+
+using LegacyTask = std::pair<int64_t, int32_t>;
+
+// one delayed task per interval that reposts itself under the loop set lock, as the collect used to do
+void PerIntervalDelayTasks(benchmark::State& state)
+{
+    std::vector<int32_t> intervals = GenerateIntervals(state.range(0));
+    int64_t wakeups = 0;
+    int64_t lockCount = 0;
+    CountingMutex loopEventSetLock(lockCount);
+    CountingMutex timeInfosLock(lockCount);
+    for (auto _ : state) {
+        std::priority_queue<LegacyTask, std::vector<LegacyTask>, std::greater<LegacyTask>> tasks;
+        for (auto interval : intervals) {
+            tasks.emplace(interval * MS_PER_SECOND, interval);
+        }
+        while (!tasks.empty() && tasks.top().first <= HORIZON_MS) {
+            auto [deadline, interval] = tasks.top();
+            tasks.pop();
+            wakeups++;
+            std::lock_guard<CountingMutex> autoLock(loopEventSetLock);
+            {
+                // ReportEventByTimeInfo
+                std::lock_guard<CountingMutex> infoLock(timeInfosLock);
+            }
+            {
+                // PostDelayTaskByTimeInfo
+                std::lock_guard<CountingMutex> infoLock(timeInfosLock);
+                tasks.emplace(deadline + interval * MS_PER_SECOND, interval);
+            }
+        }
+    }
+    state.counters["intervals"] = static_cast<double>(intervals.size());
+    state.counters["wakeups"] = benchmark::Counter(wakeups, benchmark::Counter::kAvgIterations);
+    state.counters["locks"] = benchmark::Counter(lockCount, benchmark::Counter::kAvgIterations);
+}
+
+// the shared deadline queue: one wakeup and one batched report for everything due in the window
+void CoalescedTimedEventQueue(benchmark::State& state)
+{
+    std::vector<int32_t> intervals = GenerateIntervals(state.range(0));
+    int64_t wakeups = 0;
+    int64_t lockCount = 0;
+    int64_t reports = 0;
+    CountingMutex timerLock(lockCount);
+    CountingMutex timeInfosLock(lockCount);
+    for (auto _ : state) {
+        TimedEventQueue queue(COALESCE_WINDOW_MS);
+        for (auto interval : intervals) {
+            queue.Schedule({ interval, false }, interval * MS_PER_SECOND);
+        }
+        std::vector<DueTimedEvent> dueEvents;
+        int64_t now = queue.NextDeadline();
+        while (now >= 0 && now <= HORIZON_MS) {
+            wakeups++;
+            std::lock_guard<CountingMutex> autoLock(timerLock);
+            dueEvents.clear();
+            queue.PopDue(now, dueEvents);
+            for (const auto& dueEvent : dueEvents) {
+                {
+                    // GetEventsByTimeInfo
+                    std::lock_guard<CountingMutex> infoLock(timeInfosLock);
+                }
+                {
+                    // awake lookup of the reschedule
+                    std::lock_guard<CountingMutex> infoLock(timeInfosLock);
+                    queue.Schedule(dueEvent.key, dueEvent.deadline + dueEvent.key.interval * MS_PER_SECOND);
+                }
+            }
+            reports++;
+            now = queue.NextDeadline();
+        }
+    }
+    state.counters["intervals"] = static_cast<double>(intervals.size());
+    state.counters["wakeups"] = benchmark::Counter(wakeups, benchmark::Counter::kAvgIterations);
+    state.counters["locks"] = benchmark::Counter(lockCount, benchmark::Counter::kAvgIterations);
+    state.counters["reports"] = benchmark::Counter(reports, benchmark::Counter::kAvgIterations);
+}
+} // namespace
+
+BENCHMARK(PerIntervalDelayTasks)->RangeMultiplier(2)->Range(128, 512);
+BENCHMARK(CoalescedTimedEventQueue)->RangeMultiplier(2)->Range(128, 512);
+
+BENCHMARK_MAIN();
@@ -14,11 +14,18 @@
  */
 
 #include "base_system_ability_mgr_test.h"
+
+#include <fstream>
+#include <future>
+#include <sys/stat.h>
+#include <thread>
+
 #include "ability_death_recipient.h"
 #include "if_system_ability_manager.h"
 #include "iservice_registry.h"
 #include "if_local_ability_manager.h"
 #include "itest_transaction_service.h"
+#include "sa_profile_cache.h"
 #include "sa_profiles.h"
 #include "sa_status_change_mock.h"
 #include "sam_mock_permission.h"
@@ -49,6 +56,15 @@ constexpr int32_t TEST_EXCEPTION_HIGH_SA_ID = LAST_SYS_ABILITY_ID + 1;
 const std::u16string PROCESS_NAME = u"test_process_name";
 constexpr int32_t MAX_SUBSCRIBE_COUNT = 256;
 constexpr int32_t MAX_WAIT_TIME = 8000;
+const std::string PROFILE_CACHE_DIR = "/data/test/sa_profile_cache";
+
+// SaProfileCache::Load only trusts a cache in a directory no one else can write
+std::string GetProfileCachePath(const std::string& name)
+{
+    mkdir(PROFILE_CACHE_DIR.c_str(), S_IRWXU);
+    chmod(PROFILE_CACHE_DIR.c_str(), S_IRWXU);
+    return PROFILE_CACHE_DIR + "/" + name;
+}
 
 class MockLocalAbilityManager : public IRemoteStub<ILocalAbilityManager> {
 public:
@@ -240,6 +256,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, RemoveDiedSystemAbility002, TestSize.Level1)
     saInfo.remoteObj = nullptr;
     saInfo.isDistributed = false;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     int32_t result = saMgr->RemoveDiedSystemAbility(SAID);
     EXPECT_EQ(result, ERR_OK);
     EXPECT_TRUE(saMgr->abilityMap_.find(SAID) == saMgr->abilityMap_.end());
@@ -259,6 +276,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, RemoveDiedSystemAbility003, TestSize.Level1)
     saInfo.remoteObj = testAbility;
     saInfo.isDistributed = false;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     int32_t result = saMgr->RemoveDiedSystemAbility(SAID);
     EXPECT_EQ(result, ERR_OK);
     EXPECT_TRUE(saMgr->abilityMap_.find(SAID) == saMgr->abilityMap_.end());
@@ -311,7 +329,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, UnSubscribeLockedNull001, TestSize.Level1)
     saMgr->listenerMap_[SAID].emplace_back(nullListener);
     size_t sizeBefore = saMgr->listenerMap_[SAID].size();
     sptr<ISystemAbilityStatusChange> testListener = new SaStatusChangeMock();
-    saMgr->UnSubscribeSystemAbilityLocked(saMgr->listenerMap_[SAID], testListener->AsObject());
+    saMgr->UnSubscribeSystemAbilityLocked(SAID, testListener->AsObject());
     EXPECT_EQ(saMgr->listenerMap_[SAID].size(), sizeBefore);
 }
 
@@ -328,7 +346,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, UnSubscribeLockedNotFound001, TestSize.Level1
     saMgr->listenerMap_[SAID].emplace_back(listener1, 1);
     size_t sizeBefore = saMgr->listenerMap_[SAID].size();
     sptr<ISystemAbilityStatusChange> listener2 = new SaStatusChangeMock();
-    saMgr->UnSubscribeSystemAbilityLocked(saMgr->listenerMap_[SAID], listener2->AsObject());
+    saMgr->UnSubscribeSystemAbilityLocked(SAID, listener2->AsObject());
     EXPECT_EQ(saMgr->listenerMap_[SAID].size(), sizeBefore);
 }
 
@@ -445,6 +463,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, AddSystemAbilityMax001, TestSize.Level1)
         saInfo.remoteObj = new TestTransactionService();
         saInfo.isDistributed = false;
         saMgr->abilityMap_[saId] = saInfo;
+        saMgr->RefreshAbilityTableLocked();
         CommonSaProfile saProfile;
         saProfile.process = u"test";
         saProfile.distributed = false;
@@ -655,6 +674,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, DoLoadOnDemandLoaded001, TestSize.Level1)
     saInfo.remoteObj = testAbility;
     saInfo.isDistributed = false;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     bool isExist = false;
     bool result = saMgr->DoLoadOnDemandAbility(SAID, isExist);
     EXPECT_EQ(result, true);
@@ -747,6 +767,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetExtensionRunningSaListEmpty001, TestSize.L
     InitSaMgr(saMgr);
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
 
     CommonSaProfile profile;
     profile.process = PROCESS_NAME;
@@ -760,6 +781,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetExtensionRunningSaListEmpty001, TestSize.L
 
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
 }
 
 /**
@@ -773,6 +795,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetExtensionRunningSaListMatch001, TestSize.L
     InitSaMgr(saMgr);
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
 
     CommonSaProfile profile;
     profile.process = PROCESS_NAME;
@@ -784,6 +807,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetExtensionRunningSaListMatch001, TestSize.L
     SAInfo saInfo;
     saInfo.remoteObj = ability;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
 
     std::vector<sptr<IRemoteObject>> saList;
     int32_t ret = saMgr->GetExtensionRunningSaList("test_ext", saList);
@@ -793,6 +817,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetExtensionRunningSaListMatch001, TestSize.L
 
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
 }
 
 /**
@@ -806,6 +831,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetRunningSaExtInfoNull001, TestSize.Level1)
     InitSaMgr(saMgr);
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->systemProcessMap_.clear();
 
     CommonSaProfile profile;
@@ -832,6 +858,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetRunningSaExtInfoMatch001, TestSize.Level1)
     InitSaMgr(saMgr);
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->systemProcessMap_.clear();
 
     CommonSaProfile profile;
@@ -848,6 +875,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetRunningSaExtInfoMatch001, TestSize.Level1)
     SAInfo saInfo;
     saInfo.remoteObj = ability;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
 
     std::vector<ISystemAbilityManager::SaExtensionInfo> infoList;
     int32_t ret = saMgr->GetRunningSaExtensionInfoList("test_ext", infoList);
@@ -857,6 +885,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetRunningSaExtInfoMatch001, TestSize.Level1)
 
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->systemProcessMap_.clear();
 }
 
@@ -898,17 +927,19 @@ HWTEST_F(BaseSystemAbilityMgrTest, GetOnDemandSystemAbilityIdsOk001, TestSize.Le
 
 /**
  * @tc.name: UpdateSaFreMapInvalid001
- * @tc.desc: uid < 0 returns -1
+ * @tc.desc: uid < 0 is not counted and its count is -1
  * @tc.type: FUNC
  */
 HWTEST_F(BaseSystemAbilityMgrTest, UpdateSaFreMapInvalid001, TestSize.Level1)
 {
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
+    saMgr->MergeSaFreMapLocked();
     saMgr->saFrequencyMap_.clear();
 
-    int32_t ret = saMgr->UpdateSaFreMap(-1, SAID);
-    EXPECT_EQ(ret, -1);
+    saMgr->UpdateSaFreMap(-1, SAID);
+    EXPECT_EQ(saMgr->saFrequencyCounter_.Size(), 0);
+    EXPECT_EQ(saMgr->GetSaFreCount(-1, SAID), -1);
 }
 
 /**
@@ -920,13 +951,73 @@ HWTEST_F(BaseSystemAbilityMgrTest, UpdateSaFreMapOk001, TestSize.Level1)
 {
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
+    saMgr->MergeSaFreMapLocked();
     saMgr->saFrequencyMap_.clear();
 
-    int32_t ret1 = saMgr->UpdateSaFreMap(100, SAID);
-    EXPECT_EQ(ret1, 1);
+    saMgr->UpdateSaFreMap(100, SAID);
+    EXPECT_EQ(saMgr->GetSaFreCount(100, SAID), 1);
+
+    saMgr->UpdateSaFreMap(100, SAID);
+    EXPECT_EQ(saMgr->GetSaFreCount(100, SAID), 2);
+}
 
-    int32_t ret2 = saMgr->UpdateSaFreMap(100, SAID);
-    EXPECT_EQ(ret2, 2);
+/**
+ * @tc.name: GetSaFreCount001
+ * @tc.desc: count of a key sums the calls made from different threads
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, GetSaFreCount001, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    saMgr->UpdateSaFreMap(100, SAID);
+    std::thread worker([saMgr]() {
+        saMgr->UpdateSaFreMap(100, SAID);
+        saMgr->UpdateSaFreMap(100, OTHER_SAID);
+    });
+    worker.join();
+    EXPECT_EQ(saMgr->GetSaFreCount(100, SAID), 2);
+    EXPECT_EQ(saMgr->GetSaFreCount(100, OTHER_SAID), 1);
+    saMgr->MergeSaFreMapLocked();
+    EXPECT_EQ(saMgr->GetSaFreCount(100, SAID), 0);
+}
+
+/**
+ * @tc.name: MergeSaFreMap001
+ * @tc.desc: counts from different threads are merged into saFrequencyMap_
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, MergeSaFreMap001, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    saMgr->UpdateSaFreMap(100, SAID);
+    std::thread worker([saMgr]() {
+        saMgr->UpdateSaFreMap(100, SAID);
+        saMgr->UpdateSaFreMap(100, OTHER_SAID);
+    });
+    worker.join();
+    saMgr->MergeSaFreMapLocked();
+    EXPECT_EQ(saMgr->saFrequencyCounter_.Size(), 0);
+    EXPECT_EQ(saMgr->saFrequencyMap_[SamgrUtil::GenerateFreKey(100, SAID)], 2);
+    EXPECT_EQ(saMgr->saFrequencyMap_[SamgrUtil::GenerateFreKey(100, OTHER_SAID)], 1);
+}
+
+/**
+ * @tc.name: MergeSaFreMap002
+ * @tc.desc: merged count saturates at the max frequency count
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, MergeSaFreMap002, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    constexpr int32_t maxCount = INT32_MAX - 1000000;
+    uint64_t key = SamgrUtil::GenerateFreKey(100, SAID);
+    saMgr->saFrequencyMap_[key] = maxCount;
+    saMgr->UpdateSaFreMap(100, SAID);
+    saMgr->MergeSaFreMapLocked();
+    EXPECT_EQ(saMgr->saFrequencyMap_[key], maxCount);
 }
 
 /**
@@ -1063,6 +1154,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, FindNotifyNoListeners001, TestSize.Level1)
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 
     int32_t ret = saMgr->FindSystemAbilityNotify(SAID, "", 0);
     EXPECT_EQ(ret, ERR_OK);
@@ -1078,6 +1170,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, FindNotifyAdd001, TestSize.Level1)
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 
     sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
     ASSERT_NE(listener, nullptr);
@@ -1094,6 +1187,8 @@ HWTEST_F(BaseSystemAbilityMgrTest, FindNotifyAdd001, TestSize.Level1)
     }
 
     saMgr->listenerMap_.clear();
+
+    saMgr->listenerIndex_.clear();
 }
 
 /**
@@ -1106,6 +1201,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, FindNotifyRemove001, TestSize.Level1)
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 
     sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
     ASSERT_NE(listener, nullptr);
@@ -1122,6 +1218,8 @@ HWTEST_F(BaseSystemAbilityMgrTest, FindNotifyRemove001, TestSize.Level1)
     }
 
     saMgr->listenerMap_.clear();
+
+    saMgr->listenerIndex_.clear();
 }
 
 /**
@@ -1157,20 +1255,25 @@ HWTEST_F(BaseSystemAbilityMgrTest, SystemAbilityInvalidateCache002, TestSize.Lev
 }
 
 /**
- * @tc.name: NotifySaAddedByAsyncNull001
- * @tc.desc: workHandler_==nullptr returns early
+ * @tc.name: NotifySaAddedByAsync001
+ * @tc.desc: the subscribe-time notification goes through the listener notifier queue
  * @tc.type: FUNC
  */
-HWTEST_F(BaseSystemAbilityMgrTest, NotifySaAddedByAsyncNull001, TestSize.Level1)
+HWTEST_F(BaseSystemAbilityMgrTest, NotifySaAddedByAsync001, TestSize.Level1)
 {
-    sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
     InitSaMgr(saMgr);
     saMgr->workHandler_ = nullptr;
 
     sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
     ASSERT_NE(listener, nullptr);
 
-    saMgr->NotifySystemAbilityAddedByAsync(SAID, listener);
+    saMgr->NotifySystemAbilityAddedByAsync(SAID, listener, IPCSkeleton::GetCallingPid());
+    std::vector<ListenerNotifyMetrics> metrics;
+    saMgr->listenerNotifier_->GetMetrics(metrics);
+    ASSERT_EQ(metrics.size(), 1);
+    EXPECT_EQ(metrics[0].callingPid, IPCSkeleton::GetCallingPid());
+    saMgr->listenerNotifier_->RemoveListener(listener->AsObject());
 }
 
 /**
@@ -1249,6 +1352,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, RefreshListenerState001, TestSize.Level1)
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 
     saMgr->RefreshListenerState(SAID);
     EXPECT_TRUE(saMgr->listenerMap_.find(SAID) == saMgr->listenerMap_.end());
@@ -1470,7 +1574,9 @@ HWTEST_F(BaseSystemAbilityMgrTest, CheckListenerNotifyNull001, TestSize.Level1)
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 
     sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
     ASSERT_NE(listener, nullptr);
@@ -1488,19 +1594,23 @@ HWTEST_F(BaseSystemAbilityMgrTest, CheckListenerNotifyInit001, TestSize.Level1)
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 
     sptr<IRemoteObject> ability = new (std::nothrow) TestTransactionService();
     ASSERT_NE(ability, nullptr);
     SAInfo saInfo;
     saInfo.remoteObj = ability;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
 
     sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
     ASSERT_NE(listener, nullptr);
 
     SAListener saListener(listener, IPCSkeleton::GetCallingPid(), ListenerState::INIT);
     saMgr->listenerMap_[SAID].push_back(saListener);
+    saMgr->listenerIndex_[listener->AsObject().GetRefPtr()][SAID] = std::prev(saMgr->listenerMap_[SAID].end());
     saMgr->subscribeCountMap_[IPCSkeleton::GetCallingPid()] = 1;
 
     saMgr->CheckListenerNotify(SAID, listener);
@@ -1510,7 +1620,9 @@ HWTEST_F(BaseSystemAbilityMgrTest, CheckListenerNotifyInit001, TestSize.Level1)
     }
 
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 }
 
 /**
@@ -1523,19 +1635,23 @@ HWTEST_F(BaseSystemAbilityMgrTest, CheckListenerNotifyNotified001, TestSize.Leve
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     InitSaMgr(saMgr);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 
     sptr<IRemoteObject> ability = new (std::nothrow) TestTransactionService();
     ASSERT_NE(ability, nullptr);
     SAInfo saInfo;
     saInfo.remoteObj = ability;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
 
     sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
     ASSERT_NE(listener, nullptr);
 
     SAListener saListener(listener, IPCSkeleton::GetCallingPid(), ListenerState::NOTIFIED);
     saMgr->listenerMap_[SAID].push_back(saListener);
+    saMgr->listenerIndex_[listener->AsObject().GetRefPtr()][SAID] = std::prev(saMgr->listenerMap_[SAID].end());
     saMgr->subscribeCountMap_[IPCSkeleton::GetCallingPid()] = 1;
 
     saMgr->CheckListenerNotify(SAID, listener);
@@ -1545,7 +1661,9 @@ HWTEST_F(BaseSystemAbilityMgrTest, CheckListenerNotifyNotified001, TestSize.Leve
     }
 
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
 }
 
 /**
@@ -1870,7 +1988,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, CleanCallbackCallbackMapCleanup001, TestSize.
     saMgr->callbackCountMap_[SAID] = 1;
     saMgr->startingAbilityMap_[SAID] = abilityItem;
     saMgr->CleanCallbackForLoadFailed(SAID, PROCESS_NAME, "local", cb);
-    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) == saMgr->startingAbilityMap_.end());
+    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) == nullptr);
 }
 
 /**
@@ -1897,7 +2015,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, CleanCallbackMultiCallback001, TestSize.Level
     saMgr->callbackCountMap_[SAID] = 2;
     saMgr->startingAbilityMap_[SAID] = abilityItem;
     saMgr->CleanCallbackForLoadFailed(SAID, PROCESS_NAME, "local", cb1);
-    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) != saMgr->startingAbilityMap_.end());
+    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) != nullptr);
     auto& item = saMgr->startingAbilityMap_[SAID];
     EXPECT_EQ(item.callbackMap["local"].size(), 1u);
 }
@@ -1926,7 +2044,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, CleanCallbackMultiDevice001, TestSize.Level1)
     saMgr->callbackCountMap_[SAID] = 2;
     saMgr->startingAbilityMap_[SAID] = abilityItem;
     saMgr->CleanCallbackForLoadFailed(SAID, PROCESS_NAME, "local", localCb);
-    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) != saMgr->startingAbilityMap_.end());
+    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) != nullptr);
     auto& item = saMgr->startingAbilityMap_[SAID];
     EXPECT_TRUE(item.callbackMap.find("local") == item.callbackMap.end());
     EXPECT_EQ(item.callbackMap["remote"].size(), 1u);
@@ -2296,7 +2414,7 @@ HWTEST_F(BaseSystemAbilityMgrTest, AddOnDemandPendingTaskLambdaExec001, TestSize
     caseDoneCondition_.wait_for(lock, std::chrono::milliseconds(MAX_WAIT_TIME),
         [&] () { return isCaseDone_; });
     isCaseDone_ = false;
-    EXPECT_TRUE(saMgr->onDemandAbilityMap_.find(SAID) != saMgr->onDemandAbilityMap_.end());
+    EXPECT_TRUE(saMgr->onDemandAbilityMap_.find(SAID) != nullptr);
     saMgr->workHandler_->CleanFfrt();
 }
 
@@ -2330,7 +2448,615 @@ HWTEST_F(BaseSystemAbilityMgrTest, CleanCallbackListenerNotifyLambdaExec001, Tes
     caseDoneCondition_.wait_for(lock, std::chrono::milliseconds(MAX_WAIT_TIME),
         [&] () { return isCaseDone_; });
     isCaseDone_ = false;
-    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) == saMgr->startingAbilityMap_.end());
+    EXPECT_TRUE(saMgr->startingAbilityMap_.find(SAID) == nullptr);
     saMgr->workHandler_->CleanFfrt();
 }
+
+/**
+ * @tc.name: AbilityTable001
+ * @tc.desc: add SA, the table serves it without the ability map lock
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, AbilityTable001, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    sptr<IRemoteObject> testAbility = new TestTransactionService();
+    CommonSaProfile saProfile;
+    saProfile.process = u"test";
+    saProfile.distributed = false;
+    saProfile.saId = SAID;
+    saMgr->saProfileMap_[SAID] = saProfile;
+    ISystemAbilityManager::SAExtraProp extraProp(false, ISystemAbilityManager::DUMP_FLAG_PRIORITY_DEFAULT, u"", u"");
+    int32_t result = saMgr->AddSystemAbility(SAID, testAbility, extraProp);
+    EXPECT_EQ(result, ERR_OK);
+    SAInfo saInfo;
+    ASSERT_TRUE(saMgr->FindAbility(SAID, saInfo));
+    EXPECT_EQ(saInfo.remoteObj, testAbility);
+    EXPECT_EQ(saMgr->CheckSystemAbility(SAID), testAbility);
+    saMgr->saProfileMap_.erase(SAID);
+}
+
+/**
+ * @tc.name: AbilityTable002
+ * @tc.desc: remove SA, only its slot is cleared and the unlinked record waits for the reader holding it
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, AbilityTable002, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    sptr<IRemoteObject> testAbility = new TestTransactionService();
+    SAInfo saInfo;
+    saInfo.remoteObj = testAbility;
+    saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->abilityMap_[OTHER_SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
+    {
+        SaReadEpoch::Guard guard;
+        int32_t result = saMgr->RemoveSystemAbility(SAID);
+        EXPECT_EQ(result, ERR_OK);
+        EXPECT_EQ(saMgr->abilityTable_.GetRetiredCountLocked(), 1u);
+    }
+    SAInfo found;
+    EXPECT_FALSE(saMgr->FindAbility(SAID, found));
+    EXPECT_TRUE(saMgr->FindAbility(OTHER_SAID, found));
+    EXPECT_EQ(saMgr->CheckSystemAbility(SAID), nullptr);
+    saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
+    EXPECT_EQ(saMgr->abilityTable_.GetRetiredCountLocked(), 0u);
+}
+
+/**
+ * @tc.name: AbilityTable003
+ * @tc.desc: check SA before anything is published and with ids outside the table
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, AbilityTable003, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    SAInfo saInfo;
+    EXPECT_FALSE(saMgr->FindAbility(SAID, saInfo));
+    EXPECT_FALSE(saMgr->FindAbility(-1, saInfo));
+    EXPECT_FALSE(saMgr->FindAbility(TEST_EXCEPTION_HIGH_SA_ID, saInfo));
+    EXPECT_EQ(saMgr->CheckSystemAbility(SAID), nullptr);
+}
+
+/**
+ * @tc.name: ListenerNotifier001
+ * @tc.desc: pending add followed by remove of the same SA cancels both events
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerNotifier001, TestSize.Level1)
+{
+    auto notifier = std::make_shared<SaListenerNotifier>();
+    SaListenerNotifier::ListenerQueue queue;
+    int32_t addCode = static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION);
+    int32_t removeCode = static_cast<int32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION);
+    notifier->EnqueueLocked(queue, SAID, "", addCode);
+    notifier->EnqueueLocked(queue, OTHER_SAID, "", addCode);
+    notifier->EnqueueLocked(queue, SAID, "", removeCode);
+    ASSERT_EQ(queue.events.size(), 1);
+    EXPECT_EQ(queue.events.front().systemAbilityId, OTHER_SAID);
+    EXPECT_EQ(queue.metrics.coalescedCount, 2);
+}
+
+/**
+ * @tc.name: ListenerNotifier002
+ * @tc.desc: repeated event of the same SA is coalesced, remove then add keeps both
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerNotifier002, TestSize.Level1)
+{
+    auto notifier = std::make_shared<SaListenerNotifier>();
+    SaListenerNotifier::ListenerQueue queue;
+    int32_t addCode = static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION);
+    int32_t removeCode = static_cast<int32_t>(SamgrInterfaceCode::REMOVE_SYSTEM_ABILITY_TRANSACTION);
+    notifier->EnqueueLocked(queue, SAID, "", removeCode);
+    notifier->EnqueueLocked(queue, SAID, "", removeCode);
+    notifier->EnqueueLocked(queue, SAID, "", addCode);
+    ASSERT_EQ(queue.events.size(), 2);
+    EXPECT_EQ(queue.events.front().code, removeCode);
+    EXPECT_EQ(queue.events.back().code, addCode);
+    EXPECT_EQ(queue.metrics.coalescedCount, 1);
+}
+
+/**
+ * @tc.name: ListenerNotifier003
+ * @tc.desc: drain delivers pending events and records listener metrics
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerNotifier003, TestSize.Level1)
+{
+    auto notifier = std::make_shared<SaListenerNotifier>();
+    sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
+    ASSERT_NE(listener, nullptr);
+    IRemoteObject* key = listener->AsObject().GetRefPtr();
+    auto& queue = notifier->queues_[key];
+    queue.listener = listener;
+    queue.draining = true;
+    queue.metrics.callingPid = IPCSkeleton::GetCallingPid();
+    int32_t addCode = static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION);
+    notifier->EnqueueLocked(queue, SAID, "", addCode);
+    notifier->EnqueueLocked(queue, OTHER_SAID, "", addCode);
+    EXPECT_EQ(notifier->GetPendingCount(), 2);
+    notifier->Drain(key, queue.generation);
+    EXPECT_EQ(notifier->GetPendingCount(), 0);
+    std::vector<ListenerNotifyMetrics> metrics;
+    notifier->GetMetrics(metrics);
+    ASSERT_EQ(metrics.size(), 1);
+    EXPECT_EQ(metrics[0].notifyCount, 2);
+    EXPECT_FALSE(notifier->queues_[key].draining);
+    std::string result;
+    notifier->Dump(result);
+    EXPECT_NE(result.find("notified:2"), std::string::npos);
+}
+
+/**
+ * @tc.name: ListenerNotifier004
+ * @tc.desc: removed listener drops its queue and a late drain is a no-op
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerNotifier004, TestSize.Level1)
+{
+    auto notifier = std::make_shared<SaListenerNotifier>();
+    sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
+    ASSERT_NE(listener, nullptr);
+    IRemoteObject* key = listener->AsObject().GetRefPtr();
+    auto& queue = notifier->queues_[key];
+    queue.listener = listener;
+    queue.draining = true;
+    notifier->EnqueueLocked(queue, SAID, "",
+        static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION));
+    notifier->RemoveListener(listener->AsObject());
+    EXPECT_EQ(notifier->GetPendingCount(), 0);
+    notifier->Drain(key, 0);
+    EXPECT_TRUE(notifier->queues_.empty());
+}
+
+/**
+ * @tc.name: ListenerNotifier005
+ * @tc.desc: FindSystemAbilityNotify hands events to the notifier after updating listener state
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerNotifier005, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    ASSERT_NE(saMgr->listenerNotifier_, nullptr);
+    sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
+    ASSERT_NE(listener, nullptr);
+    saMgr->listenerMap_[SAID].push_back(SAListener(listener, IPCSkeleton::GetCallingPid(), ListenerState::INIT));
+    IRemoteObject* key = listener->AsObject().GetRefPtr();
+    saMgr->listenerIndex_[key][SAID] = std::prev(saMgr->listenerMap_[SAID].end());
+    uint32_t addCode = static_cast<uint32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION);
+    EXPECT_EQ(saMgr->FindSystemAbilityNotify(SAID, "", addCode), ERR_OK);
+    EXPECT_EQ(saMgr->listenerMap_[SAID].front().state, ListenerState::NOTIFIED);
+    std::vector<ListenerNotifyMetrics> metrics;
+    saMgr->listenerNotifier_->GetMetrics(metrics);
+    EXPECT_EQ(metrics.size(), 1);
+    saMgr->UnSubscribeSystemAbility(SAID, listener);
+    EXPECT_EQ(saMgr->listenerIndex_.count(key), 0u);
+    EXPECT_TRUE(saMgr->listenerMap_[SAID].empty());
+    metrics.clear();
+    saMgr->listenerNotifier_->GetMetrics(metrics);
+    EXPECT_TRUE(metrics.empty());
+    saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
+}
+
+/**
+ * @tc.name: ListenerNotifier006
+ * @tc.desc: a late drain of a removed listener leaves the queue of a new listener at the same key alone
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerNotifier006, TestSize.Level1)
+{
+    auto notifier = std::make_shared<SaListenerNotifier>();
+    sptr<SaStatusChangeMock> listener = new (std::nothrow) SaStatusChangeMock();
+    ASSERT_NE(listener, nullptr);
+    IRemoteObject* key = listener->AsObject().GetRefPtr();
+    int32_t addCode = static_cast<int32_t>(SamgrInterfaceCode::ADD_SYSTEM_ABILITY_TRANSACTION);
+    auto& oldQueue = notifier->queues_[key];
+    oldQueue.listener = listener;
+    oldQueue.generation = notifier->nextGeneration_++;
+    uint64_t oldGeneration = oldQueue.generation;
+    notifier->RemoveListener(listener->AsObject());
+    // the address comes back for a new subscription while the old drain task is still queued
+    auto& newQueue = notifier->queues_[key];
+    newQueue.listener = listener;
+    newQueue.generation = notifier->nextGeneration_++;
+    newQueue.draining = true;
+    notifier->EnqueueLocked(newQueue, SAID, "", addCode);
+    notifier->Drain(key, oldGeneration);
+    EXPECT_EQ(notifier->GetPendingCount(), 1);
+    EXPECT_TRUE(notifier->queues_[key].draining);
+    notifier->Drain(key, notifier->queues_[key].generation);
+    EXPECT_EQ(notifier->GetPendingCount(), 0);
+    EXPECT_FALSE(notifier->queues_[key].draining);
+}
+
+/**
+ * @tc.name: ListenerIndex001
+ * @tc.desc: subscribe one listener to several SAs, index tracks every subscription and rejects duplicates
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerIndex001, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    sptr<ISystemAbilityStatusChange> listener = new SaStatusChangeMock();
+    EXPECT_EQ(saMgr->SubscribeSystemAbility(SAID, listener), ERR_OK);
+    EXPECT_EQ(saMgr->SubscribeSystemAbility(OTHER_SAID, listener), ERR_OK);
+    EXPECT_EQ(saMgr->SubscribeSystemAbility(SAID, listener), ERR_OK);
+    EXPECT_EQ(saMgr->listenerMap_[SAID].size(), 1);
+    auto indexIter = saMgr->listenerIndex_.find(listener->AsObject().GetRefPtr());
+    ASSERT_NE(indexIter, saMgr->listenerIndex_.end());
+    EXPECT_EQ(indexIter->second.size(), 2);
+    EXPECT_EQ(saMgr->subscribeCountMap_[IPCSkeleton::GetCallingPid()], 2);
+    EXPECT_EQ(saMgr->UnSubscribeSystemAbility(SAID, listener), ERR_OK);
+    EXPECT_TRUE(saMgr->listenerMap_[SAID].empty());
+    EXPECT_TRUE(saMgr->IsListenerSubscribedLocked(listener->AsObject()));
+    EXPECT_EQ(saMgr->UnSubscribeSystemAbility(OTHER_SAID, listener), ERR_OK);
+    EXPECT_FALSE(saMgr->IsListenerSubscribedLocked(listener->AsObject()));
+    EXPECT_TRUE(saMgr->listenerIndex_.empty());
+}
+
+/**
+ * @tc.name: ListenerIndex002
+ * @tc.desc: listener death removes only its own subscriptions
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, ListenerIndex002, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    sptr<ISystemAbilityStatusChange> deadListener = new SaStatusChangeMock();
+    sptr<ISystemAbilityStatusChange> aliveListener = new SaStatusChangeMock();
+    EXPECT_EQ(saMgr->SubscribeSystemAbility(SAID, deadListener), ERR_OK);
+    EXPECT_EQ(saMgr->SubscribeSystemAbility(OTHER_SAID, deadListener), ERR_OK);
+    EXPECT_EQ(saMgr->SubscribeSystemAbility(SAID, aliveListener), ERR_OK);
+    saMgr->UnSubscribeSystemAbility(deadListener->AsObject());
+    EXPECT_FALSE(saMgr->IsListenerSubscribedLocked(deadListener->AsObject()));
+    EXPECT_TRUE(saMgr->listenerMap_[OTHER_SAID].empty());
+    ASSERT_EQ(saMgr->listenerMap_[SAID].size(), 1);
+    EXPECT_EQ(saMgr->listenerMap_[SAID].front().listener->AsObject(), aliveListener->AsObject());
+    EXPECT_EQ(saMgr->subscribeCountMap_[IPCSkeleton::GetCallingPid()], 1);
+    EXPECT_EQ(saMgr->UnSubscribeSystemAbility(SAID, aliveListener), ERR_OK);
+    EXPECT_TRUE(saMgr->listenerIndex_.empty());
+}
+
+/**
+ * @tc.name: SaProfileCache001
+ * @tc.desc: saved profiles load back unchanged with a matching fingerprint
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SaProfileCache001, TestSize.Level1)
+{
+    std::string cachePath = GetProfileCachePath("sa_profile_cache_test001");
+    SaProfile saProfile;
+    saProfile.process = u"test_process";
+    saProfile.saId = SAID;
+    saProfile.libPath = "libtest.z.so";
+    saProfile.dependSa = { OTHER_SAID };
+    saProfile.extension.push_back("ext");
+    OnDemandEvent event = { COMMON_EVENT, "usual.event.SCREEN_ON", "" };
+    event.conditions.push_back({ PARAM, "persist.test", "true" });
+    event.extraMessages["key"] = "value";
+    saProfile.startOnDemand.onDemandEvents.push_back(event);
+    saProfile.stopOnDemand.delayTime = 1000;
+    std::list<SaProfile> saProfiles = { saProfile };
+    std::set<int32_t> multiInstanceSaIds = { SAID };
+    uint64_t fingerprint = 1;
+    ASSERT_TRUE(SaProfileCache::Save(cachePath, fingerprint, saProfiles, multiInstanceSaIds));
+
+    std::list<SaProfile> loadProfiles;
+    std::set<int32_t> loadSaIds;
+    ASSERT_TRUE(SaProfileCache::Load(cachePath, fingerprint, loadProfiles, loadSaIds));
+    ASSERT_EQ(loadProfiles.size(), 1);
+    auto& loaded = loadProfiles.front();
+    EXPECT_EQ(loaded.process, saProfile.process);
+    EXPECT_EQ(loaded.libPath, saProfile.libPath);
+    EXPECT_EQ(loaded.dependSa, saProfile.dependSa);
+    EXPECT_EQ(loaded.extension, saProfile.extension);
+    EXPECT_EQ(loaded.stopOnDemand.delayTime, 1000);
+    ASSERT_EQ(loaded.startOnDemand.onDemandEvents.size(), 1);
+    EXPECT_EQ(loaded.startOnDemand.onDemandEvents[0].conditions.size(), 1);
+    EXPECT_EQ(loaded.startOnDemand.onDemandEvents[0].extraMessages["key"], "value");
+    EXPECT_EQ(loadSaIds, multiInstanceSaIds);
+
+    loadProfiles.clear();
+    EXPECT_FALSE(SaProfileCache::Load(cachePath, fingerprint + 1, loadProfiles, loadSaIds));
+    EXPECT_TRUE(loadProfiles.empty());
+    remove(cachePath.c_str());
+}
+
+/**
+ * @tc.name: SaProfileCache002
+ * @tc.desc: missing or corrupted cache is rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SaProfileCache002, TestSize.Level1)
+{
+    std::string cachePath = GetProfileCachePath("sa_profile_cache_test002");
+    std::list<SaProfile> saProfiles;
+    std::set<int32_t> multiInstanceSaIds;
+    EXPECT_FALSE(SaProfileCache::Load(cachePath, 0, saProfiles, multiInstanceSaIds));
+    SaProfile saProfile;
+    saProfile.saId = SAID;
+    saProfiles.push_back(saProfile);
+    ASSERT_TRUE(SaProfileCache::Save(cachePath, 0, saProfiles, multiInstanceSaIds));
+    {
+        std::fstream file(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(0, std::ios::end);
+        file.seekp(static_cast<std::streamoff>(file.tellp()) - 1);
+        file.put('\x7f');
+    }
+    std::list<SaProfile> loadProfiles;
+    EXPECT_FALSE(SaProfileCache::Load(cachePath, 0, loadProfiles, multiInstanceSaIds));
+    remove(cachePath.c_str());
+}
+
+/**
+ * @tc.name: SaProfileCache003
+ * @tc.desc: fingerprint follows the profile file set
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SaProfileCache003, TestSize.Level1)
+{
+    std::string profilePath = "/data/test/sa_profile_cache_test003.json";
+    {
+        std::ofstream file(profilePath);
+        file << "{}";
+    }
+    std::vector<std::string> files = { profilePath };
+    uint64_t fingerprint = SaProfileCache::GetFingerprint(files);
+    EXPECT_EQ(fingerprint, SaProfileCache::GetFingerprint(files));
+    {
+        std::ofstream file(profilePath, std::ios::app);
+        file << " ";
+    }
+    EXPECT_NE(fingerprint, SaProfileCache::GetFingerprint(files));
+    EXPECT_NE(fingerprint, SaProfileCache::GetFingerprint({}));
+    remove(profilePath.c_str());
+}
+
+namespace {
+OnDemandEvent MakeCacheTestEvent(int32_t seed)
+{
+    OnDemandEvent event;
+    event.eventId = PARAM;
+    event.name = "persist.test.name" + std::to_string(seed);
+    event.value = "value" + std::to_string(seed);
+    event.extraDataId = seed;
+    event.persistence = true;
+    event.conditions.push_back({ COMMON_EVENT, "condition" + std::to_string(seed), "on", { { "ck", "cv" } } });
+    event.enableOnce = true;
+    event.loadPriority = HIGH_PRIORITY;
+    event.extraMessages["key" + std::to_string(seed)] = "value";
+    return event;
+}
+
+void ExpectSameEvents(const std::vector<OnDemandEvent>& loaded, const std::vector<OnDemandEvent>& saved)
+{
+    ASSERT_EQ(loaded.size(), saved.size());
+    for (size_t i = 0; i < saved.size(); i++) {
+        EXPECT_EQ(loaded[i].eventId, saved[i].eventId);
+        EXPECT_EQ(loaded[i].name, saved[i].name);
+        EXPECT_EQ(loaded[i].value, saved[i].value);
+        EXPECT_EQ(loaded[i].extraDataId, saved[i].extraDataId);
+        EXPECT_EQ(loaded[i].persistence, saved[i].persistence);
+        ASSERT_EQ(loaded[i].conditions.size(), saved[i].conditions.size());
+        for (size_t j = 0; j < saved[i].conditions.size(); j++) {
+            EXPECT_EQ(loaded[i].conditions[j].eventId, saved[i].conditions[j].eventId);
+            EXPECT_EQ(loaded[i].conditions[j].name, saved[i].conditions[j].name);
+            EXPECT_EQ(loaded[i].conditions[j].value, saved[i].conditions[j].value);
+            EXPECT_EQ(loaded[i].conditions[j].extraMessages, saved[i].conditions[j].extraMessages);
+        }
+        EXPECT_EQ(loaded[i].enableOnce, saved[i].enableOnce);
+        EXPECT_EQ(loaded[i].loadPriority, saved[i].loadPriority);
+        EXPECT_EQ(loaded[i].extraMessages, saved[i].extraMessages);
+    }
+}
+}
+
+/**
+ * @tc.name: SaProfileCache004
+ * @tc.desc: every cached field is set away from its default and loads back unchanged
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SaProfileCache004, TestSize.Level1)
+{
+    std::string cachePath = GetProfileCachePath("sa_profile_cache_test004");
+    SaProfile saProfile;
+    saProfile.process = u"test_process";
+    saProfile.saId = SAID;
+    saProfile.libPath = "libtest.z.so";
+    saProfile.dependSa = { OTHER_SAID, SAID + 1 };
+    saProfile.dependTimeout = 3000;
+    saProfile.runOnCreate = true;
+    saProfile.moduleUpdate = true;
+    saProfile.autoRestart = true;
+    saProfile.distributed = true;
+    saProfile.dumpLevel = 2;
+    saProfile.bootPhase = 1;
+    saProfile.startOnDemand.allowUpdate = true;
+    saProfile.startOnDemand.onDemandEvents = { MakeCacheTestEvent(1), MakeCacheTestEvent(2) };
+    saProfile.stopOnDemand.allowUpdate = true;
+    saProfile.stopOnDemand.unrefUnload = true;
+    saProfile.stopOnDemand.delayTime = 1000;
+    saProfile.stopOnDemand.unusedTimeout = 5000;
+    saProfile.stopOnDemand.onDemandEvents = { MakeCacheTestEvent(3) };
+    saProfile.recycleStrategy = LOW_MEMORY;
+    saProfile.extension = { "ext1", "ext2" };
+    saProfile.cacheCommonEvent = true;
+    std::list<SaProfile> saProfiles = { saProfile };
+    std::set<int32_t> multiInstanceSaIds = { SAID, OTHER_SAID };
+    ASSERT_TRUE(SaProfileCache::Save(cachePath, 0, saProfiles, multiInstanceSaIds));
+
+    std::list<SaProfile> loadProfiles;
+    std::set<int32_t> loadSaIds;
+    ASSERT_TRUE(SaProfileCache::Load(cachePath, 0, loadProfiles, loadSaIds));
+    remove(cachePath.c_str());
+    ASSERT_EQ(loadProfiles.size(), 1u);
+    const SaProfile& loaded = loadProfiles.front();
+    EXPECT_EQ(loaded.process, saProfile.process);
+    EXPECT_EQ(loaded.saId, saProfile.saId);
+    EXPECT_EQ(loaded.libPath, saProfile.libPath);
+    EXPECT_EQ(loaded.dependSa, saProfile.dependSa);
+    EXPECT_EQ(loaded.dependTimeout, saProfile.dependTimeout);
+    EXPECT_EQ(loaded.runOnCreate, saProfile.runOnCreate);
+    EXPECT_EQ(loaded.moduleUpdate, saProfile.moduleUpdate);
+    EXPECT_EQ(loaded.autoRestart, saProfile.autoRestart);
+    EXPECT_EQ(loaded.distributed, saProfile.distributed);
+    EXPECT_EQ(loaded.dumpLevel, saProfile.dumpLevel);
+    EXPECT_EQ(loaded.bootPhase, saProfile.bootPhase);
+    EXPECT_EQ(loaded.startOnDemand.allowUpdate, saProfile.startOnDemand.allowUpdate);
+    ExpectSameEvents(loaded.startOnDemand.onDemandEvents, saProfile.startOnDemand.onDemandEvents);
+    EXPECT_EQ(loaded.stopOnDemand.allowUpdate, saProfile.stopOnDemand.allowUpdate);
+    EXPECT_EQ(loaded.stopOnDemand.unrefUnload, saProfile.stopOnDemand.unrefUnload);
+    EXPECT_EQ(loaded.stopOnDemand.delayTime, saProfile.stopOnDemand.delayTime);
+    EXPECT_EQ(loaded.stopOnDemand.unusedTimeout, saProfile.stopOnDemand.unusedTimeout);
+    ExpectSameEvents(loaded.stopOnDemand.onDemandEvents, saProfile.stopOnDemand.onDemandEvents);
+    EXPECT_EQ(loaded.handle, nullptr);
+    EXPECT_EQ(loaded.recycleStrategy, saProfile.recycleStrategy);
+    EXPECT_EQ(loaded.extension, saProfile.extension);
+    EXPECT_EQ(loaded.cacheCommonEvent, saProfile.cacheCommonEvent);
+    EXPECT_EQ(loadSaIds, multiInstanceSaIds);
+}
+
+/**
+ * @tc.name: SaProfileCache005
+ * @tc.desc: a cache that others can write, or that sits in a directory others can write, is not trusted
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SaProfileCache005, TestSize.Level1)
+{
+    std::string cachePath = GetProfileCachePath("sa_profile_cache_test005");
+    std::list<SaProfile> saProfiles(1);
+    saProfiles.front().libPath = "libtest.z.so";
+    std::set<int32_t> multiInstanceSaIds;
+    ASSERT_TRUE(SaProfileCache::Save(cachePath, 0, saProfiles, multiInstanceSaIds));
+    std::list<SaProfile> loadProfiles;
+    EXPECT_TRUE(SaProfileCache::Load(cachePath, 0, loadProfiles, multiInstanceSaIds));
+
+    chmod(cachePath.c_str(), S_IRUSR | S_IWUSR | S_IWOTH);
+    loadProfiles.clear();
+    EXPECT_FALSE(SaProfileCache::Load(cachePath, 0, loadProfiles, multiInstanceSaIds));
+    EXPECT_TRUE(loadProfiles.empty());
+
+    chmod(cachePath.c_str(), S_IRUSR | S_IWUSR);
+    chmod(PROFILE_CACHE_DIR.c_str(), S_IRWXU | S_IRWXG);
+    EXPECT_FALSE(SaProfileCache::Load(cachePath, 0, loadProfiles, multiInstanceSaIds));
+    chmod(PROFILE_CACHE_DIR.c_str(), S_IRWXU);
+    EXPECT_TRUE(SaProfileCache::Load(cachePath, 0, loadProfiles, multiInstanceSaIds));
+    remove(cachePath.c_str());
+}
+
+/**
+ * @tc.name: SystemProcessExecutor001
+ * @tc.desc: requests of one process run in submit order and complete with their result
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SystemProcessExecutor001, TestSize.Level1)
+{
+    auto executor = std::make_shared<SystemProcessExecutor>();
+    std::u16string procName = u"test_proc";
+    executor->queues_[procName].running = true;
+    std::vector<int32_t> order;
+    std::vector<int32_t> results;
+    auto completion = [&results](int32_t result, int64_t) { results.emplace_back(result); };
+    executor->Submit(procName, [&order]() { order.emplace_back(1); return ERR_OK; }, completion);
+    executor->Submit(procName, [&order]() { order.emplace_back(2); return ERR_INVALID_VALUE; }, completion);
+    EXPECT_EQ(executor->GetPendingCount(), 2);
+    executor->Drain(procName);
+    ASSERT_EQ(order.size(), 2);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 2);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0], ERR_OK);
+    EXPECT_EQ(results[1], ERR_INVALID_VALUE);
+    EXPECT_EQ(executor->GetPendingCount(), 0);
+    EXPECT_TRUE(executor->queues_.empty());
+}
+
+/**
+ * @tc.name: SystemProcessExecutor002
+ * @tc.desc: null request is dropped
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SystemProcessExecutor002, TestSize.Level1)
+{
+    auto executor = std::make_shared<SystemProcessExecutor>();
+    executor->Submit(u"test_proc", nullptr, nullptr);
+    EXPECT_EQ(executor->GetPendingCount(), 0);
+    EXPECT_TRUE(executor->queues_.empty());
+}
+
+/**
+ * @tc.name: SystemProcessExecutor003
+ * @tc.desc: submitted requests run on the executor queues and complete
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, SystemProcessExecutor003, TestSize.Level1)
+{
+    auto executor = std::make_shared<SystemProcessExecutor>();
+    std::promise<int32_t> firstDone;
+    std::promise<int32_t> secondDone;
+    executor->Submit(u"test_proc_first", []() { return ERR_OK; },
+        [&firstDone](int32_t result, int64_t) { firstDone.set_value(result); });
+    executor->Submit(u"test_proc_second", []() { return ERR_INVALID_VALUE; },
+        [&secondDone](int32_t result, int64_t) { secondDone.set_value(result); });
+    auto firstResult = firstDone.get_future();
+    auto secondResult = secondDone.get_future();
+    ASSERT_EQ(firstResult.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    ASSERT_EQ(secondResult.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(firstResult.get(), ERR_OK);
+    EXPECT_EQ(secondResult.get(), ERR_INVALID_VALUE);
+}
+
+/**
+ * @tc.name: OnStartSystemProcessFailed001
+ * @tc.desc: failed start clears the starting record of the process
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, OnStartSystemProcessFailed001, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    std::u16string procName = u"test_proc";
+    saMgr->startingProcessMap_.clear();
+    saMgr->startingProcessMap_[procName].calleeSaId = SAID;
+    saMgr->OnStartSystemProcessFailed(procName, SAID, ERR_INVALID_VALUE);
+    EXPECT_EQ(saMgr->startingProcessMap_.count(procName), 0);
+}
+
+/**
+ * @tc.name: OnStartSystemProcessFailed002
+ * @tc.desc: failed start fails the pending load callbacks of the SA
+ * @tc.type: FUNC
+ */
+HWTEST_F(BaseSystemAbilityMgrTest, OnStartSystemProcessFailed002, TestSize.Level1)
+{
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    InitSaMgr(saMgr);
+    std::u16string procName = u"test_proc";
+    saMgr->startingAbilityMap_.clear();
+    saMgr->callbackCountMap_.clear();
+    sptr<SystemAbilityLoadCallbackMock> localCb = new (std::nothrow) SystemAbilityLoadCallbackMock();
+    ASSERT_NE(localCb, nullptr);
+    sptr<SystemAbilityLoadCallbackMock> remoteCb = new (std::nothrow) SystemAbilityLoadCallbackMock();
+    ASSERT_NE(remoteCb, nullptr);
+    BaseSystemAbilityManager::AbilityItem abilityItem;
+    abilityItem.callbackMap["local"].push_back({localCb, SAID});
+    abilityItem.callbackMap["remote"].push_back({remoteCb, SAID});
+    saMgr->callbackCountMap_[SAID] = 2;
+    saMgr->startingAbilityMap_[SAID] = abilityItem;
+    saMgr->OnStartSystemProcessFailed(procName, SAID, ERR_INVALID_VALUE);
+    EXPECT_EQ(localCb->GetSystemAbilityId(), SAID);
+    EXPECT_EQ(remoteCb->GetSystemAbilityId(), SAID);
+    EXPECT_TRUE(saMgr->startingAbilityMap_.empty());
+    EXPECT_EQ(saMgr->callbackCountMap_.count(SAID), 0);
+}
 } // namespace OHOS
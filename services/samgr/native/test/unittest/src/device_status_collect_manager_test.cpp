@@ -1122,4 +1122,211 @@ HWTEST_F(DeviceStatusCollectManagerTest, GetSaControlListByPersistEventd001, Tes
     DTEST_LOG << " GetSaControlListByPersistEventd001 BEGIN" << std::endl;
 }
 #endif
+
+/**
+ * @tc.name: GetSaControlListByEvent002
+ * @tc.desc: test GetSaControlListByEvent resolves through the event index and keeps profile order
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusCollectManagerTest, GetSaControlListByEvent002, TestSize.Level3)
+{
+    DTEST_LOG << " GetSaControlListByEvent002 BEGIN" << std::endl;
+    collect->collectPluginMap_[DEVICE_ONLINE] = new MockCollectPlugin(collect);
+    int32_t saId1 = 1494;
+    int32_t saId2 = 1495;
+    SaProfile saProfile1;
+    saProfile1.saId = saId1;
+    saProfile1.startOnDemand.onDemandEvents.push_back({ DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" });
+    SaProfile saProfile2;
+    saProfile2.saId = saId2;
+    saProfile2.startOnDemand.onDemandEvents.push_back({ DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "" });
+    saProfile2.stopOnDemand.onDemandEvents.push_back({ DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" });
+    std::list<SaProfile> saProfiles = { saProfile1, saProfile2 };
+    collect->FilterOnDemandSaProfiles(saProfiles);
+    EXPECT_EQ(collect->eventIndex_.size(), 2);
+
+    std::list<SaControlInfo> saControlList;
+    OnDemandEvent event = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" };
+    collect->GetSaControlListByEvent(event, saControlList);
+    ASSERT_EQ(saControlList.size(), 3);
+    auto iter = saControlList.begin();
+    EXPECT_EQ(iter->saId, saId1);
+    EXPECT_EQ(iter->ondemandId, START_ON_DEMAND);
+    ++iter;
+    EXPECT_EQ(iter->saId, saId2);
+    EXPECT_EQ(iter->ondemandId, START_ON_DEMAND);
+    ++iter;
+    EXPECT_EQ(iter->saId, saId2);
+    EXPECT_EQ(iter->ondemandId, STOP_ON_DEMAND);
+
+    saControlList.clear();
+    event.value = "off";
+    collect->GetSaControlListByEvent(event, saControlList);
+    ASSERT_EQ(saControlList.size(), 1);
+    EXPECT_EQ(saControlList.front().saId, saId2);
+    DTEST_LOG << " GetSaControlListByEvent002 END" << std::endl;
+}
+
+/**
+ * @tc.name: UpdateOnDemandEvents004
+ * @tc.desc: test UpdateOnDemandEvents replaces the indexed events of the SA
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusCollectManagerTest, UpdateOnDemandEvents004, TestSize.Level3)
+{
+    DTEST_LOG << "UpdateOnDemandEvents004 begin" << std::endl;
+    collect->collectPluginMap_[DEVICE_ONLINE] = new MockCollectPlugin(collect);
+    int32_t systemAbilityId = 1494;
+    SaProfile saProfile;
+    saProfile.saId = systemAbilityId;
+    saProfile.startOnDemand.onDemandEvents.push_back({ DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" });
+    std::list<SaProfile> saProfiles = { saProfile };
+    collect->FilterOnDemandSaProfiles(saProfiles);
+    std::vector<OnDemandEvent> events = { { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "off" } };
+    int32_t ret = collect->UpdateOnDemandEvents(systemAbilityId, OnDemandPolicyType::START_POLICY, events);
+    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(collect->eventIndex_.size(), 1);
+
+    std::list<SaControlInfo> saControlList;
+    OnDemandEvent event = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" };
+    collect->GetSaControlListByEvent(event, saControlList);
+    EXPECT_TRUE(saControlList.empty());
+    event.value = "off";
+    collect->GetSaControlListByEvent(event, saControlList);
+    ASSERT_EQ(saControlList.size(), 1);
+    EXPECT_EQ(saControlList.front().saId, systemAbilityId);
+    DTEST_LOG << "UpdateOnDemandEvents004 end" << std::endl;
+}
+
+/**
+ * @tc.name: MergeOnDemandActions001
+ * @tc.desc: test MergeOnDemandActions, repeated actions are dropped and the last of a start/stop pair is kept
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusCollectManagerTest, MergeOnDemandActions001, TestSize.Level3)
+{
+    DTEST_LOG << " MergeOnDemandActions001 BEGIN" << std::endl;
+    collect->collectPluginMap_[DEVICE_ONLINE] = new MockCollectPlugin(collect);
+    OnDemandEvent onEvent = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" };
+    OnDemandEvent offEvent = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "off" };
+    SaProfile saProfile1;
+    saProfile1.saId = 1;
+    OnDemandEvent startEvent1 = onEvent;
+    startEvent1.loadPriority = 2;
+    saProfile1.startOnDemand.onDemandEvents.emplace_back(startEvent1);
+    saProfile1.stopOnDemand.onDemandEvents.emplace_back(offEvent);
+    SaProfile saProfile2;
+    saProfile2.saId = 2;
+    OnDemandEvent startEvent2 = onEvent;
+    startEvent2.loadPriority = 1;
+    saProfile2.startOnDemand.onDemandEvents.emplace_back(startEvent2);
+    std::list<SaProfile> saProfiles = { saProfile1, saProfile2 };
+    collect->FilterOnDemandSaProfiles(saProfiles);
+
+    std::vector<OnDemandEvent> events = { onEvent, onEvent };
+    std::list<DeviceStatusCollectManager::OnDemandAction> actions;
+    collect->MergeOnDemandActions(events, actions);
+    ASSERT_EQ(actions.size(), 2u);
+    EXPECT_EQ(actions.front().saControl.saId, 2);
+    EXPECT_EQ(actions.back().saControl.saId, 1);
+    EXPECT_EQ(actions.front().eventIndex, 0u);
+
+    events.emplace_back(offEvent);
+    actions.clear();
+    collect->MergeOnDemandActions(events, actions);
+    ASSERT_EQ(actions.size(), 2u);
+    EXPECT_EQ(actions.front().saControl.saId, 2);
+    EXPECT_EQ(actions.front().saControl.ondemandId, START_ON_DEMAND);
+    EXPECT_EQ(actions.back().saControl.saId, 1);
+    EXPECT_EQ(actions.back().saControl.ondemandId, STOP_ON_DEMAND);
+    EXPECT_EQ(actions.back().eventIndex, 2u);
+    DTEST_LOG << " MergeOnDemandActions001 END" << std::endl;
+}
+
+/**
+ * @tc.name: MergeOnDemandActions002
+ * @tc.desc: test MergeOnDemandActions, stop then start keeps the start and start then stop keeps the stop
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusCollectManagerTest, MergeOnDemandActions002, TestSize.Level3)
+{
+    DTEST_LOG << " MergeOnDemandActions002 BEGIN" << std::endl;
+    collect->collectPluginMap_[DEVICE_ONLINE] = new MockCollectPlugin(collect);
+    OnDemandEvent onEvent = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" };
+    OnDemandEvent offEvent = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "off" };
+    SaProfile saProfile;
+    saProfile.saId = 1;
+    saProfile.startOnDemand.onDemandEvents.emplace_back(onEvent);
+    saProfile.stopOnDemand.onDemandEvents.emplace_back(offEvent);
+    std::list<SaProfile> saProfiles = { saProfile };
+    collect->FilterOnDemandSaProfiles(saProfiles);
+
+    std::vector<OnDemandEvent> events = { offEvent, onEvent };
+    std::list<DeviceStatusCollectManager::OnDemandAction> actions;
+    collect->MergeOnDemandActions(events, actions);
+    ASSERT_EQ(actions.size(), 1u);
+    EXPECT_EQ(actions.front().saControl.ondemandId, START_ON_DEMAND);
+    EXPECT_EQ(actions.front().eventIndex, 1u);
+
+    events = { onEvent, offEvent };
+    actions.clear();
+    collect->MergeOnDemandActions(events, actions);
+    ASSERT_EQ(actions.size(), 1u);
+    EXPECT_EQ(actions.front().saControl.ondemandId, STOP_ON_DEMAND);
+    EXPECT_EQ(actions.front().eventIndex, 1u);
+    DTEST_LOG << " MergeOnDemandActions002 END" << std::endl;
+}
+
+/**
+ * @tc.name: ReportEvents001
+ * @tc.desc: test ReportEvents, events reported before the drain runs share one drain task
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusCollectManagerTest, ReportEvents001, TestSize.Level3)
+{
+    DTEST_LOG << " ReportEvents001 BEGIN" << std::endl;
+    sptr<DeviceStatusCollectManager> collectMgr =
+        new DeviceStatusCollectManager(std::weak_ptr<BaseSystemAbilityManager>{});
+    collectMgr->collectHandler_ = std::make_shared<FFRTHandler>("collect");
+    OnDemandEvent event = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" };
+    {
+        std::lock_guard<samgr::mutex> autoLock(collectMgr->pendingEventsLock_);
+        collectMgr->eventDrainPosted_ = true;
+    }
+    collectMgr->ReportEvents({ event, event });
+    collectMgr->ReportEvent(event);
+    EXPECT_EQ(collectMgr->pendingEvents_.size(), 3u);
+    collectMgr->DrainReportedEvents();
+    EXPECT_TRUE(collectMgr->pendingEvents_.empty());
+    EXPECT_FALSE(collectMgr->eventDrainPosted_);
+    DTEST_LOG << " ReportEvents001 END" << std::endl;
+}
+
+/**
+ * @tc.name: ReportEvents002
+ * @tc.desc: test ReportEvents, a drain that could not be posted does not block later reports
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusCollectManagerTest, ReportEvents002, TestSize.Level3)
+{
+    DTEST_LOG << " ReportEvents002 BEGIN" << std::endl;
+    sptr<DeviceStatusCollectManager> collectMgr =
+        new DeviceStatusCollectManager(std::weak_ptr<BaseSystemAbilityManager>{});
+    collectMgr->collectHandler_ = std::make_shared<FFRTHandler>("collect");
+    collectMgr->collectHandler_->CleanFfrt();
+    OnDemandEvent event = { DEVICE_ONLINE, SA_TAG_DEVICE_ON_LINE, "on" };
+    collectMgr->ReportEvent(event);
+    EXPECT_FALSE(collectMgr->eventDrainPosted_);
+    EXPECT_EQ(collectMgr->pendingEvents_.size(), 1u);
+    collectMgr->collectHandler_ = std::make_shared<FFRTHandler>("collect");
+    {
+        std::lock_guard<samgr::mutex> autoLock(collectMgr->pendingEventsLock_);
+        collectMgr->eventDrainPosted_ = true;
+    }
+    collectMgr->ReportEvent(event);
+    collectMgr->DrainReportedEvents();
+    EXPECT_TRUE(collectMgr->pendingEvents_.empty());
+    EXPECT_FALSE(collectMgr->eventDrainPosted_);
+    DTEST_LOG << " ReportEvents002 END" << std::endl;
+}
 } // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "device_timed_collect_test.h"
 
+#include <atomic>
+
 #include "sa_profiles.h"
 #include "test_log.h"
 
@@ -314,14 +316,14 @@ HWTEST_F(DeviceTimedCollectTest, ReportEventByTimeInfo001, TestSize.Level3)
 }
 
 /**
- * @tc.name: PostDelayTaskByTimeInfo001
- * @tc.desc: test PostDelayTaskByTimeInfo, collect is nullptr
+ * @tc.name: ScheduleTimedEvent001
+ * @tc.desc: test ScheduleTimedEvent, awake loop goes to the awake queue, unknown interval is not scheduled
  * @tc.type: FUNC
  * @tc.require: I6OU0A
  */
-HWTEST_F(DeviceTimedCollectTest, PostDelayTaskByTimeInfo001, TestSize.Level3)
+HWTEST_F(DeviceTimedCollectTest, ScheduleTimedEvent001, TestSize.Level3)
 {
-    DTEST_LOG << "PostDelayTaskByTimeInfo001 begin" << std::endl;
+    DTEST_LOG << "ScheduleTimedEvent001 begin" << std::endl;
     sptr<DeviceStatusCollectManager> collect = nullptr;
     sptr<DeviceTimedCollect> deviceTimedCollect = new DeviceTimedCollect(collect);
     EXPECT_EQ(true, deviceTimedCollect != nullptr);
@@ -329,10 +331,72 @@ HWTEST_F(DeviceTimedCollectTest, PostDelayTaskByTimeInfo001, TestSize.Level3)
     info.awake = true;
     info.normal = true;
     deviceTimedCollect->timeInfos_[3600] = info;
-    deviceTimedCollect->PostDelayTaskByTimeInfo(deviceTimedCollect->nonPersitenceLoopTasks_[0], 3600, 3600);
-    EXPECT_EQ(collect, nullptr);
+    EXPECT_TRUE(deviceTimedCollect->ScheduleTimedEvent({ 3600, false }, 3600));
+    EXPECT_TRUE(deviceTimedCollect->awakeQueue_.Contains({ 3600, false }));
+    EXPECT_EQ(deviceTimedCollect->normalQueue_.Size(), 0u);
+    EXPECT_FALSE(deviceTimedCollect->ScheduleTimedEvent({ 7200, false }, 7200));
+    deviceTimedCollect->CancelTimedEvent({ 3600, false });
+    EXPECT_FALSE(deviceTimedCollect->IsTimedEventScheduled({ 3600, false }));
     deviceTimedCollect->timeInfos_.clear();
-    DTEST_LOG << "PostDelayTaskByTimeInfo001 end" << std::endl;
+    DTEST_LOG << "ScheduleTimedEvent001 end" << std::endl;
+}
+
+/**
+ * @tc.name: OnTimerExpired001
+ * @tc.desc: test OnTimerExpired, due loop is rescheduled after its deadline and order timed event is dropped
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceTimedCollectTest, OnTimerExpired001, TestSize.Level3)
+{
+    DTEST_LOG << "OnTimerExpired001 begin" << std::endl;
+    sptr<DeviceStatusCollectManager> collect = nullptr;
+    sptr<DeviceTimedCollect> deviceTimedCollect = new DeviceTimedCollect(collect);
+    TimeInfo info;
+    info.normal = true;
+    deviceTimedCollect->timeInfos_[60] = info;
+    int64_t now = DeviceTimedCollect::GetBootTimeMs();
+    {
+        std::lock_guard<samgr::mutex> autoLock(deviceTimedCollect->timerLock_);
+        deviceTimedCollect->ScheduleTimedEventLocked({ 60, false }, now - 10);
+        deviceTimedCollect->ScheduleTimedEventLocked({ 0, false, "2017-9-1-16:59:10" }, now);
+    }
+    deviceTimedCollect->OnTimerExpired(false, now - 10);
+    EXPECT_TRUE(deviceTimedCollect->IsTimedEventScheduled({ 60, false }));
+    EXPECT_FALSE(deviceTimedCollect->IsTimedEventScheduled({ 0, false, "2017-9-1-16:59:10" }));
+    EXPECT_GE(deviceTimedCollect->normalQueue_.NextDeadline(), now - 10 + 60 * 1000);
+    deviceTimedCollect->CancelTimedEvent({ 60, false });
+    deviceTimedCollect->timeInfos_.clear();
+    DTEST_LOG << "OnTimerExpired001 end" << std::endl;
+}
+
+/**
+ * @tc.name: TimedEventQueue001
+ * @tc.desc: test TimedEventQueue, events within the coalescing window are popped together
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceTimedCollectTest, TimedEventQueue001, TestSize.Level3)
+{
+    TimedEventQueue queue(1000);
+    EXPECT_EQ(queue.NextDeadline(), -1);
+    EXPECT_TRUE(queue.Schedule({ 60, false }, 5000));
+    EXPECT_FALSE(queue.Schedule({ 90, false }, 5800));
+    EXPECT_FALSE(queue.Schedule({ 120, false }, 9000));
+    EXPECT_TRUE(queue.Schedule({ 0, true, "2017-9-1-16:59:10" }, 4500));
+    std::vector<DueTimedEvent> due;
+    queue.PopDue(3400, due);
+    EXPECT_TRUE(due.empty());
+    queue.PopDue(3600, due);
+    EXPECT_EQ(due.size(), 1u);
+    queue.PopDue(4900, due);
+    EXPECT_EQ(due.size(), 3u);
+    EXPECT_EQ(due[1].key.interval, 60);
+    EXPECT_EQ(due[2].key.interval, 90);
+    EXPECT_EQ(queue.NextDeadline(), 9000);
+    EXPECT_TRUE(queue.Schedule({ 120, false }, 7000));
+    EXPECT_EQ(queue.Size(), 1u);
+    EXPECT_TRUE(queue.Cancel({ 120, false }));
+    EXPECT_FALSE(queue.Cancel({ 120, false }));
+    EXPECT_EQ(queue.NextDeadline(), -1);
 }
 
 /**
@@ -365,7 +429,8 @@ HWTEST_F(DeviceTimedCollectTest, PostDelayTask001, TestSize.Level3)
     sptr<DeviceStatusCollectManager> collect = nullptr;
     sptr<DeviceTimedCollect> deviceTimedCollect = new DeviceTimedCollect(collect);
     EXPECT_EQ(true, deviceTimedCollect != nullptr);
-    deviceTimedCollect->PostDelayTask(deviceTimedCollect->nonPersitenceLoopTasks_[0], 0);
+    std::function<void()> task;
+    deviceTimedCollect->PostDelayTask(task, 0);
     EXPECT_EQ(collect, nullptr);
     DTEST_LOG << "PostDelayTask001 end" << std::endl;
 }
@@ -384,8 +449,8 @@ HWTEST_F(DeviceTimedCollectTest, PostDelayTask002, TestSize.Level3)
     collect->collectHandler_ = std::make_shared<FFRTHandler>("collect");
     sptr<DeviceTimedCollect> deviceTimedCollect = new DeviceTimedCollect(collect);
     EXPECT_EQ(true, deviceTimedCollect != nullptr);
-    deviceTimedCollect->nonPersitenceLoopTasks_[0] = [] () {};
-    deviceTimedCollect->PostDelayTask(deviceTimedCollect->nonPersitenceLoopTasks_[0], 0);
+    std::function<void()> task = [] () {};
+    deviceTimedCollect->PostDelayTask(task, 0);
     EXPECT_NE(collect, nullptr);
     DTEST_LOG << "PostDelayTask002 end" << std::endl;
 }
@@ -768,9 +833,8 @@ HWTEST_F(DeviceTimedCollectTest, PostPersistenceDelayTask001, TestSize.Level3)
     deviceTimedCollect->preferencesUtil_ = PreferencesUtil::GetInstance();
     int32_t interval = 1;
     int32_t disTime = 1;
-    
-    std::function<void()> postTask = [] () {};
-    deviceTimedCollect->PostPersistenceDelayTask(postTask, interval, disTime);
+
+    deviceTimedCollect->PostPersistenceDelayTask(interval, disTime);
     EXPECT_NE(disTime, 0);
     DTEST_LOG << "PostPersistenceDelayTask001 end" << std::endl;
 }
@@ -848,9 +912,9 @@ HWTEST_F(DeviceTimedCollectTest, PostPersistenceLoopTaskLocked001, TestSize.Leve
     info.normal = true;
     deviceTimedCollect->timeInfos_[1] = info;
     deviceTimedCollect->PostPersistenceLoopTaskLocked(1);
-    deviceTimedCollect->persitenceLoopTasks_.erase(1);
+    deviceTimedCollect->CancelTimedEvent({ 1, true });
     usleep(1500 * 1000);
-    EXPECT_TRUE(deviceTimedCollect->persitenceLoopTasks_.empty());
+    EXPECT_FALSE(deviceTimedCollect->IsTimedEventScheduled({ 1, true }));
     DTEST_LOG << " PostPersistenceLoopTaskLocked001 end" << std::endl;
 }
 
@@ -868,9 +932,10 @@ HWTEST_F(DeviceTimedCollectTest, PostPersistenceLoopTaskLocked002, TestSize.Leve
     info.normal = true;
     deviceTimedCollect->timeInfos_[1] = info;
     deviceTimedCollect->PostPersistenceLoopTaskLocked(1);
-    EXPECT_FALSE(deviceTimedCollect->persitenceLoopTasks_.empty());
+    EXPECT_TRUE(deviceTimedCollect->IsTimedEventScheduled({ 1, true }));
     usleep(1100 * 1000);
-    deviceTimedCollect->persitenceLoopTasks_.erase(1);
+    EXPECT_TRUE(deviceTimedCollect->IsTimedEventScheduled({ 1, true }));
+    deviceTimedCollect->CancelTimedEvent({ 1, true });
     DTEST_LOG << " PostPersistenceLoopTaskLocked002 end" << std::endl;
 }
 #endif
@@ -884,17 +949,21 @@ HWTEST_F(DeviceTimedCollectTest, PostNonPersistenceLoopTaskLocked001, TestSize.L
     sptr<DeviceTimedCollect> deviceTimedCollect = new DeviceTimedCollect(collect);
     EXPECT_EQ(true, deviceTimedCollect != nullptr);
     int32_t interVal = 65;
-    deviceTimedCollect->nonPersitenceLoopTasks_[interVal] = [interVal] () {};
     deviceTimedCollect->PostNonPersistenceLoopTaskLocked(interVal);
-    EXPECT_FALSE(deviceTimedCollect->nonPersitenceLoopTasks_.empty());
-    
-    deviceTimedCollect->nonPersitenceLoopTasks_.clear();
+    EXPECT_FALSE(deviceTimedCollect->IsTimedEventScheduled({ interVal, false }));
+
+    TimeInfo info;
+    info.normal = true;
+    deviceTimedCollect->timeInfos_[interVal] = info;
     deviceTimedCollect->nonPersitenceLoopEventSet_.insert(interVal);
     deviceTimedCollect->PostNonPersistenceLoopTaskLocked(interVal);
-    EXPECT_FALSE(deviceTimedCollect->nonPersitenceLoopTasks_.empty());
+    deviceTimedCollect->PostNonPersistenceLoopTaskLocked(interVal);
+    EXPECT_TRUE(deviceTimedCollect->IsTimedEventScheduled({ interVal, false }));
+    EXPECT_EQ(deviceTimedCollect->normalQueue_.Size(), 1u);
 
     deviceTimedCollect->RemoveNonPersistenceLoopTask(interVal);
-    EXPECT_TRUE(deviceTimedCollect->nonPersitenceLoopTasks_.empty());
+    EXPECT_FALSE(deviceTimedCollect->IsTimedEventScheduled({ interVal, false }));
+    deviceTimedCollect->timeInfos_.clear();
     DTEST_LOG << " PostNonPersistenceLoopTaskLocked001 end" << std::endl;
 }
 
@@ -909,10 +978,9 @@ HWTEST_F(DeviceTimedCollectTest, PostPersistenceDelayTaskd001, TestSize.Level3)
     EXPECT_EQ(true, deviceTimedCollect != nullptr);
     deviceTimedCollect->preferencesUtil_ = PreferencesUtil::GetInstance();
 
-    std::function<void()> postTask = [] () {};
     int32_t interVal = 1;
     int32_t disTime = 1;
-    deviceTimedCollect->PostPersistenceDelayTask(postTask, interVal, disTime);
+    deviceTimedCollect->PostPersistenceDelayTask(interVal, disTime);
     EXPECT_NE(nullptr, deviceTimedCollect->preferencesUtil_);
     DTEST_LOG << " PostPersistenceDelayTaskd001 end" << std::endl;
 }
@@ -945,10 +1013,15 @@ HWTEST_F(DeviceTimedCollectTest, RemovePersistenceLoopTask001, TestSize.Level3)
     EXPECT_EQ(true, deviceTimedCollect != nullptr);
     
     int32_t interVal = 64;
+    TimeInfo info;
+    info.normal = true;
+    deviceTimedCollect->timeInfos_[interVal] = info;
     deviceTimedCollect->persitenceLoopEventSet_.insert(interVal);
-    deviceTimedCollect->persitenceLoopTasks_[interVal] = [interVal] () {};
+    deviceTimedCollect->ScheduleTimedEvent({ interVal, true }, interVal);
     deviceTimedCollect->RemovePersistenceLoopTask(interVal);
     EXPECT_TRUE(deviceTimedCollect->persitenceLoopEventSet_.empty());
+    EXPECT_FALSE(deviceTimedCollect->IsTimedEventScheduled({ interVal, true }));
+    deviceTimedCollect->timeInfos_.clear();
     DTEST_LOG << " RemovePersistenceLoopTask001 end" << std::endl;
 }
 
@@ -1028,6 +1101,45 @@ HWTEST_F(DeviceTimedCollectTest, SamgrTimeHandlerTest002, TestSize.Level3)
     DTEST_LOG << " SamgrTimeHandlerTest002 end" << std::endl;
 }
 
+/**
+ * @tc.name: SamgrTimeHandlerTest003
+ * @tc.desc: test SamgrTimeHandler CancelTask, a cancelled task can not be cancelled again
+ * @tc.type: FUNC
+ * @tc.require: I7VZ98
+ */
+HWTEST_F(DeviceTimedCollectTest, SamgrTimeHandlerTest003, TestSize.Level3)
+{
+    DTEST_LOG << " SamgrTimeHandlerTest003 begin" << std::endl;
+    uint64_t taskId = SamgrTimeHandler::INVALID_TASK_ID;
+    bool bRet = SamgrTimeHandler::GetInstance()->PostTask([] () {}, 100, taskId);
+    EXPECT_TRUE(bRet);
+    EXPECT_NE(taskId, SamgrTimeHandler::INVALID_TASK_ID);
+    EXPECT_TRUE(SamgrTimeHandler::GetInstance()->CancelTask(taskId));
+    EXPECT_FALSE(SamgrTimeHandler::GetInstance()->CancelTask(taskId));
+    EXPECT_FALSE(SamgrTimeHandler::GetInstance()->CancelTask(SamgrTimeHandler::INVALID_TASK_ID));
+    DTEST_LOG << " SamgrTimeHandlerTest003 end" << std::endl;
+}
+
+/**
+ * @tc.name: SamgrTimeHandlerTest004
+ * @tc.desc: test SamgrTimeHandler runs due tasks on the shared timer and skips cancelled ones
+ * @tc.type: FUNC
+ * @tc.require: I7VZ98
+ */
+HWTEST_F(DeviceTimedCollectTest, SamgrTimeHandlerTest004, TestSize.Level3)
+{
+    DTEST_LOG << " SamgrTimeHandlerTest004 begin" << std::endl;
+    std::shared_ptr<std::atomic<int32_t>> runCount = std::make_shared<std::atomic<int32_t>>(0);
+    uint64_t cancelledId = SamgrTimeHandler::INVALID_TASK_ID;
+    EXPECT_TRUE(SamgrTimeHandler::GetInstance()->PostTask([runCount] () { (*runCount)++; }, 1));
+    EXPECT_TRUE(SamgrTimeHandler::GetInstance()->PostTask([runCount] () { (*runCount) += 100; }, 1, cancelledId));
+    EXPECT_TRUE(SamgrTimeHandler::GetInstance()->PostTask([runCount] () { (*runCount)++; }, 0));
+    EXPECT_TRUE(SamgrTimeHandler::GetInstance()->CancelTask(cancelledId));
+    sleep(2);
+    EXPECT_EQ(runCount->load(), 2);
+    DTEST_LOG << " SamgrTimeHandlerTest004 end" << std::endl;
+}
+
 #ifdef PREFERENCES_ENABLE
 /**
  * @tc.name: ProcessPersistenceTasks001
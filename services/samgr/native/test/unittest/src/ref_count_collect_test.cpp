@@ -173,4 +173,74 @@ HWTEST_F(RefCountCollectTest, IdentifyUnrefOndemandNullManager001, TestSize.Leve
     EXPECT_EQ(collect->unrefUnloadSaList_.size(), 1u);
     DTEST_LOG << "IdentifyUnrefOndemandNullManager001 END" << std::endl;
 }
+
+/**
+ * @tc.name: OnSystemAbilityAdded001
+ * @tc.desc: test OnSystemAbilityAdded001, only unrefUnload SA are tracked and the poll starts at the old period
+ * @tc.type: FUNC
+ */
+HWTEST_F(RefCountCollectTest, OnSystemAbilityAdded001, TestSize.Level1)
+{
+    sptr<DeviceStatusCollectManager> manager =
+        new DeviceStatusCollectManager(std::weak_ptr<BaseSystemAbilityManager>{});
+    sptr<RefCountCollect> collect = new RefCountCollect(manager);
+    collect->unrefUnloadSaList_.push_back(1);
+    EXPECT_EQ(collect->pollInterval_, 1000u * 60);
+    collect->OnSystemAbilityAdded(2);
+    EXPECT_TRUE(collect->loadedUnrefSaSet_.empty());
+    collect->OnSystemAbilityAdded(1);
+    EXPECT_EQ(collect->loadedUnrefSaSet_.count(1), 1u);
+    EXPECT_EQ(collect->pollInterval_, 1000u * 60);
+    EXPECT_EQ(collect->timerId_, 0u);
+    collect->pollInterval_ = 1000u * 5;
+    collect->OnSystemAbilityRemoved(1);
+    EXPECT_TRUE(collect->loadedUnrefSaSet_.empty());
+    EXPECT_EQ(collect->pollInterval_, 1000u * 60);
+}
+
+/**
+ * @tc.name: OnSystemAbilityAdded002
+ * @tc.desc: test OnSystemAbilityAdded002, the poll is only armed while an unrefUnload SA is loaded
+ * @tc.type: FUNC
+ */
+HWTEST_F(RefCountCollectTest, OnSystemAbilityAdded002, TestSize.Level1)
+{
+    sptr<DeviceStatusCollectManager> manager =
+        new DeviceStatusCollectManager(std::weak_ptr<BaseSystemAbilityManager>{});
+    sptr<RefCountCollect> collect = new RefCountCollect(manager);
+    collect->unrefUnloadSaList_.push_back(1);
+    EXPECT_EQ(collect->OnStart(), ERR_OK);
+    EXPECT_NE(collect->timer_, nullptr);
+    EXPECT_EQ(collect->timerId_, 0u);
+    collect->OnSystemAbilityAdded(1);
+    EXPECT_NE(collect->timerId_, 0u);
+    collect->OnSystemAbilityRemoved(1);
+    EXPECT_EQ(collect->timerId_, 0u);
+    EXPECT_EQ(collect->OnStop(), ERR_OK);
+    EXPECT_EQ(collect->timer_, nullptr);
+}
+
+/**
+ * @tc.name: IdentifyUnrefOndemand002
+ * @tc.desc: test IdentifyUnrefOndemand002, the poll interval backs off from a hit up to the old period
+ * @tc.type: FUNC
+ */
+HWTEST_F(RefCountCollectTest, IdentifyUnrefOndemand002, TestSize.Level1)
+{
+    sptr<DeviceStatusCollectManager> manager =
+        new DeviceStatusCollectManager(std::weak_ptr<BaseSystemAbilityManager>{});
+    sptr<RefCountCollect> collect = new RefCountCollect(manager);
+    collect->unrefUnloadSaList_.push_back(1);
+    collect->OnSystemAbilityAdded(1);
+    collect->pollInterval_ = 1000u * 5;
+    collect->IdentifyUnrefOndemand();
+    EXPECT_EQ(collect->pollInterval_, 1000u * 10);
+    for (int32_t i = 0; i < 20; i++) {
+        collect->IdentifyUnrefOndemand();
+    }
+    uint32_t maxInterval = collect->pollInterval_;
+    EXPECT_EQ(maxInterval, 1000u * 60);
+    collect->IdentifyUnrefOndemand();
+    EXPECT_EQ(collect->pollInterval_, maxInterval);
+}
 } // namespace OHOS
@@ -23,11 +23,13 @@
 #include <sam_mock_permission.h>
 #include <vector>
 #include <set>
+#include <unistd.h>
 #define private public
 #define protected public
 #include "system_ability_manager_dumper.h"
 #include "system_ability_manager.h"
 #include "samgr_err_code.h"
+#include "samgr_latency_stats.h"
 using namespace std;
 using namespace testing;
 using namespace testing::ext;
@@ -1447,6 +1449,38 @@ HWTEST_F(SystemAbilityManagerDumperTest, SaveDumpResultToFd002, TestSize.Level1)
     DTEST_LOG << "SaveDumpResultToFd002 end" << std::endl;
 }
 
+namespace {
+std::string ReadAllFromFd(int32_t fd)
+{
+    std::string content;
+    char buffer[256] = {};
+    ssize_t len = 0;
+    while ((len = read(fd, buffer, sizeof(buffer))) > 0) {
+        content.append(buffer, static_cast<size_t>(len));
+    }
+    return content;
+}
+
+// runs GetListenerDumpProc over the listeners and returns what it wrote to the fd
+std::string DumpListeners(const std::map<int32_t, std::list<SAListener>>& listeners,
+    const std::vector<std::string>& args, const std::shared_ptr<SaListenerNotifier>& listenerNotifier = nullptr)
+{
+    std::vector<SAListenerDumpInfo> dumpInfos;
+    SystemAbilityManagerDumper::GetListenerDumpInfo(listeners, dumpInfos);
+    int32_t fds[2] = { -1, -1 };
+    if (pipe(fds) != 0) {
+        return "";
+    }
+    DumpFdWriter writer(fds[1]);
+    SystemAbilityManagerDumper::GetListenerDumpProc(dumpInfos, args, writer, listenerNotifier);
+    writer.Flush();
+    close(fds[1]);
+    std::string result = ReadAllFromFd(fds[0]);
+    close(fds[0]);
+    return result;
+}
+}
+
 HWTEST_F(SystemAbilityManagerDumperTest, ShowListenerHelp001, TestSize.Level1)
 {
     DTEST_LOG<<"ShowListenerHelp001 BEGIN"<<std::endl;
@@ -1456,12 +1490,12 @@ HWTEST_F(SystemAbilityManagerDumperTest, ShowListenerHelp001, TestSize.Level1)
     
     int32_t fd = 1;
     std::vector<std::string> args;
-    std::map<int32_t, std::list<SAListener>> listeners;
-    int32_t ret = SystemAbilityManagerDumper::ListenerDumpProc(listeners, fd, args);
+    std::vector<SAListenerDumpInfo> dumpInfos;
+    int32_t ret = SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, args);
     EXPECT_EQ(ERR_OK, ret);
 
     SamMockPermission::MockProcess("hidumper_service");
-    ret = SystemAbilityManagerDumper::ListenerDumpProc(listeners, fd, args);
+    ret = SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, args);
     EXPECT_EQ(ERR_OK, ret);
     DTEST_LOG<<"ShowListenerHelp001 END"<<std::endl;
 }
@@ -1477,11 +1511,11 @@ HWTEST_F(SystemAbilityManagerDumperTest, GetListenerDumpProc001, TestSize.Level1
     auto cPid = IPCSkeleton::GetCallingPid();
     SAListener saLst(lster, cPid, ListenerState::INIT);
     listeners[1].push_back(saLst);
-    SystemAbilityManagerDumper::GetListenerDumpProc(listeners, args, result);
+    result = DumpListeners(listeners, args);
     EXPECT_EQ(strIllegal, result);
     result.clear();
     args.push_back(strArgsHelp);
-    SystemAbilityManagerDumper::GetListenerDumpProc(listeners, args, result);
+    result = DumpListeners(listeners, args);
     EXPECT_FALSE(result.empty());
     result.clear();
     DTEST_LOG<<"GetListenerDumpProc001 END"<<std::endl;
@@ -1500,26 +1534,240 @@ HWTEST_F(SystemAbilityManagerDumperTest, GetListenerDumpProc002, TestSize.Level1
     listeners[100].push_back(saLst);
     args.push_back(strArgsQueryAll);
     args.push_back(strArgsQuerySA);
-    SystemAbilityManagerDumper::GetListenerDumpProc(listeners, args, result);
+    result = DumpListeners(listeners, args);
     EXPECT_FALSE(result.empty());
     result.clear();
     args[LISTENER_BASE_INDEX + 1] = strArgsQueryProcess;
-    SystemAbilityManagerDumper::GetListenerDumpProc(listeners, args, result);
+    result = DumpListeners(listeners, args);
     EXPECT_FALSE(result.empty());
     result.clear();
     args[LISTENER_BASE_INDEX] = strArgsQuerySA;
     args[LISTENER_BASE_INDEX + 1] = "100";
-    SystemAbilityManagerDumper::GetListenerDumpProc(listeners, args, result);
+    result = DumpListeners(listeners, args);
     EXPECT_FALSE(result.empty());
     result.clear();
     args[LISTENER_BASE_INDEX] = strArgsQueryProcess;
     args[LISTENER_BASE_INDEX + 1] = std::to_string(static_cast<int>(cPid));
-    SystemAbilityManagerDumper::GetListenerDumpProc(listeners, args, result);
+    result = DumpListeners(listeners, args);
     EXPECT_FALSE(result.empty());
     result.clear();
     DTEST_LOG<<"GetListenerDumpProc002 END"<<std::endl;
 }
 
+HWTEST_F(SystemAbilityManagerDumperTest, GetListenerDumpProc003, TestSize.Level1)
+{
+    DTEST_LOG<<"GetListenerDumpProc003 BEGIN"<<std::endl;
+    std::string result;
+    std::vector<std::string> args;
+    args.push_back(strHidumperSerName);
+    args.push_back("-notify");
+    std::map<int32_t, std::list<SAListener>> listeners;
+    auto listenerNotifier = std::make_shared<SaListenerNotifier>();
+    result = DumpListeners(listeners, args, listenerNotifier);
+    EXPECT_NE(result.find("listener notify metrics"), std::string::npos);
+    result.clear();
+    result = DumpListeners(listeners, args);
+    EXPECT_EQ(strIllegal, result);
+    DTEST_LOG<<"GetListenerDumpProc003 END"<<std::endl;
+}
+
+/**
+ * @tc.name: GetListenerDumpInfo001
+ * @tc.desc: listener dump counts from the copied fields, distinct listener objects counted once
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityManagerDumperTest, GetListenerDumpInfo001, TestSize.Level1)
+{
+    DTEST_LOG << "GetListenerDumpInfo001 BEGIN" << std::endl;
+    sptr<ISystemAbilityStatusChange> lster1 = new SystemAbilityStatusChangeProxy(nullptr);
+    sptr<ISystemAbilityStatusChange> lster2 = new SystemAbilityStatusChangeProxy(nullptr);
+    std::map<int32_t, std::list<SAListener>> listeners;
+    listeners[100].emplace_back(lster1, 1);
+    listeners[100].emplace_back(lster2, 2);
+    listeners[200].emplace_back(lster1, 1);
+    listeners[300];
+    std::vector<SAListenerDumpInfo> dumpInfos;
+    SystemAbilityManagerDumper::GetListenerDumpInfo(listeners, dumpInfos);
+    ASSERT_EQ(dumpInfos.size(), 3u);
+    EXPECT_EQ(dumpInfos[0].systemAbilityId, 100);
+    EXPECT_EQ(dumpInfos[1].callingPid, 2);
+    EXPECT_EQ(dumpInfos[0].listenerKey, dumpInfos[2].listenerKey);
+    EXPECT_NE(dumpInfos[0].listenerKey, dumpInfos[1].listenerKey);
+
+    std::vector<std::string> args = { strHidumperSerName, strArgsQueryAll, strArgsQuerySA };
+    std::string result = DumpListeners(listeners, args);
+    EXPECT_NE(result.find("SA:100, SubCnt:2"), std::string::npos);
+    EXPECT_NE(result.find("SA:200, SubCnt:1"), std::string::npos);
+    EXPECT_EQ(result.find("SA:300"), std::string::npos);
+    EXPECT_NE(result.find("TotalListenerCnt:2-"), std::string::npos);
+    args = { strHidumperSerName, strArgsQueryProcess, "1" };
+    result = DumpListeners(listeners, args);
+    EXPECT_NE(result.find("SA:100, cnt:1\nSA:200, cnt:1"), std::string::npos);
+    EXPECT_NE(result.find("ListenerCnt:1-"), std::string::npos);
+    DTEST_LOG << "GetListenerDumpInfo001 END" << std::endl;
+}
+
+namespace {
+std::shared_ptr<SystemAbilityStateScheduler> MakeStreamDumpScheduler()
+{
+    std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler =
+        std::make_shared<SystemAbilityStateScheduler>(std::weak_ptr<BaseSystemAbilityManager>{});
+    std::shared_ptr<SystemProcessContext> processContext = std::make_shared<SystemProcessContext>();
+    processContext->processName = u"stream_dump_process";
+    processContext->pid = 100;
+    processContext->uid = 1000;
+    std::shared_ptr<SystemAbilityContext> loadedContext = std::make_shared<SystemAbilityContext>();
+    loadedContext->systemAbilityId = 1701;
+    loadedContext->state = SystemAbilityState::LOADED;
+    loadedContext->ownProcessContext = processContext;
+    std::shared_ptr<SystemAbilityContext> orphanContext = std::make_shared<SystemAbilityContext>();
+    orphanContext->systemAbilityId = 1702;
+    abilityStateScheduler->abilityContextMap_[loadedContext->systemAbilityId] = loadedContext;
+    abilityStateScheduler->abilityContextMap_[orphanContext->systemAbilityId] = orphanContext;
+    return abilityStateScheduler;
+}
+}
+
+/**
+ * @tc.name: StreamDumpProc001
+ * @tc.desc: stream -l into the fd, output matches GetAllSystemAbilityInfo
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityManagerDumperTest, StreamDumpProc001, TestSize.Level3)
+{
+    DTEST_LOG << "StreamDumpProc001 begin" << std::endl;
+    SamMockPermission::MockProcess("hidumper_service");
+    std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler = MakeStreamDumpScheduler();
+    std::string expected;
+    abilityStateScheduler->GetAllSystemAbilityInfo(expected);
+    EXPECT_NE(expected.find("stream_dump_process"), std::string::npos);
+
+    std::vector<std::string> args = { "-l" };
+    EXPECT_TRUE(SystemAbilityManagerDumper::IsStreamDump(args));
+    int32_t fds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(fds), 0);
+    int32_t ret = SystemAbilityManagerDumper::StreamDumpProc(abilityStateScheduler, fds[1], args);
+    close(fds[1]);
+    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(ReadAllFromFd(fds[0]), expected);
+    close(fds[0]);
+    DTEST_LOG << "StreamDumpProc001 end" << std::endl;
+}
+
+/**
+ * @tc.name: StreamDumpProc002
+ * @tc.desc: stream -sm state into the fd, only SAs in that state are written
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityManagerDumperTest, StreamDumpProc002, TestSize.Level3)
+{
+    DTEST_LOG << "StreamDumpProc002 begin" << std::endl;
+    SamMockPermission::MockProcess("hidumper_service");
+    std::shared_ptr<SystemAbilityStateScheduler> abilityStateScheduler = MakeStreamDumpScheduler();
+    std::string expected;
+    abilityStateScheduler->GetAllSystemAbilityInfoByState("LOADED", expected);
+
+    std::vector<std::string> args = { "-sm", "LOADED" };
+    EXPECT_TRUE(SystemAbilityManagerDumper::IsStreamDump(args));
+    int32_t fds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(fds), 0);
+    int32_t ret = SystemAbilityManagerDumper::StreamDumpProc(abilityStateScheduler, fds[1], args);
+    close(fds[1]);
+    EXPECT_EQ(ret, ERR_OK);
+    std::string actual = ReadAllFromFd(fds[0]);
+    close(fds[0]);
+    EXPECT_EQ(actual, expected);
+    EXPECT_NE(actual.find("1701"), std::string::npos);
+    EXPECT_EQ(actual.find("1702"), std::string::npos);
+
+    args = { "-sa", "1701" };
+    EXPECT_FALSE(SystemAbilityManagerDumper::IsStreamDump(args));
+    args = { "-l" };
+    EXPECT_EQ(SystemAbilityManagerDumper::StreamDumpProc(abilityStateScheduler, -1, args), ERR_INVALID_VALUE);
+    // not hidumper: nothing is written and ERR_OK is returned, as the buffered dump did
+    SamMockPermission::MockProcess("demo_service");
+    EXPECT_EQ(SystemAbilityManagerDumper::StreamDumpProc(abilityStateScheduler, -1, args), ERR_OK);
+    DTEST_LOG << "StreamDumpProc002 end" << std::endl;
+}
+
+/**
+ * @tc.name: LatencyHistogram001
+ * @tc.desc: LatencyHistogram buckets and percentiles
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityManagerDumperTest, LatencyHistogram001, TestSize.Level3)
+{
+    DTEST_LOG << " LatencyHistogram001 BEGIN" << std::endl;
+    LatencyHistogram histogram;
+    for (uint64_t us : { 0, 1, 2, 3, 1000 }) {
+        histogram.Record(us);
+    }
+    LatencySnapshot snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, 5);
+    EXPECT_EQ(snapshot.maxUs, 1000);
+    EXPECT_EQ(snapshot.GetAvgUs(), 201);
+    EXPECT_EQ(snapshot.buckets[0], 1);
+    EXPECT_EQ(snapshot.buckets[1], 1);
+    EXPECT_EQ(snapshot.buckets[2], 2);
+    EXPECT_EQ(snapshot.GetPercentileUs(50), 4);
+    EXPECT_EQ(snapshot.GetPercentileUs(100), 1000);
+    histogram.Reset();
+    EXPECT_EQ(histogram.GetSnapshot().count, 0);
+    EXPECT_EQ(histogram.GetSnapshot().GetPercentileUs(99), 0);
+    DTEST_LOG << " LatencyHistogram001 END" << std::endl;
+}
+
+/**
+ * @tc.name: LatencyDump001
+ * @tc.desc: test --latency via Dump
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityManagerDumperTest, LatencyDump001, TestSize.Level3)
+{
+    DTEST_LOG << " LatencyDump001 BEGIN" << std::endl;
+    SamMockPermission::MockProcess("hidumper_service");
+    SamgrLatencyStats& stats = SamgrLatencyStats::GetInstance();
+    stats.Reset();
+    stats.RecordRequest(3, 100, 0);
+    stats.RecordRequest(3, 300, 20);
+    stats.RecordRequest(1000, 10, 0);
+    stats.RecordLockWait(SamgrLockId::ON_DEMAND, 20);
+    std::vector<std::string> args = { "--latency" };
+    std::string result;
+    bool ret = SystemAbilityManagerDumper::Dump(nullptr, args, result);
+    EXPECT_EQ(ret, true);
+    EXPECT_NE(result.find("code:3 count:2 serviceAvg:200"), std::string::npos);
+    EXPECT_NE(result.find("lockWaitMax:20"), std::string::npos);
+    EXPECT_NE(result.find("code:other count:1"), std::string::npos);
+    EXPECT_NE(result.find("onDemandLock blocked:1"), std::string::npos);
+    EXPECT_NE(result.find("abilityMapLock blocked:0"), std::string::npos);
+    stats.Reset();
+    DTEST_LOG << " LatencyDump001 END" << std::endl;
+}
+
+/**
+ * @tc.name: LatencyDump002
+ * @tc.desc: test --latency --reset via Dump
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityManagerDumperTest, LatencyDump002, TestSize.Level3)
+{
+    DTEST_LOG << " LatencyDump002 BEGIN" << std::endl;
+    SamMockPermission::MockProcess("hidumper_service");
+    SamgrLatencyStats& stats = SamgrLatencyStats::GetInstance();
+    stats.RecordRequest(3, 100, 0);
+    std::vector<std::string> args = { "--latency", "--reset" };
+    std::string result;
+    bool ret = SystemAbilityManagerDumper::Dump(nullptr, args, result);
+    EXPECT_EQ(ret, true);
+    EXPECT_EQ(stats.GetCodeStats(3).service.GetSnapshot().count, 0);
+    args = { "--latency", "--other" };
+    result.clear();
+    ret = SystemAbilityManagerDumper::Dump(nullptr, args, result);
+    EXPECT_EQ(ret, false);
+    DTEST_LOG << " LatencyDump002 END" << std::endl;
+}
+
 #ifdef SUPPORT_MULTI_INSTANCE
 /**
  * @tc.name: MultiInstanceDump001
@@ -941,6 +941,7 @@ HWTEST_F(SystemAbilityMgrLoadTest, DoUnloadSystemAbility002, TestSize.Level3)
     SAInfo sAInfo;
     sAInfo.remoteObj = saObject;
     saMgr->abilityMap_[SAID] = sAInfo;
+    saMgr->RefreshAbilityTableLocked();
     OnDemandEvent onDemandEvent;
     int32_t ret = saMgr->DoUnloadSystemAbility(SAID, PROCESS_NAME, onDemandEvent);
     EXPECT_EQ(ret, ERR_INVALID_VALUE);
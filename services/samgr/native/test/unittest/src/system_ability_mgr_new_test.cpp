@@ -125,6 +125,7 @@ void SaAbilityMapObjTestPrevSet(sptr<SystemAbilityManager>& saMgr, int32_t maxLo
         SAInfo saInfo;
         saInfo.remoteObj = testAbility;
         saMgr->abilityMap_[SAID + loop] = saInfo;
+        saMgr->RefreshAbilityTableLocked();
     }
 
     return;
@@ -287,6 +288,7 @@ HWTEST_F(SystemAbilityMgrNewTest, GetSystemAbilityFromRemote003, TestSize.Level3
     InitSaMgr(saMgr);
     SAInfo saInfo;
     saMgr->abilityMap_[1] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     int systemAbilityId = 1;
     auto ability = saMgr->GetSystemAbilityFromRemote(systemAbilityId);
     EXPECT_EQ(ability, nullptr);
@@ -305,6 +307,7 @@ HWTEST_F(SystemAbilityMgrNewTest, GetSystemAbilityFromRemote004, TestSize.Level3
     SAInfo saInfo;
     saInfo.isDistributed = true;
     saMgr->abilityMap_[1] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     int systemAbilityId = 1;
     auto ability = saMgr->GetSystemAbilityFromRemote(systemAbilityId);
     EXPECT_EQ(ability, nullptr);
@@ -1235,4 +1238,92 @@ HWTEST_F(SystemAbilityMgrNewTest, StartingSystemProcessLocked001, TestSize.Level
     EXPECT_NE(result, expectedResult);
     DTEST_LOG <<"StartingSystemProcessLocked001 end " << std::endl;
 }
+
+/**
+ * @tc.name: GetSystemAbilitiesInner001
+ * @tc.desc: test GetSystemAbilitiesInner, read empty or oversized SAIds!
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrNewTest, GetSystemAbilitiesInner001, TestSize.Level3)
+{
+    DTEST_LOG << __func__ << std::endl;
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    EXPECT_TRUE(saMgr != nullptr);
+    InitSaMgr(saMgr);
+    MessageParcel data;
+    MessageParcel reply;
+    int32_t result = saMgr->GetSystemAbilitiesInner(data, reply);
+    EXPECT_EQ(result, ERR_FLATTEN_OBJECT);
+
+    MessageParcel emptyData;
+    emptyData.WriteInt32Vector(std::vector<int32_t>());
+    result = saMgr->GetSystemAbilitiesInner(emptyData, reply);
+    EXPECT_EQ(result, ERR_INVALID_VALUE);
+
+    MessageParcel bigData;
+    bigData.WriteInt32Vector(std::vector<int32_t>(ISystemAbilityManager::MAX_BATCH_SA_NUM + 1, SAID));
+    result = saMgr->GetSystemAbilitiesInner(bigData, reply);
+    EXPECT_EQ(result, ERR_INVALID_VALUE);
+}
+
+/**
+ * @tc.name: GetSystemAbilitiesInner002
+ * @tc.desc: test GetSystemAbilitiesInner, per-SA result for present, absent and invalid SAs!
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrNewTest, GetSystemAbilitiesInner002, TestSize.Level3)
+{
+    DTEST_LOG << __func__ << std::endl;
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    EXPECT_TRUE(saMgr != nullptr);
+    InitSaMgr(saMgr);
+    const int32_t maxLoop = 3;
+    SaAbilityMapObjTestPrevSet(saMgr, maxLoop);
+
+    std::vector<int32_t> saIds = { SAID + 1, SAID, -1, SAID + 2 };
+    MessageParcel data;
+    MessageParcel reply;
+    data.WriteInt32Vector(saIds);
+    int32_t result = saMgr->GetSystemAbilitiesInner(data, reply);
+    EXPECT_EQ(result, ERR_NONE);
+    EXPECT_TRUE(reply.ReadInt32(result));
+    EXPECT_EQ(result, ERR_OK);
+    std::vector<int32_t> expectCodes = { ERR_OK, ERR_NULL_OBJECT, ERR_INVALID_VALUE, ERR_OK };
+    for (auto expectCode : expectCodes) {
+        int32_t errCode = -1;
+        EXPECT_TRUE(reply.ReadInt32(errCode));
+        EXPECT_EQ(errCode, expectCode);
+        if (errCode == ERR_OK) {
+            EXPECT_NE(reply.ReadRemoteObject(), nullptr);
+        }
+    }
+}
+
+/**
+ * @tc.name: GetSystemAbilities001
+ * @tc.desc: test GetSystemAbilities, results follow the order of the requested SAIds!
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrNewTest, GetSystemAbilities001, TestSize.Level3)
+{
+    DTEST_LOG << __func__ << std::endl;
+    sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
+    EXPECT_TRUE(saMgr != nullptr);
+    InitSaMgr(saMgr);
+    const int32_t maxLoop = 3;
+    SaAbilityMapObjTestPrevSet(saMgr, maxLoop);
+
+    std::vector<int32_t> saIds = { SAID + 2, SAID + 1, SAID };
+    std::vector<sptr<IRemoteObject>> saList;
+    std::vector<int32_t> errCodes;
+    int32_t result = saMgr->GetSystemAbilities(saIds, saList, errCodes);
+    EXPECT_EQ(result, ERR_OK);
+    ASSERT_EQ(saList.size(), saIds.size());
+    ASSERT_EQ(errCodes.size(), saIds.size());
+    EXPECT_EQ(saList[0], saMgr->CheckSystemAbility(SAID + 2));
+    EXPECT_EQ(saList[1], saMgr->CheckSystemAbility(SAID + 1));
+    EXPECT_EQ(saList[2], nullptr);
+    EXPECT_EQ(errCodes[0], ERR_OK);
+    EXPECT_EQ(errCodes[2], ERR_NULL_OBJECT);
+}
 } // namespace OHOS
@@ -370,11 +370,13 @@ HWTEST_F(SystemAbilityMgrOnDemandTest, GetAllOndemandSa002, TestSize.Level3)
     saMgr->saProfileMap_[1] = saProfile;
     SAInfo saInfo;
     saMgr->abilityMap_[1] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->GetAllOndemandSa();
     bool value = system::GetBoolParameter(ONDEMAND_PARAM, false);
     EXPECT_TRUE(value);
     saMgr->saProfileMap_.clear();
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
 }
 
 /**
@@ -981,11 +983,13 @@ HWTEST_F(SystemAbilityMgrOnDemandTest, IdleSystemAbility003, TestSize.Level3)
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[TEST_OVERFLOW_SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     nlohmann::json idleReason;
     int32_t delayTime = 0;
     bool ret = saMgr->IdleSystemAbility(TEST_OVERFLOW_SAID, u"test", idleReason, delayTime);
     EXPECT_FALSE(ret);
     saMgr->abilityMap_.erase(TEST_OVERFLOW_SAID);
+    saMgr->RefreshAbilityTableLocked();
 }
 
 /**
@@ -1004,11 +1008,13 @@ HWTEST_F(SystemAbilityMgrOnDemandTest, IdleSystemAbility004, TestSize.Level1)
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     nlohmann::json idleReason;
     int32_t delayTime = 0;
     bool ret = saMgr->IdleSystemAbility(SAID, u"test", idleReason, delayTime);
     EXPECT_FALSE(ret);
     saMgr->abilityMap_.erase(SAID);
+    saMgr->RefreshAbilityTableLocked();
     DTEST_LOG << "IdleSystemAbility004 end" << std::endl;
 }
 
@@ -1067,10 +1073,12 @@ HWTEST_F(SystemAbilityMgrOnDemandTest, ActiveSystemAbility003, TestSize.Level3)
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[TEST_OVERFLOW_SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     nlohmann::json activeReason;
     bool ret = saMgr->ActiveSystemAbility(TEST_OVERFLOW_SAID, u"test", activeReason);
     EXPECT_FALSE(ret);
     saMgr->abilityMap_.erase(TEST_OVERFLOW_SAID);
+    saMgr->RefreshAbilityTableLocked();
 }
 
 /**
@@ -1088,10 +1096,12 @@ HWTEST_F(SystemAbilityMgrOnDemandTest, ActiveSystemAbility004, TestSize.Level1)
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     nlohmann::json activeReason;
     bool ret = saMgr->ActiveSystemAbility(SAID, u"test", activeReason);
     EXPECT_FALSE(ret);
     saMgr->abilityMap_.erase(SAID);
+    saMgr->RefreshAbilityTableLocked();
     DTEST_LOG << "ActiveSystemAbility004 end" << std::endl;
 }
 
@@ -1130,9 +1140,11 @@ HWTEST_F(SystemAbilityMgrOnDemandTest, OnStartSystemAbilityFail001, TestSize.Lev
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[TEST_OVERFLOW_SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     int32_t ret = saMgr->OnStartSystemAbilityFail(TEST_OVERFLOW_SAID, -1);
     EXPECT_EQ(ret, ERR_OK);
     saMgr->abilityMap_.erase(TEST_OVERFLOW_SAID);
+    saMgr->RefreshAbilityTableLocked();
     ret = saMgr->OnStartSystemAbilityFail(TEST_OVERFLOW_SAID, -1);
     EXPECT_EQ(ret, ERR_INVALID_VALUE);
     CommonSaProfile saProfile = {u"test", TEST_OVERFLOW_SAID};
@@ -1886,4 +1886,134 @@ HWTEST_F(SystemAbilityMgrProxyTest, OnUserStateChanged003, TestSize.Level3)
 }
 #endif
 
-}
\ No newline at end of file
+/**
+ * @tc.name: DynamicCacheMultiEntry001
+ * @tc.desc: entries of different SAs are kept side by side and validated by their own waterline
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrProxyTest, DynamicCacheMultiEntry001, TestSize.Level3)
+{
+    DTEST_LOG << " DynamicCacheMultiEntry001 begin " << std::endl;
+    sptr<SystemAbilityManagerProxy> sm = new SystemAbilityManagerProxy(nullptr);
+    sptr<IRemoteObject> remote1(new TestTransactionService());
+    sptr<IRemoteObject> remote2(new TestTransactionService());
+    sm->queryCache_[TEST_ID_VAILD] = { remote1, "100", 1 };
+    sm->queryCache_[TEST_ID_INVAILD] = { remote2, "200", 2 };
+    char waterLine[] = "100";
+    EXPECT_TRUE(sm->CanUseCache(TEST_ID_VAILD, waterLine, "default"));
+    EXPECT_FALSE(sm->CanUseCache(TEST_ID_INVAILD, waterLine, "default"));
+    EXPECT_FALSE(sm->CanUseCache(TEST_SAID_INVALID, waterLine, "default"));
+    char defaultLine[] = "default";
+    sm->queryCache_[TEST_ID_VAILD].waterLine = "default";
+    EXPECT_FALSE(sm->CanUseCache(TEST_ID_VAILD, defaultLine, "default"));
+    DTEST_LOG << " DynamicCacheMultiEntry001 end " << std::endl;
+}
+
+/**
+ * @tc.name: DynamicCacheMultiEntry002
+ * @tc.desc: clearing one SA or a dead proxy leaves the other entries in place
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrProxyTest, DynamicCacheMultiEntry002, TestSize.Level3)
+{
+    DTEST_LOG << " DynamicCacheMultiEntry002 begin " << std::endl;
+    sptr<SystemAbilityManagerProxy> sm = new SystemAbilityManagerProxy(nullptr);
+    sptr<IRemoteObject> remote1(new TestTransactionService());
+    sptr<IRemoteObject> remote2(new TestTransactionService());
+    sptr<IRemoteObject> remote3(new TestTransactionService());
+    sm->queryCache_[TEST_ID_VAILD] = { remote1, "100", 1 };
+    sm->queryCache_[TEST_ID_INVAILD] = { remote2, "100", 2 };
+    sm->queryCache_[TEST_SAID_INVALID] = { remote3, "100", 3 };
+    sm->ClearCache(TEST_ID_VAILD);
+    EXPECT_EQ(sm->queryCache_.size(), 2);
+    sm->OnRemoteDied(remote2);
+    EXPECT_EQ(sm->queryCache_.count(TEST_ID_INVAILD), 0);
+    EXPECT_EQ(sm->queryCache_.count(TEST_SAID_INVALID), 1);
+    sm->ClearCache();
+    EXPECT_TRUE(sm->queryCache_.empty());
+    DTEST_LOG << " DynamicCacheMultiEntry002 end " << std::endl;
+}
+
+/**
+ * @tc.name: DynamicCacheMultiEntry003
+ * @tc.desc: the least recently used entry is evicted once the cache is full
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrProxyTest, DynamicCacheMultiEntry003, TestSize.Level3)
+{
+    DTEST_LOG << " DynamicCacheMultiEntry003 begin " << std::endl;
+    sptr<SystemAbilityManagerProxy> sm = new SystemAbilityManagerProxy(nullptr);
+    sptr<IRemoteObject> remote(new TestTransactionService());
+    for (size_t i = 0; i < DynamicCache::MAX_CACHE_ENTRIES; i++) {
+        int32_t saId = TEST_ID_VAILD - static_cast<int32_t>(i);
+        sm->queryCache_[saId] = { remote, "100", DynamicCache::MAX_CACHE_ENTRIES - i };
+    }
+    int32_t oldestSaId = TEST_ID_VAILD - static_cast<int32_t>(DynamicCache::MAX_CACHE_ENTRIES - 1);
+    sm->EvictLocked();
+    EXPECT_EQ(sm->queryCache_.size(), DynamicCache::MAX_CACHE_ENTRIES - 1);
+    EXPECT_EQ(sm->queryCache_.count(oldestSaId), 0);
+    EXPECT_EQ(sm->queryCache_.count(TEST_ID_VAILD), 1);
+    sm->ClearCache();
+    DTEST_LOG << " DynamicCacheMultiEntry003 end " << std::endl;
+}
+
+/**
+ * @tc.name: DynamicCacheBucket001
+ * @tc.desc: SA ids are mapped onto a fixed number of waterline parameters
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrProxyTest, DynamicCacheBucket001, TestSize.Level3)
+{
+    DTEST_LOG << " DynamicCacheBucket001 begin " << std::endl;
+    EXPECT_EQ(DynamicCache::GetCacheKey(0), "samgr.cache.sa.0");
+    EXPECT_EQ(DynamicCache::GetCacheKey(DynamicCache::CACHE_BUCKET_NUM + 1), "samgr.cache.sa.1");
+    EXPECT_EQ(DynamicCache::GetCacheKey(TEST_ID_VAILD),
+        "samgr.cache.sa." + std::to_string(TEST_ID_VAILD % DynamicCache::CACHE_BUCKET_NUM));
+    EXPECT_NE(DynamicCache::GetCacheKey(TEST_ID_VAILD), DynamicCache::GetCacheKey(TEST_ID_VAILD + 1));
+    DTEST_LOG << " DynamicCacheBucket001 end " << std::endl;
+}
+
+/**
+ * @tc.name: GetSystemAbilities001
+ * @tc.desc: check GetSystemAbilities with invalid size and nullptr remote
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrProxyTest, GetSystemAbilities001, TestSize.Level3)
+{
+    DTEST_LOG << " GetSystemAbilities001 begin " << std::endl;
+    sptr<SystemAbilityManagerProxy> sm = new SystemAbilityManagerProxy(nullptr);
+    std::vector<sptr<IRemoteObject>> saList;
+    std::vector<int32_t> errCodes;
+    int32_t ret = sm->GetSystemAbilities({}, saList, errCodes);
+    EXPECT_EQ(ret, ERR_INVALID_VALUE);
+    std::vector<int32_t> saIds(ISystemAbilityManager::MAX_BATCH_SA_NUM + 1, TEST_ID_VAILD);
+    ret = sm->GetSystemAbilities(saIds, saList, errCodes);
+    EXPECT_EQ(ret, ERR_INVALID_VALUE);
+    ret = sm->GetSystemAbilities({ TEST_ID_VAILD }, saList, errCodes);
+    EXPECT_EQ(ret, ERR_INVALID_OPERATION);
+    EXPECT_TRUE(saList.empty());
+    DTEST_LOG << " GetSystemAbilities001 end " << std::endl;
+}
+
+/**
+ * @tc.name: GetSystemAbilities002
+ * @tc.desc: check GetSystemAbilities against samgr, per-SA results follow the requested order
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityMgrProxyTest, GetSystemAbilities002, TestSize.Level3)
+{
+    DTEST_LOG << " GetSystemAbilities002 begin " << std::endl;
+    sptr<ISystemAbilityManager> sm = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    ASSERT_TRUE(sm != nullptr);
+    std::vector<int32_t> saIds = { TEST_SAID_INVALID, TEST_ID_NORANGE_SAID };
+    std::vector<sptr<IRemoteObject>> saList;
+    std::vector<int32_t> errCodes;
+    int32_t ret = sm->GetSystemAbilities(saIds, saList, errCodes);
+    EXPECT_EQ(ret, ERR_OK);
+    ASSERT_EQ(errCodes.size(), saIds.size());
+    EXPECT_EQ(errCodes[0], ERR_NULL_OBJECT);
+    EXPECT_EQ(errCodes[1], ERR_INVALID_VALUE);
+    EXPECT_EQ(saList[0], nullptr);
+    DTEST_LOG << " GetSystemAbilities002 end " << std::endl;
+}
+}
@@ -172,6 +172,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, SubsSystemAbilityInner004, TestSize.Level
     sptr<IRemoteObject> testAbility(new SaStatusChangeMock());
     SAInfo saInfo;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->workHandler_ = make_shared<FFRTHandler>("workHandler");
     MessageParcel data;
     MessageParcel reply;
@@ -190,6 +191,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, CheckSystemAbilityImmeInner004, TestSize.
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     MessageParcel data;
     MessageParcel reply;
     data.WriteInt32(SAID);
@@ -224,6 +226,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, GetSystemAbilityInner002, TestSize.Level3
     MessageParcel reply;
     data.WriteInt32(SAID);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     int32_t result = saMgr->GetSystemAbilityInner(data, reply);
     EXPECT_EQ(result, ERR_NULL_OBJECT);
 }
@@ -238,6 +241,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, GetSystemAbilityInner003, TestSize.Level1
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     data.WriteInt32(SAID);
     int32_t result = saMgr->GetSystemAbilityInner(data, reply);
     EXPECT_EQ(result, ERR_NONE);
@@ -251,6 +255,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, CheckSystemAbilityInner002, TestSize.Leve
     MessageParcel reply;
     data.WriteInt32(SAID);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     int32_t result = saMgr->CheckSystemAbilityInner(data, reply);
     EXPECT_EQ(result, ERR_NULL_OBJECT);
 }
@@ -265,6 +270,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, CheckSystemAbilityInner003, TestSize.Leve
     SAInfo saInfo;
     saInfo.remoteObj = testAbility;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     data.WriteInt32(SAID);
     int32_t result = saMgr->CheckSystemAbilityInner(data, reply);
     EXPECT_EQ(result, ERR_NONE);
@@ -446,8 +452,10 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, GetSystemAbilityFromRemote003, TestSize.L
     SAInfo saInfo;
     saInfo.isDistributed = false;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     sptr<IRemoteObject> res = saMgr->GetSystemAbilityFromRemote(SAID);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     EXPECT_EQ(res, nullptr);
 }
 
@@ -459,8 +467,10 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, GetSystemAbilityFromRemote004, TestSize.L
     saInfo.isDistributed = true;
     saInfo.remoteObj = saMgr;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     sptr<IRemoteObject> res = saMgr->GetSystemAbilityFromRemote(SAID);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     EXPECT_NE(res, nullptr);
 }
 
@@ -479,8 +489,10 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, CheckSystemAbility002, TestSize.Level3)
     SAInfo saInfo;
     saInfo.remoteObj = saMgr;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     sptr<IRemoteObject> res = saMgr->CheckSystemAbility(SAID);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     EXPECT_NE(res, nullptr);
 }
 
@@ -515,6 +527,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, FindSystemAbilityNotify001, TestSize.Leve
     int32_t code = 1;
     bool res = saMgr->FindSystemAbilityNotify(SAID, deviceId, code);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
     EXPECT_EQ(res, ERR_OK);
 }
 
@@ -523,10 +536,12 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, FindSystemAbilityNotify002, TestSize.Leve
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     EXPECT_TRUE(saMgr != nullptr);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
     string deviceId = "test";
     int32_t code = 1;
     bool res = saMgr->FindSystemAbilityNotify(SAID, deviceId, code);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
     EXPECT_EQ(res, ERR_OK);
 }
 
@@ -680,9 +695,11 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, CheckSystemAbility004, TestSize.Level1)
     SAInfo saInfo;
     saInfo.remoteObj = saMgr;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     bool isExist = false;
     sptr<IRemoteObject> res = saMgr->CheckSystemAbility(SAID, isExist);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     EXPECT_NE(res, nullptr);
 }
 
@@ -764,9 +781,18 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, SubscribeSystemAbility004, TestSize.Level
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     EXPECT_TRUE(saMgr != nullptr);
     sptr<SaStatusChangeMock> listener(new SaStatusChangeMock());
-    saMgr->listenerMap_[SAID].push_back({listener, SAID});
+    auto& listeners = saMgr->listenerMap_[SAID];
+    listeners.push_back({listener, SAID});
+    IRemoteObject* key = listener->AsObject().GetRefPtr();
+    saMgr->listenerIndex_[key][SAID] = std::prev(listeners.end());
+    size_t listenerNum = listeners.size();
     int32_t res = saMgr->SubscribeSystemAbility(SAID, listener);
     EXPECT_EQ(res, ERR_OK);
+    EXPECT_EQ(saMgr->listenerMap_[SAID].size(), listenerNum);
+    EXPECT_EQ(saMgr->listenerIndex_[key].size(), 1u);
+    saMgr->UnSubscribeSystemAbility(SAID, listener);
+    EXPECT_EQ(saMgr->listenerIndex_.count(key), 0u);
+    EXPECT_EQ(saMgr->listenerMap_[SAID].size(), listenerNum - 1);
 }
 
 HWTEST_F(SystemAbilityMgrStubLoadTest, AddSystemAbility001, TestSize.Level1)
@@ -833,6 +859,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, AddSystemAbility004, TestSize.Level3)
     sptr<SystemAbilityLoadCallbackMock> callback = new SystemAbilityLoadCallbackMock();
     SAInfo saInfo;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->SendCheckLoadedMsg(SAID, name, srcDeviceId, callback);
     EXPECT_EQ(res, ERR_OK);
 }
@@ -1048,6 +1075,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, LoadSystemAbilityFromRpc003, TestSize.Lev
     string srcDeviceId;
     saMgr->saProfileMap_[SAID] = saProfile;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     AddSystemAbilityContext(SAID, u"listen_test");
     bool res = saMgr->LoadSystemAbilityFromRpc(srcDeviceId, SAID, callback);
     saMgr->abilityStateScheduler_->processContextMap_.clear();
@@ -1076,6 +1104,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, LoadSystemAbilityFromRpc004, TestSize.Lev
     string srcDeviceId = "srcDeviceId";
     saMgr->saProfileMap_[SAID] = saProfile;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->startingAbilityMap_[SAID] = abilityItem;
     saMgr->startingProcessMap_[procName].begin = countNum;
     AddSystemAbilityContext(SAID, procName);
@@ -1183,6 +1212,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, LoadSystemAbility004, TestSize.Level1)
     SystemAbilityManager::AbilityItem abilityItem;
     saMgr->saProfileMap_[SAID] = saProfile;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->startingAbilityMap_[SAID] = abilityItem;
     abilityItem.callbackMap["local"].push_back(make_pair(callback, SAID));
     AddSystemAbilityContext(SAID, u"listen_test");
@@ -1207,6 +1237,7 @@ HWTEST_F(SystemAbilityMgrStubLoadTest, LoadSystemAbility005, TestSize.Level3)
     SystemAbilityManager::AbilityItem abilityItem;
     saMgr->saProfileMap_[SAID] = saProfile;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->startingAbilityMap_[SAID] = abilityItem;
     saMgr->abilityCallbackDeath_ = nullptr;
     AddSystemAbilityContext(SAID, u"listen_test");
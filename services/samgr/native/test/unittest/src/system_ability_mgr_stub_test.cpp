@@ -403,6 +403,7 @@ HWTEST_F(SystemAbilityMgrStubTest, ListSystemAbilityInner004, TestSize.Level1)
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     SAInfo saInfo;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     EXPECT_TRUE(saMgr != nullptr);
     MessageParcel data;
     MessageParcel reply;
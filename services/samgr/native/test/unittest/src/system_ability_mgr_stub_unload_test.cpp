@@ -99,6 +99,7 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, UnSubsSystemAbilityInner004, TestSize.L
     sptr<IRemoteObject> testAbility(new SaStatusChangeMock());
     SAInfo saInfo;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     MessageParcel data;
     MessageParcel reply;
     data.WriteInt32(SAID);
@@ -126,6 +127,7 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, RemoveSystemAbilityInner003, TestSize.L
     MessageParcel reply;
     data.WriteInt32(SAID);
     saMgr->abilityMap_.clear();
+    saMgr->RefreshAbilityTableLocked();
     int32_t result = saMgr->RemoveSystemAbilityInner(data, reply);
     EXPECT_EQ(result, ERR_INVALID_VALUE);
 }
@@ -153,6 +155,7 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, RemoveSystemAbility003, TestSize.Level3
     SAInfo saInfo;
     saInfo.remoteObj = nullptr;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     int32_t res = saMgr->RemoveSystemAbility(SAID);
     EXPECT_EQ(res, ERR_OK);
 }
@@ -164,6 +167,7 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, RemoveSystemAbility004, TestSize.Level3
     SAInfo saInfo;
     saInfo.remoteObj = saMgr;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->abilityDeath_ = nullptr;
     int32_t res = saMgr->RemoveSystemAbility(SAID);
     saMgr->abilityDeath_.clear();
@@ -185,6 +189,7 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, RemoveSystemAbility006, TestSize.Level3
     SAInfo saInfo;
     saInfo.remoteObj = saMgr;
     saMgr->abilityMap_[SAID] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->abilityDeath_ = nullptr;
     int32_t res = saMgr->RemoveSystemAbility(saMgr);
     EXPECT_EQ(res, ERR_OK);
@@ -198,6 +203,7 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, RemoveSystemAbility007, TestSize.Level3
     saInfo.remoteObj = saMgr;
     uint32_t saId = 0;
     saMgr->abilityMap_[saId] = saInfo;
+    saMgr->RefreshAbilityTableLocked();
     saMgr->abilityDeath_ = nullptr;
     int32_t res = saMgr->RemoveSystemAbility(saMgr);
     EXPECT_EQ(res, ERR_OK);
@@ -235,11 +241,18 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, UnSubscribeSystemAbility004, TestSize.L
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     EXPECT_TRUE(saMgr != nullptr);
     sptr<SaStatusChangeMock> listener(new SaStatusChangeMock());
-    saMgr->listenerMap_[SAID].push_back({listener, SAID});
+    auto& listeners = saMgr->listenerMap_[SAID];
+    listeners.push_back({listener, SAID});
+    IRemoteObject* key = listener->AsObject().GetRefPtr();
+    saMgr->listenerIndex_[key][SAID] = std::prev(listeners.end());
+    size_t listenerNum = listeners.size();
     saMgr->abilityStatusDeath_ = nullptr;
     saMgr->subscribeCountMap_.clear();
     int32_t res = saMgr->UnSubscribeSystemAbility(SAID, listener);
     EXPECT_EQ(res, ERR_OK);
+    EXPECT_EQ(saMgr->listenerIndex_.count(key), 0u);
+    EXPECT_EQ(saMgr->listenerMap_[SAID].size(), listenerNum - 1);
+    EXPECT_TRUE(saMgr->subscribeCountMap_.empty());
 }
 
 HWTEST_F(SystemAbilityMgrStubUnLoadTest, UnSubscribeSystemAbility005, TestSize.Level0)
@@ -247,12 +260,17 @@ HWTEST_F(SystemAbilityMgrStubUnLoadTest, UnSubscribeSystemAbility005, TestSize.L
     sptr<SystemAbilityManager> saMgr = SystemAbilityManager::GetInstance();
     EXPECT_TRUE(saMgr != nullptr);
     sptr<SaStatusChangeMock> listener(new SaStatusChangeMock());
-    saMgr->listenerMap_[SAID].push_back({listener, SAID});
+    auto& listeners = saMgr->listenerMap_[SAID];
+    listeners.push_back({listener, SAID});
+    IRemoteObject* key = listener->AsObject().GetRefPtr();
+    saMgr->listenerIndex_[key][SAID] = std::prev(listeners.end());
     saMgr->abilityStatusDeath_ = nullptr;
     int countNum = 2;
     saMgr->subscribeCountMap_[SAID] = countNum;
     int32_t res = saMgr->UnSubscribeSystemAbility(SAID, listener);
     EXPECT_EQ(res, ERR_OK);
+    EXPECT_EQ(saMgr->listenerIndex_.count(key), 0u);
+    EXPECT_EQ(saMgr->subscribeCountMap_[SAID], countNum - 1);
 }
 
 HWTEST_F(SystemAbilityMgrStubUnLoadTest, RemoveSystemProcess001, TestSize.Level1)
@@ -165,10 +165,16 @@ HWTEST_F(SystemAbilityMgrSubscribeTest, UnSubscribeSystemAbilityDied001, TestSiz
     InitSaMgr(saMgr);
     ASSERT_TRUE(saMgr != nullptr);
     sptr<SaStatusChangeMock> callback(new SaStatusChangeMock());
-    saMgr->listenerMap_[SAID].push_back({callback, SAID});
+    auto& listeners = saMgr->listenerMap_[SAID];
+    listeners.push_back({callback, SAID});
+    IRemoteObject* key = callback->AsObject().GetRefPtr();
+    saMgr->listenerIndex_[key][SAID] = std::prev(listeners.end());
     auto& count = saMgr->subscribeCountMap_[SAID];
     ++count;
     saMgr->UnSubscribeSystemAbility(callback->AsObject());
+    EXPECT_EQ(saMgr->listenerIndex_.count(key), 0u);
+    EXPECT_TRUE(saMgr->listenerMap_[SAID].empty());
+    EXPECT_EQ(saMgr->subscribeCountMap_.count(SAID), 0u);
 }
 
 /**
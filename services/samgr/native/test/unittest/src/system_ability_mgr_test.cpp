@@ -1408,9 +1408,10 @@ HWTEST_F(SystemAbilityMgrTest, ReportGetSAFre002, TestSize.Level3)
     sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
     InitSaMgr(saMgr);
     int32_t uid = 1;
-    int32_t count = saMgr->UpdateSaFreMap(uid, TEST_SYSTEM_ABILITY1);
-    ASSERT_EQ(saMgr->saFrequencyMap_.size(), 1);
+    saMgr->UpdateSaFreMap(uid, TEST_SYSTEM_ABILITY1);
+    ASSERT_EQ(saMgr->saFrequencyCounter_.Size(), 1);
     saMgr->ReportGetSAPeriodically();
+    ASSERT_EQ(saMgr->saFrequencyCounter_.Size(), 0);
     ASSERT_EQ(saMgr->saFrequencyMap_.size(), 0);
 }
 
@@ -1426,7 +1427,7 @@ HWTEST_F(SystemAbilityMgrTest, ReportGetSAFre003, TestSize.Level3)
     sptr<SystemAbilityManager> saMgr = new SystemAbilityManager;
     InitSaMgr(saMgr);
     int32_t uid = -1;
-    int32_t count = saMgr->UpdateSaFreMap(uid, TEST_SYSTEM_ABILITY1);
+    saMgr->UpdateSaFreMap(uid, TEST_SYSTEM_ABILITY1);
     saMgr->ReportGetSAPeriodically();
     ASSERT_EQ(saMgr->saFrequencyMap_.size(), 0);
 }
@@ -1445,7 +1446,7 @@ HWTEST_F(SystemAbilityMgrTest, ReportGetSAFre004, TestSize.Level3)
     int32_t uid = 1;
     uint64_t key = SamgrUtil::GenerateFreKey(uid, TEST_SYSTEM_ABILITY1);
     saMgr->saFrequencyMap_[key] = MAX_COUNT;
-    int32_t count = saMgr->UpdateSaFreMap(uid, TEST_SYSTEM_ABILITY1);
+    saMgr->UpdateSaFreMap(uid, TEST_SYSTEM_ABILITY1);
     EXPECT_EQ(saMgr->saFrequencyMap_[key], MAX_COUNT);
 }
 
@@ -17,10 +17,12 @@
 #define protected public
 #include "system_ability_manager.h"
 #include "system_ability_manager_util.h"
+#include "process_name_cache.h"
 #include "sam_mock_permission.h"
 #include "ability_death_recipient.h"
 #include "test_log.h"
 #include <fstream>
+#include <thread>
 
 using namespace std;
 using namespace testing;
@@ -613,6 +615,7 @@ HWTEST_F(SamgrUtilTest, RegisterSAListener001, TestSize.Level3)
     ASSERT_NE(saMgr, nullptr);
     InitSaMgr(saMgr);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
     SamgrUtil::RegisterSAListener();
     EXPECT_FALSE(SamgrUtil::CheckSupportSetPrior());
 }
@@ -630,7 +633,79 @@ HWTEST_F(SamgrUtilTest, RegisterSAListener002, TestSize.Level3)
     ASSERT_NE(saMgr, nullptr);
     InitSaMgr(saMgr);
     saMgr->listenerMap_.clear();
+    saMgr->listenerIndex_.clear();
     SamgrUtil::RegisterSAListener();
     EXPECT_TRUE(SamgrUtil::CheckSupportSetPrior());
 }
+
+/**
+ * @tc.name: ProcessNameCache001
+ * @tc.desc: repeated lookups of one pid read procfs once until the entry is removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(SamgrUtilTest, ProcessNameCache001, TestSize.Level3)
+{
+    int32_t nameLoads = 0;
+    int32_t startTimeLoads = 0;
+    ProcessNameCache cache([&nameLoads](int32_t pid) { nameLoads++; return "proc_" + std::to_string(pid); },
+        [&startTimeLoads](int32_t) { startTimeLoads++; return 1; });
+    EXPECT_EQ(cache.Get(100), "proc_100");
+    EXPECT_EQ(cache.Get(100), "proc_100");
+    EXPECT_EQ(cache.Get(100), "proc_100");
+    EXPECT_EQ(nameLoads, 1);
+    EXPECT_EQ(startTimeLoads, 1);
+    cache.Remove(100);
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(cache.Get(100), "proc_100");
+    EXPECT_EQ(nameLoads, 2);
+}
+
+/**
+ * @tc.name: ProcessNameCache002
+ * @tc.desc: a reused pid is detected by its start time once the entry is due for recheck
+ * @tc.type: FUNC
+ */
+HWTEST_F(SamgrUtilTest, ProcessNameCache002, TestSize.Level3)
+{
+    std::string procName = "old_proc";
+    uint64_t startTime = 1;
+    ProcessNameCache cache([&procName](int32_t) { return procName; },
+        [&startTime](int32_t) { return startTime; });
+    EXPECT_EQ(cache.Get(100), "old_proc");
+    procName = "new_proc";
+    startTime = 2;
+    std::this_thread::sleep_for(std::chrono::milliseconds(ProcessNameCache::RECHECK_INTERVAL_MS + 100));
+    EXPECT_EQ(cache.Get(100), "new_proc");
+}
+
+/**
+ * @tc.name: ProcessNameCache003
+ * @tc.desc: unknown pid is not cached and the cache never grows past its limit
+ * @tc.type: FUNC
+ */
+HWTEST_F(SamgrUtilTest, ProcessNameCache003, TestSize.Level3)
+{
+    ProcessNameCache cache([](int32_t pid) { return pid == 1 ? "" : "proc"; }, [](int32_t) { return 1; });
+    EXPECT_EQ(cache.Get(1), "");
+    EXPECT_EQ(cache.Size(), 0);
+    for (int32_t pid = 2; pid < static_cast<int32_t>(ProcessNameCache::MAX_CACHE_SIZE) + 10; ++pid) {
+        cache.Get(pid);
+    }
+    EXPECT_EQ(cache.Size(), ProcessNameCache::MAX_CACHE_SIZE);
+}
+
+/**
+ * @tc.name: GetCachedProcessName001
+ * @tc.desc: cached name matches cmdline and the start time of a live pid is known
+ * @tc.type: FUNC
+ */
+HWTEST_F(SamgrUtilTest, GetCachedProcessName001, TestSize.Level3)
+{
+    int32_t pid = getpid();
+    EXPECT_NE(SamgrUtil::GetProcessStartTime(pid), 0);
+    EXPECT_EQ(SamgrUtil::GetCachedProcessName(pid), SamgrUtil::GetProcessNameFromCmdline(pid));
+    SamgrUtil::RemoveCachedProcessName(pid);
+    EXPECT_EQ(SamgrUtil::GetProcessStartTime(70000), 0);
+    EXPECT_EQ(SamgrUtil::GetCachedProcessName(70000), "");
+}
 }
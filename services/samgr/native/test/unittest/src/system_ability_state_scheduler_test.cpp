@@ -2361,4 +2361,83 @@ HWTEST_F(SystemAbilityStateSchedulerTest, GetRunningSystemProcess004, TestSize.L
     EXPECT_EQ(result.processName, Str16ToStr8(testProcess));
     DTEST_LOG<<"GetRunningSystemProcess004 END"<<std::endl;
 }
+
+/**
+ * @tc.name: SealContextTable001
+ * @tc.desc: test lookups through the sealed context table, including ids outside the paged range
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityStateSchedulerTest, SealContextTable001, TestSize.Level3)
+{
+    DTEST_LOG<<"SealContextTable001 BEGIN"<<std::endl;
+    std::shared_ptr<SystemAbilityStateScheduler> systemAbilityStateScheduler =
+        std::make_shared<SystemAbilityStateScheduler>(std::weak_ptr<BaseSystemAbilityManager>{});
+    constexpr int32_t largeSaId = (1 << 20) + 1;
+    std::list<SaProfile> saProfiles;
+    for (int32_t saId : { SAID, TEST_SYSTEM_ABILITY1, largeSaId }) {
+        SaProfile saProfile;
+        saProfile.saId = saId;
+        saProfile.process = u"test_process";
+        saProfiles.emplace_back(saProfile);
+    }
+    systemAbilityStateScheduler->InitStateContext(saProfiles);
+    EXPECT_EQ(systemAbilityStateScheduler->contextTable_.load(), nullptr);
+    systemAbilityStateScheduler->InitSamgrProcessContext();
+    ASSERT_NE(systemAbilityStateScheduler->contextTable_.load(), nullptr);
+
+    std::shared_ptr<SystemAbilityContext> abilityContext;
+    for (int32_t saId : { SAID, TEST_SYSTEM_ABILITY1, largeSaId, 0 }) {
+        EXPECT_TRUE(systemAbilityStateScheduler->GetSystemAbilityContext(saId, abilityContext));
+        ASSERT_NE(abilityContext, nullptr);
+        EXPECT_EQ(abilityContext->systemAbilityId, saId);
+    }
+    EXPECT_FALSE(systemAbilityStateScheduler->GetSystemAbilityContext(SAID + 1, abilityContext));
+    EXPECT_FALSE(systemAbilityStateScheduler->GetSystemAbilityContext(SAID_INVALID, abilityContext));
+    EXPECT_FALSE(systemAbilityStateScheduler->GetSystemAbilityContext(largeSaId + 1, abilityContext));
+
+    std::shared_ptr<SystemProcessContext> processContext;
+    EXPECT_TRUE(systemAbilityStateScheduler->GetSystemProcessContext(u"test_process", processContext));
+    EXPECT_EQ(processContext->saList.size(), saProfiles.size());
+    EXPECT_FALSE(systemAbilityStateScheduler->GetSystemProcessContext(u"no_process", processContext));
+
+    systemAbilityStateScheduler->CleanResource();
+    EXPECT_EQ(systemAbilityStateScheduler->contextTable_.load(), nullptr);
+    EXPECT_FALSE(systemAbilityStateScheduler->GetSystemAbilityContext(SAID, abilityContext));
+    DTEST_LOG<<"SealContextTable001 END"<<std::endl;
+}
+
+/**
+ * @tc.name: ProcessNameTable001
+ * @tc.desc: test process names are interned at profile load and their utf-8 form is cached
+ * @tc.type: FUNC
+ */
+HWTEST_F(SystemAbilityStateSchedulerTest, ProcessNameTable001, TestSize.Level3)
+{
+    DTEST_LOG<<"ProcessNameTable001 BEGIN"<<std::endl;
+    std::shared_ptr<SystemAbilityStateScheduler> systemAbilityStateScheduler =
+        std::make_shared<SystemAbilityStateScheduler>(std::weak_ptr<BaseSystemAbilityManager>{});
+    std::list<SaProfile> saProfiles;
+    SaProfile saProfile;
+    saProfile.saId = SAID;
+    saProfile.process = u"test_intern_process";
+    saProfiles.emplace_back(saProfile);
+    systemAbilityStateScheduler->InitStateContext(saProfiles);
+
+    auto& processNames = ProcessNameTable::GetInstance();
+    ProcessNameId processNameId = processNames.Find(u"test_intern_process");
+    ASSERT_NE(processNameId, INVALID_PROCESS_NAME_ID);
+    EXPECT_EQ(processNames.Intern(u"test_intern_process"), processNameId);
+    std::shared_ptr<SystemProcessContext> processContext;
+    ASSERT_TRUE(systemAbilityStateScheduler->GetSystemProcessContext(u"test_intern_process", processContext));
+    EXPECT_EQ(processContext->processNameId, processNameId);
+    EXPECT_EQ(&processContext->GetProcessNameStr8(), &processNames.GetStr8(processNameId));
+    EXPECT_EQ(processContext->GetProcessNameStr8(), "test_intern_process");
+    EXPECT_EQ(processNames.GetStr16(processNameId), u"test_intern_process");
+
+    SystemProcessContext manualContext;
+    manualContext.processName = u"test_manual_process";
+    EXPECT_EQ(manualContext.GetProcessNameStr8(), "test_manual_process");
+    EXPECT_TRUE(processNames.GetStr8(INVALID_PROCESS_NAME_ID).empty());
+    DTEST_LOG<<"ProcessNameTable001 END"<<std::endl;
+}
 }
@@ -124,35 +124,37 @@ void FuzzListenerDumpProc()
     listeners.emplace_back(listener, pid1);
     listeners.emplace_back(listener, pid2);
     dumpListeners[SAID] = listeners;
+    std::vector<SAListenerDumpInfo> dumpInfos;
+    SystemAbilityManagerDumper::GetListenerDumpInfo(dumpListeners, dumpInfos);
     int32_t fd = -1;
     std::vector<std::string> args;
     args.push_back("test");
     args.push_back("-h");
-    SystemAbilityManagerDumper::ListenerDumpProc(dumpListeners, fd, args);
+    SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, args);
     args.clear();
 
     args.push_back("test");
     args.push_back("-l");
     args.push_back("-sa");
-    SystemAbilityManagerDumper::ListenerDumpProc(dumpListeners, fd, args);
+    SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, args);
     args.clear();
 
     args.push_back("test");
     args.push_back("-l");
     args.push_back("-p");
-    SystemAbilityManagerDumper::ListenerDumpProc(dumpListeners, fd, args);
+    SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, args);
     args.clear();
 
     args.push_back("test");
     args.push_back("-sa");
     args.push_back(ToString(SAID));
-    SystemAbilityManagerDumper::ListenerDumpProc(dumpListeners, fd, args);
+    SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, args);
     args.clear();
 
     args.push_back("test");
     args.push_back("-p");
     args.push_back(ToString(pid1));
-    SystemAbilityManagerDumper::ListenerDumpProc(dumpListeners, fd, args);
+    SystemAbilityManagerDumper::ListenerDumpProc(dumpInfos, fd, args);
     args.clear();
 }
 